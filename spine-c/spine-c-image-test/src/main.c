@@ -0,0 +1,202 @@
+#include <spine/spine.h>
+#include <spine/extension.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Writes each example skeleton into a spSkeletonDataImage, relocates it and checks that every animation poses the
+ * relocated skeleton data exactly like the data it was written from, and that disposing the image frees everything. */
+
+#define FRAMES 60
+
+static int failures = 0;
+static int allocations = 0;
+
+#define CHECK(condition) \
+	do { \
+		if (!(condition)) { \
+			printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+			failures++; \
+		} \
+	} while (0)
+
+static void *countingMalloc(size_t size) {
+	allocations++;
+	return malloc(size);
+}
+
+static void *countingRealloc(void *ptr, size_t size) {
+	if (!ptr) allocations++;
+	return realloc(ptr, size);
+}
+
+static void countingFree(void *ptr) {
+	if (ptr) allocations--;
+	free(ptr);
+}
+
+void _spAtlasPage_createTexture(spAtlasPage *self, const char *path) {
+	UNUSED(path);
+	self->rendererObject = 0;
+}
+
+void _spAtlasPage_disposeTexture(spAtlasPage *self) {
+	UNUSED(self);
+}
+
+char *_spUtil_readFile(const char *path, int *length) {
+	return _spReadFile(path, length);
+}
+
+static const char *attachmentName(spSlot *slot) {
+	return slot->attachment ? slot->attachment->name : "";
+}
+
+/* Applies every animation of both skeletons' data over several frames and compares bones, slots and draw order. */
+static void comparePoses(spSkeleton *expected, spSkeleton *actual) {
+	int i, ii, frame;
+	spSkeletonData *expectedData = expected->data, *actualData = actual->data;
+	CHECK(expectedData->animationsCount == actualData->animationsCount);
+	CHECK(expectedData->bonesCount == actualData->bonesCount && expectedData->slotsCount == actualData->slotsCount);
+	if (failures) return;
+
+	for (i = 0; i < expectedData->animationsCount; i++) {
+		spAnimation *expectedAnimation = expectedData->animations[i], *actualAnimation = actualData->animations[i];
+		CHECK(strcmp(expectedAnimation->name, actualAnimation->name) == 0);
+		CHECK(expectedAnimation->duration == actualAnimation->duration);
+		spSkeleton_setToSetupPose(expected);
+		spSkeleton_setToSetupPose(actual);
+		for (frame = 0; frame < FRAMES; frame++) {
+			float time = expectedAnimation->duration * frame / FRAMES;
+			spAnimation_apply(expectedAnimation, expected, 0, time, 0, 0, 0, 1, SP_MIX_BLEND_SETUP, SP_MIX_DIRECTION_IN);
+			spAnimation_apply(actualAnimation, actual, 0, time, 0, 0, 0, 1, SP_MIX_BLEND_SETUP, SP_MIX_DIRECTION_IN);
+			spSkeleton_updateWorldTransform(expected);
+			spSkeleton_updateWorldTransform(actual);
+			for (ii = 0; ii < expected->bonesCount; ii++) {
+				spBone *bone = expected->bones[ii], *actualBone = actual->bones[ii];
+				CHECK(bone->a == actualBone->a && bone->b == actualBone->b && bone->c == actualBone->c &&
+					  bone->d == actualBone->d);
+				CHECK(bone->worldX == actualBone->worldX && bone->worldY == actualBone->worldY);
+			}
+			for (ii = 0; ii < expected->slotsCount; ii++) {
+				spSlot *slot = expected->slots[ii], *actualSlot = actual->slots[ii];
+				CHECK(strcmp(attachmentName(slot), attachmentName(actualSlot)) == 0);
+				CHECK(slot->color.r == actualSlot->color.r && slot->color.a == actualSlot->color.a);
+				CHECK(slot->deformCount == actualSlot->deformCount);
+				if (slot->deformCount == actualSlot->deformCount)
+					CHECK(memcmp(slot->deform, actualSlot->deform, slot->deformCount * sizeof(float)) == 0);
+				CHECK(expected->drawOrder[ii]->data->index == actual->drawOrder[ii]->data->index);
+			}
+			if (failures) {
+				printf("Pose differs: %s at %f\n", expectedAnimation->name, time);
+				return;
+			}
+		}
+	}
+}
+
+/* Checks that the image is rejected and left unchanged. */
+static void checkRejected(char *image, int length) {
+	char *expected = MALLOC(char, length);
+	memcpy(expected, image, length);
+	CHECK(spSkeletonDataImage_create(image, length, 0, 0) == 0);
+	CHECK(memcmp(image, expected, length) == 0);
+	FREE(expected);
+}
+
+/* Images with offsets outside of the data are rejected before anything is relocated. The header starts with the 4 byte
+ * magic, followed by the ints version, layout, length, skeletonData, atlas, relocations and relocationsCount. */
+static void testMalformed(const char *data, int length) {
+	char *image = MALLOC(char, length);
+	int relocations = ((const int *) data)[6], field = ((const int *) (data + relocations))[0];
+	size_t outside = (size_t) length + 1;
+
+	/* More relocations than fit in the image. */
+	memcpy(image, data, length);
+	((int *) image)[7] = length;
+	checkRejected(image, length);
+
+	/* A relocated field outside of the image. */
+	memcpy(image, data, length);
+	((int *) (image + relocations))[0] = length;
+	checkRejected(image, length);
+
+	/* A relocated field pointing outside of the image. */
+	memcpy(image, data, length);
+	memcpy(image + field, &outside, sizeof(outside));
+	checkRejected(image, length);
+
+	FREE(image);
+}
+
+static void testRig(const char *name) {
+	char atlasPath[256], skeletonPath[256], dir[256];
+	spAtlas *atlas;
+	spSkeletonBinary *binary;
+	spSkeletonData *skeletonData;
+	spSkeletonDataImage *image;
+	spSkeleton *expected, *actual;
+	char *data;
+	int length = 0, animationsCount, skinsCount, i, before = allocations;
+
+	sprintf(dir, "testdata/%s", name);
+	sprintf(atlasPath, "testdata/%s/%s.atlas", name, name);
+	sprintf(skeletonPath, "testdata/%s/%s-pro.skel", name, name);
+	atlas = spAtlas_createFromFile(atlasPath, 0);
+	CHECK(atlas);
+	if (!atlas) return;
+	binary = spSkeletonBinary_create(atlas);
+	skeletonData = spSkeletonBinary_readSkeletonDataFile(binary, skeletonPath);
+	spSkeletonBinary_dispose(binary);
+	CHECK(skeletonData);
+	if (!skeletonData) {
+		spAtlas_dispose(atlas);
+		return;
+	}
+
+	animationsCount = skeletonData->animationsCount;
+	skinsCount = skeletonData->skinsCount;
+	data = spSkeletonDataImage_write(skeletonData, atlas, &length);
+	CHECK(data);
+	if (data) testMalformed(data, length);
+	image = data ? spSkeletonDataImage_create(data, length, dir, 0) : 0;
+	CHECK(image && image->atlas);
+	if (image) {
+		expected = spSkeleton_create(skeletonData);
+		actual = spSkeleton_create(image->skeletonData);
+		comparePoses(expected, actual);
+		/* Skins resolve to the relocated attachments. */
+		for (i = 1; i < skeletonData->skinsCount && !failures; i++) {
+			spSkeleton_setSkin(expected, skeletonData->skins[i]);
+			spSkeleton_setSkin(actual, image->skeletonData->skins[i]);
+			spSkeleton_setSlotsToSetupPose(expected);
+			spSkeleton_setSlotsToSetupPose(actual);
+			comparePoses(expected, actual);
+		}
+		spSkeleton_dispose(expected);
+		spSkeleton_dispose(actual);
+		spSkeletonDataImage_dispose(image);
+	}
+	FREE(data);
+	spSkeletonData_dispose(skeletonData);
+	spAtlas_dispose(atlas);
+
+	CHECK(allocations == before);
+	printf("Skeleton data image %s: %d bytes, %d animations, %d skins\n", name, length, animationsCount, skinsCount);
+}
+
+int main(void) {
+	const char *names[] = {"spineboy", "raptor", "goblins", "mix-and-match", "coin", "tank", "stretchyman"};
+	int i;
+	_spSetMalloc(countingMalloc);
+	_spSetRealloc(countingRealloc);
+	_spSetFree(countingFree);
+	for (i = 0; i < 7; i++)
+		testRig(names[i]);
+	if (failures) {
+		printf("%d checks failed\n", failures);
+		return 1;
+	}
+	printf("No leaks detected\n");
+	return 0;
+}
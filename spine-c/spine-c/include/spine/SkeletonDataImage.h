@@ -0,0 +1,68 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated September 24, 2021. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2021, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef SPINE_SKELETONDATAIMAGE_H_
+#define SPINE_SKELETONDATAIMAGE_H_
+
+#include <spine/dll.h>
+#include <spine/Atlas.h>
+#include <spine/SkeletonData.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* A skeleton data image stores a loaded skeleton data and the atlas it references in a single block of memory. Pointers
+ * are stored as offsets and fixed up in one pass when the image is loaded, so loading does no parsing and no allocation
+ * per object. An image can only be loaded by the same runtime build that wrote it. */
+typedef struct spSkeletonDataImage {
+	spSkeletonData *const skeletonData;
+	spAtlas *const atlas; /* May be 0 if the image was written without an atlas. */
+} spSkeletonDataImage;
+
+/* Writes the skeleton data and the atlas into a new image, which must be freed with FREE. Returns 0 if an attachment
+ * references a region that is not in the atlas. */
+SP_API char *spSkeletonDataImage_write(spSkeletonData *skeletonData, spAtlas *atlas, int *length);
+
+/* Relocates an image in place. The data must be writable, aligned as returned by malloc or mmap, and stay valid until the
+ * image is disposed. Image files referenced by atlas pages will be prefixed with dir, which may be 0. Returns 0 if the image
+ * was written by an incompatible runtime or any of its offsets is outside of length, in which case the data is unchanged.
+ * The skeleton data and atlas are read-only and must not be disposed, except by disposing the image. */
+SP_API spSkeletonDataImage *spSkeletonDataImage_create(char *data, int length, const char *dir, void *rendererObject);
+
+/* Image files referenced by atlas pages will be prefixed with the directory containing the image file. */
+SP_API spSkeletonDataImage *spSkeletonDataImage_createFromFile(const char *path, void *rendererObject);
+
+SP_API void spSkeletonDataImage_dispose(spSkeletonDataImage *self);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SPINE_SKELETONDATAIMAGE_H_ */
@@ -50,6 +50,7 @@
 #include <spine/Skeleton.h>
 #include <spine/SkeletonBounds.h>
 #include <spine/SkeletonData.h>
+#include <spine/SkeletonDataImage.h>
 #include <spine/SkeletonBinary.h>
 #include <spine/SkeletonJson.h>
 #include <spine/Skin.h>
@@ -0,0 +1,1019 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated September 24, 2021. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2021, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <spine/SkeletonDataImage.h>
+#include <spine/Animation.h>
+#include <spine/BoundingBoxAttachment.h>
+#include <spine/ClippingAttachment.h>
+#include <spine/MeshAttachment.h>
+#include <spine/PathAttachment.h>
+#include <spine/PointAttachment.h>
+#include <spine/RegionAttachment.h>
+#include <spine/Version.h>
+#include <spine/extension.h>
+#include <stddef.h>
+
+#define IMAGE_VERSION 1
+#define IMAGE_ALIGNMENT 8
+
+#define FIELD(OFFSET, TYPE, NAME) ((OFFSET) + (int) offsetof(TYPE, NAME))
+
+typedef struct {
+	char magic[4];
+	int version;
+	int layout;
+	int length;
+	int skeletonData;
+	int atlas;
+	int relocations, relocationsCount;
+	int attachments, attachmentsCount;
+	int timelines, timelinesCount;
+} _spImageHeader;
+
+typedef struct {
+	spSkeletonDataImage super;
+	char *data;
+	int ownsData;
+	spAttachment *templates[SP_ATTACHMENT_CLIPPING + 1];
+} _spSkeletonDataImage;
+
+typedef struct {
+	const void *object;
+	int offset;
+} _spImageEntry;
+
+typedef struct {
+	char *data;
+	int length, capacity;
+
+	_spImageEntry *entries;
+	int entriesCount, entriesCapacity;
+
+	spIntArray *relocations;
+	spIntArray *attachments;
+	spIntArray *timelines;
+	int /*boolean*/ error;
+} _spImageWriter;
+
+static const char MAGIC[4] = {'s', 'p', 'i', 'm'};
+
+/* Images store structs as they are laid out in memory, so they can only be loaded by a build with the same layout. */
+static int _spImage_layout() {
+	static const int one = 1;
+	unsigned int hash = SPINE_MAJOR_VERSION * 100 + SPINE_MINOR_VERSION;
+	int sizes[18], i;
+	sizes[0] = (int) sizeof(void *);
+	sizes[1] = (int) sizeof(size_t);
+	sizes[2] = *(const char *) &one;
+	sizes[3] = (int) sizeof(spSkeletonData);
+	sizes[4] = (int) sizeof(spBoneData);
+	sizes[5] = (int) sizeof(spSlotData);
+	sizes[6] = (int) sizeof(_spSkin);
+	sizes[7] = (int) sizeof(spEventData);
+	sizes[8] = (int) sizeof(spEvent);
+	sizes[9] = (int) sizeof(spIkConstraintData);
+	sizes[10] = (int) sizeof(spTransformConstraintData);
+	sizes[11] = (int) sizeof(spPathConstraintData);
+	sizes[12] = (int) sizeof(spRegionAttachment);
+	sizes[13] = (int) sizeof(spMeshAttachment);
+	sizes[14] = (int) sizeof(spPathAttachment);
+	sizes[15] = (int) sizeof(spDeformTimeline);
+	sizes[16] = (int) sizeof(spAtlasRegion);
+	sizes[17] = (int) sizeof(spAtlasPage);
+	for (i = 0; i < 18; i++)
+		hash = hash * 31 + (unsigned int) sizes[i];
+	return (int) hash;
+}
+
+static int _spTimeline_size(spTimelineType type) {
+	switch (type) {
+		case SP_TIMELINE_ATTACHMENT:
+			return sizeof(spAttachmentTimeline);
+		case SP_TIMELINE_ALPHA:
+			return sizeof(spAlphaTimeline);
+		case SP_TIMELINE_PATHCONSTRAINTPOSITION:
+			return sizeof(spPathConstraintPositionTimeline);
+		case SP_TIMELINE_PATHCONSTRAINTSPACING:
+			return sizeof(spPathConstraintSpacingTimeline);
+		case SP_TIMELINE_ROTATE:
+			return sizeof(spRotateTimeline);
+		case SP_TIMELINE_SCALEX:
+			return sizeof(spScaleXTimeline);
+		case SP_TIMELINE_SCALEY:
+			return sizeof(spScaleYTimeline);
+		case SP_TIMELINE_SHEARX:
+			return sizeof(spShearXTimeline);
+		case SP_TIMELINE_SHEARY:
+			return sizeof(spShearYTimeline);
+		case SP_TIMELINE_TRANSLATEX:
+			return sizeof(spTranslateXTimeline);
+		case SP_TIMELINE_TRANSLATEY:
+			return sizeof(spTranslateYTimeline);
+		case SP_TIMELINE_SCALE:
+			return sizeof(spScaleTimeline);
+		case SP_TIMELINE_SHEAR:
+			return sizeof(spShearTimeline);
+		case SP_TIMELINE_TRANSLATE:
+			return sizeof(spTranslateTimeline);
+		case SP_TIMELINE_DEFORM:
+			return sizeof(spDeformTimeline);
+		case SP_TIMELINE_SEQUENCE:
+			return sizeof(spSequenceTimeline);
+		case SP_TIMELINE_IKCONSTRAINT:
+			return sizeof(spIkConstraintTimeline);
+		case SP_TIMELINE_PATHCONSTRAINTMIX:
+			return sizeof(spPathConstraintMixTimeline);
+		case SP_TIMELINE_RGB2:
+			return sizeof(spRGB2Timeline);
+		case SP_TIMELINE_RGBA2:
+			return sizeof(spRGBA2Timeline);
+		case SP_TIMELINE_RGBA:
+			return sizeof(spRGBATimeline);
+		case SP_TIMELINE_RGB:
+			return sizeof(spRGBTimeline);
+		case SP_TIMELINE_TRANSFORMCONSTRAINT:
+			return sizeof(spTransformConstraintTimeline);
+		case SP_TIMELINE_DRAWORDER:
+			return sizeof(spDrawOrderTimeline);
+		case SP_TIMELINE_EVENT:
+			return sizeof(spEventTimeline);
+	}
+	return 0;
+}
+
+static int _spAttachment_size(spAttachmentType type) {
+	switch (type) {
+		case SP_ATTACHMENT_REGION:
+			return sizeof(spRegionAttachment);
+		case SP_ATTACHMENT_BOUNDING_BOX:
+			return sizeof(spBoundingBoxAttachment);
+		case SP_ATTACHMENT_MESH:
+		case SP_ATTACHMENT_LINKED_MESH:
+			return sizeof(spMeshAttachment);
+		case SP_ATTACHMENT_PATH:
+			return sizeof(spPathAttachment);
+		case SP_ATTACHMENT_POINT:
+			return sizeof(spPointAttachment);
+		case SP_ATTACHMENT_CLIPPING:
+			return sizeof(spClippingAttachment);
+	}
+	return 0;
+}
+
+/**/
+
+static unsigned int _spImageWriter_hash(const void *object) {
+	size_t value = (size_t) object;
+	return (unsigned int) (value >> 3 ^ value >> 17) * 2654435761u;
+}
+
+static int _spImageWriter_find(_spImageWriter *self, const void *object) {
+	int mask = self->entriesCapacity - 1, i;
+	if (!object || !self->entriesCapacity) return 0;
+	for (i = (int) (_spImageWriter_hash(object) & mask); self->entries[i].object; i = (i + 1) & mask)
+		if (self->entries[i].object == object) return self->entries[i].offset;
+	return 0;
+}
+
+static void _spImageWriter_put(_spImageWriter *self, const void *object, int offset) {
+	int mask, i;
+	if ((self->entriesCount + 1) * 2 > self->entriesCapacity) {
+		_spImageEntry *entries = self->entries;
+		int capacity = self->entriesCapacity;
+		self->entriesCapacity = capacity ? capacity << 1 : 256;
+		self->entries = CALLOC(_spImageEntry, self->entriesCapacity);
+		self->entriesCount = 0;
+		for (i = 0; i < capacity; i++)
+			if (entries[i].object) _spImageWriter_put(self, entries[i].object, entries[i].offset);
+		FREE(entries);
+	}
+	mask = self->entriesCapacity - 1;
+	for (i = (int) (_spImageWriter_hash(object) & mask); self->entries[i].object; i = (i + 1) & mask)
+		;
+	self->entries[i].object = object;
+	self->entries[i].offset = offset;
+	self->entriesCount++;
+}
+
+/* Copies size bytes of the object into the image, or zeros if the object is 0. Returns the offset of the copy. */
+static int _spImageWriter_write(_spImageWriter *self, const void *object, int size) {
+	int offset = (self->length + IMAGE_ALIGNMENT - 1) & ~(IMAGE_ALIGNMENT - 1);
+	if (offset + size > self->capacity) {
+		int capacity = self->capacity ? self->capacity : 4096;
+		while (offset + size > capacity) capacity <<= 1;
+		self->data = REALLOC(self->data, char, capacity);
+		self->capacity = capacity;
+	}
+	memset(self->data + self->length, 0, offset - self->length);
+	if (object) {
+		memcpy(self->data + offset, object, size);
+		_spImageWriter_put(self, object, offset);
+	} else
+		memset(self->data + offset, 0, size);
+	self->length = offset + size;
+	return offset;
+}
+
+/* Stores a pointer field as the offset of its target. Offset 0 is the header, so it is used for null pointers. */
+static void _spImageWriter_setPointer(_spImageWriter *self, int field, int target) {
+	size_t value = (size_t) target;
+	memcpy(self->data + field, &value, sizeof(value));
+	if (target) spIntArray_add(self->relocations, field);
+}
+
+static int _spImageWriter_getPointer(_spImageWriter *self, int field) {
+	size_t value;
+	memcpy(&value, self->data + field, sizeof(value));
+	return (int) value;
+}
+
+/* Returns the offset of an object that must already be in the image, such as an atlas region. */
+static int _spImageWriter_reference(_spImageWriter *self, const void *object) {
+	int offset;
+	if (!object) return 0;
+	offset = _spImageWriter_find(self, object);
+	if (!offset) self->error = -1;
+	return offset;
+}
+
+static int _spImageWriter_writeBuffer(_spImageWriter *self, const void *buffer, int size) {
+	int offset;
+	if (!buffer || size <= 0) return 0;
+	offset = _spImageWriter_find(self, buffer);
+	return offset ? offset : _spImageWriter_write(self, buffer, size);
+}
+
+static int _spImageWriter_writeString(_spImageWriter *self, const char *string) {
+	return string ? _spImageWriter_writeBuffer(self, string, (int) strlen(string) + 1) : 0;
+}
+
+/* Writes an array and its items. All arrays share the layout of spFloatArray. Pointer items must be set by the caller. */
+static int _spImageWriter_writeArray(_spImageWriter *self, const void *array, int size, const void *items, int itemSize) {
+	int offset;
+	if (!array) return 0;
+	offset = _spImageWriter_find(self, array);
+	if (offset) return offset;
+	offset = _spImageWriter_write(self, array, sizeof(spFloatArray));
+	((spFloatArray *) (self->data + offset))->capacity = size;
+	_spImageWriter_setPointer(self, FIELD(offset, spFloatArray, items),
+							  _spImageWriter_writeBuffer(self, items, size * itemSize));
+	return offset;
+}
+
+static int _spImageWriter_writeBoneData(_spImageWriter *self, spBoneData *data) {
+	int offset = _spImageWriter_find(self, data);
+	if (!data || offset) return offset;
+	offset = _spImageWriter_write(self, data, sizeof(spBoneData));
+	_spImageWriter_setPointer(self, FIELD(offset, spBoneData, name), _spImageWriter_writeString(self, data->name));
+	_spImageWriter_setPointer(self, FIELD(offset, spBoneData, parent), _spImageWriter_writeBoneData(self, data->parent));
+	return offset;
+}
+
+static int _spImageWriter_writeBones(_spImageWriter *self, spBoneData **bones, int bonesCount) {
+	int offset = _spImageWriter_writeBuffer(self, bones, bonesCount * (int) sizeof(void *)), i;
+	for (i = 0; i < bonesCount; i++)
+		_spImageWriter_setPointer(self, offset + i * (int) sizeof(void *), _spImageWriter_writeBoneData(self, bones[i]));
+	return offset;
+}
+
+static int _spImageWriter_writeSlotData(_spImageWriter *self, spSlotData *data) {
+	int offset = _spImageWriter_find(self, data);
+	if (!data || offset) return offset;
+	offset = _spImageWriter_write(self, data, sizeof(spSlotData));
+	_spImageWriter_setPointer(self, FIELD(offset, spSlotData, name), _spImageWriter_writeString(self, data->name));
+	_spImageWriter_setPointer(self, FIELD(offset, spSlotData, boneData),
+							  _spImageWriter_writeBoneData(self, (spBoneData *) data->boneData));
+	_spImageWriter_setPointer(self, FIELD(offset, spSlotData, attachmentName),
+							  _spImageWriter_writeString(self, data->attachmentName));
+	_spImageWriter_setPointer(self, FIELD(offset, spSlotData, darkColor),
+							  _spImageWriter_writeBuffer(self, data->darkColor, sizeof(spColor)));
+	return offset;
+}
+
+static int _spImageWriter_writeEventData(_spImageWriter *self, spEventData *data) {
+	int offset = _spImageWriter_find(self, data);
+	if (!data || offset) return offset;
+	offset = _spImageWriter_write(self, data, sizeof(spEventData));
+	_spImageWriter_setPointer(self, FIELD(offset, spEventData, name), _spImageWriter_writeString(self, data->name));
+	_spImageWriter_setPointer(self, FIELD(offset, spEventData, stringValue),
+							  _spImageWriter_writeString(self, data->stringValue));
+	_spImageWriter_setPointer(self, FIELD(offset, spEventData, audioPath),
+							  _spImageWriter_writeString(self, data->audioPath));
+	return offset;
+}
+
+static int _spImageWriter_writeIkConstraintData(_spImageWriter *self, spIkConstraintData *data) {
+	int offset = _spImageWriter_find(self, data);
+	if (!data || offset) return offset;
+	offset = _spImageWriter_write(self, data, sizeof(spIkConstraintData));
+	_spImageWriter_setPointer(self, FIELD(offset, spIkConstraintData, name),
+							  _spImageWriter_writeString(self, data->name));
+	_spImageWriter_setPointer(self, FIELD(offset, spIkConstraintData, bones),
+							  _spImageWriter_writeBones(self, data->bones, data->bonesCount));
+	_spImageWriter_setPointer(self, FIELD(offset, spIkConstraintData, target),
+							  _spImageWriter_writeBoneData(self, data->target));
+	return offset;
+}
+
+static int _spImageWriter_writeTransformConstraintData(_spImageWriter *self, spTransformConstraintData *data) {
+	int offset = _spImageWriter_find(self, data);
+	if (!data || offset) return offset;
+	offset = _spImageWriter_write(self, data, sizeof(spTransformConstraintData));
+	_spImageWriter_setPointer(self, FIELD(offset, spTransformConstraintData, name),
+							  _spImageWriter_writeString(self, data->name));
+	_spImageWriter_setPointer(self, FIELD(offset, spTransformConstraintData, bones),
+							  _spImageWriter_writeBones(self, data->bones, data->bonesCount));
+	_spImageWriter_setPointer(self, FIELD(offset, spTransformConstraintData, target),
+							  _spImageWriter_writeBoneData(self, data->target));
+	return offset;
+}
+
+static int _spImageWriter_writePathConstraintData(_spImageWriter *self, spPathConstraintData *data) {
+	int offset = _spImageWriter_find(self, data);
+	if (!data || offset) return offset;
+	offset = _spImageWriter_write(self, data, sizeof(spPathConstraintData));
+	_spImageWriter_setPointer(self, FIELD(offset, spPathConstraintData, name),
+							  _spImageWriter_writeString(self, data->name));
+	_spImageWriter_setPointer(self, FIELD(offset, spPathConstraintData, bones),
+							  _spImageWriter_writeBones(self, data->bones, data->bonesCount));
+	_spImageWriter_setPointer(self, FIELD(offset, spPathConstraintData, target),
+							  _spImageWriter_writeSlotData(self, data->target));
+	return offset;
+}
+
+static int _spImageWriter_writeSequence(_spImageWriter *self, spSequence *sequence) {
+	int offset = _spImageWriter_find(self, sequence), regions, items, i;
+	if (!sequence || offset) return offset;
+	offset = _spImageWriter_write(self, sequence, sizeof(spSequence));
+	regions = _spImageWriter_writeArray(self, sequence->regions, sequence->regions->size, sequence->regions->items,
+										sizeof(spTextureRegion *));
+	items = _spImageWriter_getPointer(self, FIELD(regions, spFloatArray, items));
+	for (i = 0; i < sequence->regions->size; i++)
+		_spImageWriter_setPointer(self, items + i * (int) sizeof(void *),
+								  _spImageWriter_reference(self, sequence->regions->items[i]));
+	_spImageWriter_setPointer(self, FIELD(offset, spSequence, regions), regions);
+	return offset;
+}
+
+static int _spImageWriter_writeAttachment(_spImageWriter *self, spAttachment *attachment) {
+	int offset = _spImageWriter_find(self, attachment);
+	if (!attachment || offset) return offset;
+	offset = _spImageWriter_write(self, attachment, _spAttachment_size(attachment->type));
+	spIntArray_add(self->attachments, offset);
+	_spImageWriter_setPointer(self, FIELD(offset, spAttachment, name),
+							  _spImageWriter_writeString(self, attachment->name));
+	_spImageWriter_setPointer(self, FIELD(offset, spAttachment, vtable), 0);
+	_spImageWriter_setPointer(self, FIELD(offset, spAttachment, attachmentLoader), 0);
+
+	switch (attachment->type) {
+		case SP_ATTACHMENT_REGION: {
+			spRegionAttachment *region = SUB_CAST(spRegionAttachment, attachment);
+			_spImageWriter_setPointer(self, FIELD(offset, spRegionAttachment, path),
+									  _spImageWriter_writeString(self, region->path));
+			_spImageWriter_setPointer(self, FIELD(offset, spRegionAttachment, rendererObject),
+									  _spImageWriter_reference(self, region->rendererObject));
+			_spImageWriter_setPointer(self, FIELD(offset, spRegionAttachment, region),
+									  _spImageWriter_reference(self, region->region));
+			_spImageWriter_setPointer(self, FIELD(offset, spRegionAttachment, sequence),
+									  _spImageWriter_writeSequence(self, region->sequence));
+			break;
+		}
+		case SP_ATTACHMENT_POINT:
+			break;
+		default: {
+			spVertexAttachment *vertices = SUB_CAST(spVertexAttachment, attachment);
+			_spImageWriter_setPointer(self, FIELD(offset, spVertexAttachment, bones),
+									  _spImageWriter_writeBuffer(self, vertices->bones,
+																 vertices->bonesCount * (int) sizeof(int)));
+			_spImageWriter_setPointer(self, FIELD(offset, spVertexAttachment, vertices),
+									  _spImageWriter_writeBuffer(self, vertices->vertices,
+																 vertices->verticesCount * (int) sizeof(float)));
+			_spImageWriter_setPointer(self, FIELD(offset, spVertexAttachment, timelineAttachment),
+									  _spImageWriter_writeAttachment(self, vertices->timelineAttachment));
+			if (attachment->type == SP_ATTACHMENT_MESH || attachment->type == SP_ATTACHMENT_LINKED_MESH) {
+				spMeshAttachment *mesh = SUB_CAST(spMeshAttachment, attachment);
+				int uvsSize = mesh->super.worldVerticesLength * (int) sizeof(float);
+				_spImageWriter_setPointer(self, FIELD(offset, spMeshAttachment, rendererObject),
+										  _spImageWriter_reference(self, mesh->rendererObject));
+				_spImageWriter_setPointer(self, FIELD(offset, spMeshAttachment, region),
+										  _spImageWriter_reference(self, mesh->region));
+				_spImageWriter_setPointer(self, FIELD(offset, spMeshAttachment, sequence),
+										  _spImageWriter_writeSequence(self, mesh->sequence));
+				_spImageWriter_setPointer(self, FIELD(offset, spMeshAttachment, path),
+										  _spImageWriter_writeString(self, mesh->path));
+				_spImageWriter_setPointer(self, FIELD(offset, spMeshAttachment, regionUVs),
+										  _spImageWriter_writeBuffer(self, mesh->regionUVs, uvsSize));
+				_spImageWriter_setPointer(self, FIELD(offset, spMeshAttachment, uvs),
+										  _spImageWriter_writeBuffer(self, mesh->uvs, uvsSize));
+				_spImageWriter_setPointer(self, FIELD(offset, spMeshAttachment, triangles),
+										  _spImageWriter_writeBuffer(self, mesh->triangles,
+																	 mesh->trianglesCount * (int) sizeof(unsigned short)));
+				_spImageWriter_setPointer(self, FIELD(offset, spMeshAttachment, parentMesh),
+										  _spImageWriter_writeAttachment(self, (spAttachment *) mesh->parentMesh));
+				/* Edges are nonessential and their element size depends on the loader, so they are not stored. */
+				_spImageWriter_setPointer(self, FIELD(offset, spMeshAttachment, edges), 0);
+				((spMeshAttachment *) (self->data + offset))->edgesCount = 0;
+			} else if (attachment->type == SP_ATTACHMENT_PATH) {
+				spPathAttachment *path = SUB_CAST(spPathAttachment, attachment);
+				_spImageWriter_setPointer(self, FIELD(offset, spPathAttachment, lengths),
+										  _spImageWriter_writeBuffer(self, path->lengths,
+																	 path->lengthsLength * (int) sizeof(float)));
+			} else if (attachment->type == SP_ATTACHMENT_CLIPPING) {
+				spClippingAttachment *clipping = SUB_CAST(spClippingAttachment, attachment);
+				_spImageWriter_setPointer(self, FIELD(offset, spClippingAttachment, endSlot),
+										  _spImageWriter_writeSlotData(self, clipping->endSlot));
+			}
+		}
+	}
+	return offset;
+}
+
+static int _spImageWriter_writeSkin(_spImageWriter *self, spSkin *skin) {
+	_spSkin *internal = SUB_CAST(_spSkin, skin);
+	int offset = _spImageWriter_find(self, skin), array, items, previous, i;
+	_Entry *entry;
+	_SkinHashTableEntry *hashEntry;
+	if (!skin || offset) return offset;
+	offset = _spImageWriter_write(self, skin, sizeof(_spSkin));
+	_spImageWriter_setPointer(self, FIELD(offset, spSkin, name), _spImageWriter_writeString(self, skin->name));
+
+	array = _spImageWriter_writeArray(self, skin->bones, skin->bones->size, skin->bones->items, sizeof(void *));
+	items = _spImageWriter_getPointer(self, FIELD(array, spFloatArray, items));
+	for (i = 0; i < skin->bones->size; i++)
+		_spImageWriter_setPointer(self, items + i * (int) sizeof(void *),
+								  _spImageWriter_writeBoneData(self, skin->bones->items[i]));
+	_spImageWriter_setPointer(self, FIELD(offset, spSkin, bones), array);
+
+	array = _spImageWriter_writeArray(self, skin->ikConstraints, skin->ikConstraints->size, skin->ikConstraints->items,
+									  sizeof(void *));
+	items = _spImageWriter_getPointer(self, FIELD(array, spFloatArray, items));
+	for (i = 0; i < skin->ikConstraints->size; i++)
+		_spImageWriter_setPointer(self, items + i * (int) sizeof(void *),
+								  _spImageWriter_writeIkConstraintData(self, skin->ikConstraints->items[i]));
+	_spImageWriter_setPointer(self, FIELD(offset, spSkin, ikConstraints), array);
+
+	array = _spImageWriter_writeArray(self, skin->transformConstraints, skin->transformConstraints->size,
+									  skin->transformConstraints->items, sizeof(void *));
+	items = _spImageWriter_getPointer(self, FIELD(array, spFloatArray, items));
+	for (i = 0; i < skin->transformConstraints->size; i++)
+		_spImageWriter_setPointer(self, items + i * (int) sizeof(void *),
+								  _spImageWriter_writeTransformConstraintData(self,
+																			  skin->transformConstraints->items[i]));
+	_spImageWriter_setPointer(self, FIELD(offset, spSkin, transformConstraints), array);
+
+	array = _spImageWriter_writeArray(self, skin->pathConstraints, skin->pathConstraints->size,
+									  skin->pathConstraints->items, sizeof(void *));
+	items = _spImageWriter_getPointer(self, FIELD(array, spFloatArray, items));
+	for (i = 0; i < skin->pathConstraints->size; i++)
+		_spImageWriter_setPointer(self, items + i * (int) sizeof(void *),
+								  _spImageWriter_writePathConstraintData(self, skin->pathConstraints->items[i]));
+	_spImageWriter_setPointer(self, FIELD(offset, spSkin, pathConstraints), array);
+
+	previous = FIELD(offset, _spSkin, entries);
+	for (entry = internal->entries; entry; entry = entry->next) {
+		int entryOffset = _spImageWriter_write(self, entry, sizeof(_Entry));
+		_spImageWriter_setPointer(self, FIELD(entryOffset, _Entry, name), _spImageWriter_writeString(self, entry->name));
+		_spImageWriter_setPointer(self, FIELD(entryOffset, _Entry, attachment),
+								  _spImageWriter_writeAttachment(self, entry->attachment));
+		_spImageWriter_setPointer(self, previous, entryOffset);
+		previous = FIELD(entryOffset, _Entry, next);
+	}
+	_spImageWriter_setPointer(self, previous, 0);
+
+	for (i = 0; i < SKIN_ENTRIES_HASH_TABLE_SIZE; i++) {
+		previous = FIELD(offset, _spSkin, entriesHashTable) + i * (int) sizeof(void *);
+		for (hashEntry = internal->entriesHashTable[i]; hashEntry; hashEntry = hashEntry->next) {
+			int entryOffset = _spImageWriter_write(self, hashEntry, sizeof(_SkinHashTableEntry));
+			_spImageWriter_setPointer(self, FIELD(entryOffset, _SkinHashTableEntry, entry),
+									  _spImageWriter_reference(self, hashEntry->entry));
+			_spImageWriter_setPointer(self, previous, entryOffset);
+			previous = FIELD(entryOffset, _SkinHashTableEntry, next);
+		}
+		_spImageWriter_setPointer(self, previous, 0);
+	}
+	return offset;
+}
+
+static int _spImageWriter_writeFloatArray(_spImageWriter *self, spFloatArray *array) {
+	return array ? _spImageWriter_writeArray(self, array, array->size, array->items, sizeof(float)) : 0;
+}
+
+static int _spImageWriter_writeTimeline(_spImageWriter *self, spTimeline *timeline) {
+	int offset = _spImageWriter_find(self, timeline), items, i;
+	if (!timeline || offset) return offset;
+	offset = _spImageWriter_write(self, timeline, _spTimeline_size(timeline->type));
+	memset(self->data + offset, 0, sizeof(_spTimelineVtable));
+	spIntArray_add(self->timelines, offset);
+	_spImageWriter_setPointer(self, FIELD(offset, spTimeline, frames),
+							  _spImageWriter_writeFloatArray(self, timeline->frames));
+
+	switch (timeline->type) {
+		case SP_TIMELINE_ATTACHMENT: {
+			spAttachmentTimeline *attachmentTimeline = SUB_CAST(spAttachmentTimeline, timeline);
+			items = _spImageWriter_writeBuffer(self, attachmentTimeline->attachmentNames,
+											   timeline->frameCount * (int) sizeof(void *));
+			for (i = 0; i < timeline->frameCount; i++)
+				_spImageWriter_setPointer(self, items + i * (int) sizeof(void *),
+										  _spImageWriter_writeString(self, attachmentTimeline->attachmentNames[i]));
+			_spImageWriter_setPointer(self, FIELD(offset, spAttachmentTimeline, attachmentNames), items);
+			break;
+		}
+		case SP_TIMELINE_DEFORM: {
+			spDeformTimeline *deformTimeline = SUB_CAST(spDeformTimeline, timeline);
+			items = _spImageWriter_writeBuffer(self, deformTimeline->frameVertices,
+											   timeline->frameCount * (int) sizeof(void *));
+			for (i = 0; i < timeline->frameCount; i++)
+				_spImageWriter_setPointer(self, items + i * (int) sizeof(void *),
+										  _spImageWriter_writeBuffer(self, deformTimeline->frameVertices[i],
+																	 deformTimeline->frameVerticesCount *
+																			 (int) sizeof(float)));
+			_spImageWriter_setPointer(self, FIELD(offset, spDeformTimeline, frameVertices), items);
+			_spImageWriter_setPointer(self, FIELD(offset, spDeformTimeline, attachment),
+									  _spImageWriter_writeAttachment(self, deformTimeline->attachment));
+			_spImageWriter_setPointer(self, FIELD(offset, spCurveTimeline, curves),
+									  _spImageWriter_writeFloatArray(self, deformTimeline->super.curves));
+			break;
+		}
+		case SP_TIMELINE_SEQUENCE: {
+			spSequenceTimeline *sequenceTimeline = SUB_CAST(spSequenceTimeline, timeline);
+			_spImageWriter_setPointer(self, FIELD(offset, spSequenceTimeline, attachment),
+									  _spImageWriter_writeAttachment(self, sequenceTimeline->attachment));
+			break;
+		}
+		case SP_TIMELINE_EVENT: {
+			spEventTimeline *eventTimeline = SUB_CAST(spEventTimeline, timeline);
+			items = _spImageWriter_writeBuffer(self, eventTimeline->events, timeline->frameCount * (int) sizeof(void *));
+			for (i = 0; i < timeline->frameCount; i++) {
+				spEvent *event = eventTimeline->events[i];
+				int eventOffset = _spImageWriter_write(self, event, sizeof(spEvent));
+				_spImageWriter_setPointer(self, FIELD(eventOffset, spEvent, data),
+										  _spImageWriter_writeEventData(self, event->data));
+				_spImageWriter_setPointer(self, FIELD(eventOffset, spEvent, stringValue),
+										  _spImageWriter_writeString(self, event->stringValue));
+				_spImageWriter_setPointer(self, items + i * (int) sizeof(void *), eventOffset);
+			}
+			_spImageWriter_setPointer(self, FIELD(offset, spEventTimeline, events), items);
+			break;
+		}
+		case SP_TIMELINE_DRAWORDER: {
+			spDrawOrderTimeline *drawOrderTimeline = SUB_CAST(spDrawOrderTimeline, timeline);
+			items = _spImageWriter_writeBuffer(self, drawOrderTimeline->drawOrders,
+											   timeline->frameCount * (int) sizeof(void *));
+			for (i = 0; i < timeline->frameCount; i++)
+				_spImageWriter_setPointer(self, items + i * (int) sizeof(void *),
+										  _spImageWriter_writeBuffer(self, drawOrderTimeline->drawOrders[i],
+																	 drawOrderTimeline->slotsCount * (int) sizeof(int)));
+			_spImageWriter_setPointer(self, FIELD(offset, spDrawOrderTimeline, drawOrders), items);
+			break;
+		}
+		default:
+			_spImageWriter_setPointer(self, FIELD(offset, spCurveTimeline, curves),
+									  _spImageWriter_writeFloatArray(self, SUB_CAST(spCurveTimeline, timeline)->curves));
+	}
+	return offset;
+}
+
+static int _spImageWriter_writeAnimation(_spImageWriter *self, spAnimation *animation) {
+	int offset = _spImageWriter_find(self, animation), timelines, items, i;
+	if (!animation || offset) return offset;
+	offset = _spImageWriter_write(self, animation, sizeof(spAnimation));
+	_spImageWriter_setPointer(self, FIELD(offset, spAnimation, name), _spImageWriter_writeString(self, animation->name));
+	timelines = _spImageWriter_writeArray(self, animation->timelines, animation->timelines->size,
+										  animation->timelines->items, sizeof(void *));
+	items = _spImageWriter_getPointer(self, FIELD(timelines, spFloatArray, items));
+	for (i = 0; i < animation->timelines->size; i++)
+		_spImageWriter_setPointer(self, items + i * (int) sizeof(void *),
+								  _spImageWriter_writeTimeline(self, animation->timelines->items[i]));
+	_spImageWriter_setPointer(self, FIELD(offset, spAnimation, timelines), timelines);
+	_spImageWriter_setPointer(self, FIELD(offset, spAnimation, timelineIds),
+							  _spImageWriter_writeArray(self, animation->timelineIds, animation->timelineIds->size,
+														animation->timelineIds->items, sizeof(spPropertyId)));
+	return offset;
+}
+
+static int _spImageWriter_writeAtlas(_spImageWriter *self, spAtlas *atlas) {
+	int offset = _spImageWriter_write(self, atlas, sizeof(spAtlas)), previous;
+	spAtlasPage *page;
+	spAtlasRegion *region;
+	_spImageWriter_setPointer(self, FIELD(offset, spAtlas, rendererObject), 0);
+
+	previous = FIELD(offset, spAtlas, pages);
+	for (page = atlas->pages; page; page = page->next) {
+		int pageOffset = _spImageWriter_write(self, page, sizeof(spAtlasPage));
+		_spImageWriter_setPointer(self, FIELD(pageOffset, spAtlasPage, atlas), offset);
+		_spImageWriter_setPointer(self, FIELD(pageOffset, spAtlasPage, name), _spImageWriter_writeString(self, page->name));
+		_spImageWriter_setPointer(self, FIELD(pageOffset, spAtlasPage, rendererObject), 0);
+		_spImageWriter_setPointer(self, previous, pageOffset);
+		previous = FIELD(pageOffset, spAtlasPage, next);
+	}
+	_spImageWriter_setPointer(self, previous, 0);
+
+	/* Regions are written before the skeleton data, so attachments can reference them. */
+	previous = FIELD(offset, spAtlas, regions);
+	for (region = atlas->regions; region; region = region->next) {
+		int regionOffset = _spImageWriter_write(self, region, sizeof(spAtlasRegion));
+		_spImageWriter_setPointer(self, previous, regionOffset);
+		previous = FIELD(regionOffset, spAtlasRegion, next);
+	}
+	_spImageWriter_setPointer(self, previous, 0);
+
+	for (region = atlas->regions; region; region = region->next) {
+		int regionOffset = _spImageWriter_find(self, region), keyValues, items, i;
+		_spImageWriter_setPointer(self, FIELD(regionOffset, spTextureRegion, rendererObject),
+								  _spImageWriter_reference(self, region->super.rendererObject));
+		_spImageWriter_setPointer(self, FIELD(regionOffset, spAtlasRegion, name),
+								  _spImageWriter_writeString(self, region->name));
+		_spImageWriter_setPointer(self, FIELD(regionOffset, spAtlasRegion, splits),
+								  _spImageWriter_writeBuffer(self, region->splits, 4 * sizeof(int)));
+		_spImageWriter_setPointer(self, FIELD(regionOffset, spAtlasRegion, pads),
+								  _spImageWriter_writeBuffer(self, region->pads, 4 * sizeof(int)));
+		_spImageWriter_setPointer(self, FIELD(regionOffset, spAtlasRegion, page),
+								  _spImageWriter_reference(self, region->page));
+		if (!region->keyValues) continue;
+		keyValues = _spImageWriter_writeArray(self, region->keyValues, region->keyValues->size,
+											  region->keyValues->items, sizeof(spKeyValue));
+		items = _spImageWriter_getPointer(self, FIELD(keyValues, spFloatArray, items));
+		for (i = 0; i < region->keyValues->size; i++)
+			_spImageWriter_setPointer(self, FIELD(items + i * (int) sizeof(spKeyValue), spKeyValue, name),
+									  _spImageWriter_writeString(self, region->keyValues->items[i].name));
+		_spImageWriter_setPointer(self, FIELD(regionOffset, spAtlasRegion, keyValues), keyValues);
+	}
+	return offset;
+}
+
+static int _spImageWriter_writeSkeletonData(_spImageWriter *self, spSkeletonData *data) {
+	int offset = _spImageWriter_write(self, data, sizeof(spSkeletonData)), items, i;
+	_spImageWriter_setPointer(self, FIELD(offset, spSkeletonData, version),
+							  _spImageWriter_writeString(self, data->version));
+	_spImageWriter_setPointer(self, FIELD(offset, spSkeletonData, hash), _spImageWriter_writeString(self, data->hash));
+	_spImageWriter_setPointer(self, FIELD(offset, spSkeletonData, imagesPath),
+							  _spImageWriter_writeString(self, data->imagesPath));
+	_spImageWriter_setPointer(self, FIELD(offset, spSkeletonData, audioPath),
+							  _spImageWriter_writeString(self, data->audioPath));
+
+	items = _spImageWriter_writeBuffer(self, data->strings, data->stringsCount * (int) sizeof(void *));
+	for (i = 0; i < data->stringsCount; i++)
+		_spImageWriter_setPointer(self, items + i * (int) sizeof(void *),
+								  _spImageWriter_writeString(self, data->strings[i]));
+	_spImageWriter_setPointer(self, FIELD(offset, spSkeletonData, strings), items);
+
+	_spImageWriter_setPointer(self, FIELD(offset, spSkeletonData, bones),
+							  _spImageWriter_writeBones(self, data->bones, data->bonesCount));
+
+	items = _spImageWriter_writeBuffer(self, data->slots, data->slotsCount * (int) sizeof(void *));
+	for (i = 0; i < data->slotsCount; i++)
+		_spImageWriter_setPointer(self, items + i * (int) sizeof(void *),
+								  _spImageWriter_writeSlotData(self, data->slots[i]));
+	_spImageWriter_setPointer(self, FIELD(offset, spSkeletonData, slots), items);
+
+	items = _spImageWriter_writeBuffer(self, data->events, data->eventsCount * (int) sizeof(void *));
+	for (i = 0; i < data->eventsCount; i++)
+		_spImageWriter_setPointer(self, items + i * (int) sizeof(void *),
+								  _spImageWriter_writeEventData(self, data->events[i]));
+	_spImageWriter_setPointer(self, FIELD(offset, spSkeletonData, events), items);
+
+	items = _spImageWriter_writeBuffer(self, data->ikConstraints, data->ikConstraintsCount * (int) sizeof(void *));
+	for (i = 0; i < data->ikConstraintsCount; i++)
+		_spImageWriter_setPointer(self, items + i * (int) sizeof(void *),
+								  _spImageWriter_writeIkConstraintData(self, data->ikConstraints[i]));
+	_spImageWriter_setPointer(self, FIELD(offset, spSkeletonData, ikConstraints), items);
+
+	items = _spImageWriter_writeBuffer(self, data->transformConstraints,
+									   data->transformConstraintsCount * (int) sizeof(void *));
+	for (i = 0; i < data->transformConstraintsCount; i++)
+		_spImageWriter_setPointer(self, items + i * (int) sizeof(void *),
+								  _spImageWriter_writeTransformConstraintData(self, data->transformConstraints[i]));
+	_spImageWriter_setPointer(self, FIELD(offset, spSkeletonData, transformConstraints), items);
+
+	items = _spImageWriter_writeBuffer(self, data->pathConstraints, data->pathConstraintsCount * (int) sizeof(void *));
+	for (i = 0; i < data->pathConstraintsCount; i++)
+		_spImageWriter_setPointer(self, items + i * (int) sizeof(void *),
+								  _spImageWriter_writePathConstraintData(self, data->pathConstraints[i]));
+	_spImageWriter_setPointer(self, FIELD(offset, spSkeletonData, pathConstraints), items);
+
+	items = _spImageWriter_writeBuffer(self, data->skins, data->skinsCount * (int) sizeof(void *));
+	for (i = 0; i < data->skinsCount; i++)
+		_spImageWriter_setPointer(self, items + i * (int) sizeof(void *), _spImageWriter_writeSkin(self, data->skins[i]));
+	_spImageWriter_setPointer(self, FIELD(offset, spSkeletonData, skins), items);
+	_spImageWriter_setPointer(self, FIELD(offset, spSkeletonData, defaultSkin),
+							  _spImageWriter_writeSkin(self, data->defaultSkin));
+
+	items = _spImageWriter_writeBuffer(self, data->animations, data->animationsCount * (int) sizeof(void *));
+	for (i = 0; i < data->animationsCount; i++)
+		_spImageWriter_setPointer(self, items + i * (int) sizeof(void *),
+								  _spImageWriter_writeAnimation(self, data->animations[i]));
+	_spImageWriter_setPointer(self, FIELD(offset, spSkeletonData, animations), items);
+	return offset;
+}
+
+char *spSkeletonDataImage_write(spSkeletonData *skeletonData, spAtlas *atlas, int *length) {
+	_spImageWriter writer;
+	_spImageHeader *header;
+	int atlasOffset = 0, skeletonDataOffset, relocationsOffset, attachmentsOffset, timelinesOffset;
+
+	memset(&writer, 0, sizeof(writer));
+	writer.relocations = spIntArray_create(1024);
+	writer.attachments = spIntArray_create(64);
+	writer.timelines = spIntArray_create(256);
+
+	_spImageWriter_write(&writer, 0, sizeof(_spImageHeader));
+	if (atlas) atlasOffset = _spImageWriter_writeAtlas(&writer, atlas);
+	skeletonDataOffset = _spImageWriter_writeSkeletonData(&writer, skeletonData);
+
+	relocationsOffset = _spImageWriter_write(&writer, writer.relocations->items,
+											 writer.relocations->size * (int) sizeof(int));
+	attachmentsOffset = _spImageWriter_write(&writer, writer.attachments->items,
+											 writer.attachments->size * (int) sizeof(int));
+	timelinesOffset = _spImageWriter_write(&writer, writer.timelines->items, writer.timelines->size * (int) sizeof(int));
+
+	header = (_spImageHeader *) writer.data;
+	memcpy(header->magic, MAGIC, sizeof(MAGIC));
+	header->version = IMAGE_VERSION;
+	header->layout = _spImage_layout();
+	header->length = writer.length;
+	header->skeletonData = skeletonDataOffset;
+	header->atlas = atlasOffset;
+	header->relocations = relocationsOffset;
+	header->relocationsCount = writer.relocations->size;
+	header->attachments = attachmentsOffset;
+	header->attachmentsCount = writer.attachments->size;
+	header->timelines = timelinesOffset;
+	header->timelinesCount = writer.timelines->size;
+
+	spIntArray_dispose(writer.relocations);
+	spIntArray_dispose(writer.attachments);
+	spIntArray_dispose(writer.timelines);
+	FREE(writer.entries);
+	if (writer.error) {
+		FREE(writer.data);
+		return 0;
+	}
+	*length = writer.length;
+	return writer.data;
+}
+
+/**/
+
+static spAttachment *_spSkeletonDataImage_getTemplate(_spSkeletonDataImage *self, spAttachmentType type) {
+	if (!self->templates[type]) {
+		switch (type) {
+			case SP_ATTACHMENT_REGION:
+				self->templates[type] = SUPER(spRegionAttachment_create(""));
+				break;
+			case SP_ATTACHMENT_BOUNDING_BOX:
+				self->templates[type] = SUPER(SUPER(spBoundingBoxAttachment_create("")));
+				break;
+			case SP_ATTACHMENT_MESH:
+			case SP_ATTACHMENT_LINKED_MESH:
+				self->templates[type] = SUPER(SUPER(spMeshAttachment_create("")));
+				break;
+			case SP_ATTACHMENT_PATH:
+				self->templates[type] = SUPER(SUPER(spPathAttachment_create("")));
+				break;
+			case SP_ATTACHMENT_POINT:
+				self->templates[type] = SUPER(spPointAttachment_create(""));
+				break;
+			case SP_ATTACHMENT_CLIPPING:
+				self->templates[type] = SUPER(SUPER(spClippingAttachment_create("")));
+		}
+	}
+	return self->templates[type];
+}
+
+static spTimeline *_spTimeline_createTemplate(spTimelineType type, spAttachment *attachment) {
+	switch (type) {
+		case SP_TIMELINE_ATTACHMENT:
+			return SUPER(spAttachmentTimeline_create(1, 0));
+		case SP_TIMELINE_ALPHA:
+			return SUPER(SUPER(spAlphaTimeline_create(1, 0, 0)));
+		case SP_TIMELINE_PATHCONSTRAINTPOSITION:
+			return SUPER(SUPER(spPathConstraintPositionTimeline_create(1, 0, 0)));
+		case SP_TIMELINE_PATHCONSTRAINTSPACING:
+			return SUPER(SUPER(spPathConstraintSpacingTimeline_create(1, 0, 0)));
+		case SP_TIMELINE_ROTATE:
+			return SUPER(SUPER(spRotateTimeline_create(1, 0, 0)));
+		case SP_TIMELINE_SCALEX:
+			return SUPER(SUPER(spScaleXTimeline_create(1, 0, 0)));
+		case SP_TIMELINE_SCALEY:
+			return SUPER(SUPER(spScaleYTimeline_create(1, 0, 0)));
+		case SP_TIMELINE_SHEARX:
+			return SUPER(SUPER(spShearXTimeline_create(1, 0, 0)));
+		case SP_TIMELINE_SHEARY:
+			return SUPER(SUPER(spShearYTimeline_create(1, 0, 0)));
+		case SP_TIMELINE_TRANSLATEX:
+			return SUPER(SUPER(spTranslateXTimeline_create(1, 0, 0)));
+		case SP_TIMELINE_TRANSLATEY:
+			return SUPER(SUPER(spTranslateYTimeline_create(1, 0, 0)));
+		case SP_TIMELINE_SCALE:
+			return SUPER(SUPER(spScaleTimeline_create(1, 0, 0)));
+		case SP_TIMELINE_SHEAR:
+			return SUPER(SUPER(spShearTimeline_create(1, 0, 0)));
+		case SP_TIMELINE_TRANSLATE:
+			return SUPER(SUPER(spTranslateTimeline_create(1, 0, 0)));
+		case SP_TIMELINE_DEFORM:
+			return SUPER(SUPER(spDeformTimeline_create(1, 0, 0, 0, SUB_CAST(spVertexAttachment, attachment))));
+		case SP_TIMELINE_SEQUENCE:
+			return SUPER(spSequenceTimeline_create(1, 0, attachment));
+		case SP_TIMELINE_IKCONSTRAINT:
+			return SUPER(SUPER(spIkConstraintTimeline_create(1, 0, 0)));
+		case SP_TIMELINE_PATHCONSTRAINTMIX:
+			return SUPER(SUPER(spPathConstraintMixTimeline_create(1, 0, 0)));
+		case SP_TIMELINE_RGB2:
+			return SUPER(SUPER(spRGB2Timeline_create(1, 0, 0)));
+		case SP_TIMELINE_RGBA2:
+			return SUPER(SUPER(spRGBA2Timeline_create(1, 0, 0)));
+		case SP_TIMELINE_RGBA:
+			return SUPER(SUPER(spRGBATimeline_create(1, 0, 0)));
+		case SP_TIMELINE_RGB:
+			return SUPER(SUPER(spRGBTimeline_create(1, 0, 0)));
+		case SP_TIMELINE_TRANSFORMCONSTRAINT:
+			return SUPER(SUPER(spTransformConstraintTimeline_create(1, 0, 0)));
+		case SP_TIMELINE_DRAWORDER:
+			return SUPER(spDrawOrderTimeline_create(1, 0));
+		case SP_TIMELINE_EVENT:
+			return SUPER(spEventTimeline_create(0));
+	}
+	return 0;
+}
+
+static void _spSkeletonDataImage_relocate(char *data, int field) {
+	size_t offset;
+	char *pointer;
+	memcpy(&offset, data + field, sizeof(offset));
+	pointer = data + offset;
+	memcpy(data + field, &pointer, sizeof(pointer));
+}
+
+/* Returns true if size bytes at offset are within the image. */
+static int _spImage_contains(int length, int offset, size_t size) {
+	return offset >= (int) sizeof(_spImageHeader) && (size_t) offset <= (size_t) length &&
+		   size <= (size_t) (length - offset);
+}
+
+/* Returns true if every offset the image stores is within it, before anything is relocated. */
+static int _spImage_validate(const char *data, int length) {
+	const _spImageHeader *header = (const _spImageHeader *) data;
+	const int *offsets;
+	int i;
+
+	if (header->relocationsCount < 0 || header->attachmentsCount < 0 || header->timelinesCount < 0) return 0;
+	if (!_spImage_contains(length, header->relocations, (size_t) header->relocationsCount * sizeof(int)) ||
+		!_spImage_contains(length, header->attachments, (size_t) header->attachmentsCount * sizeof(int)) ||
+		!_spImage_contains(length, header->timelines, (size_t) header->timelinesCount * sizeof(int)))
+		return 0;
+	if (header->relocations % sizeof(int) || header->attachments % sizeof(int) || header->timelines % sizeof(int)) return 0;
+	if (!_spImage_contains(length, header->skeletonData, sizeof(spSkeletonData))) return 0;
+	if (header->atlas && !_spImage_contains(length, header->atlas, sizeof(spAtlas))) return 0;
+
+	/* Each relocated field must be in the image and point into it. */
+	offsets = (const int *) (data + header->relocations);
+	for (i = 0; i < header->relocationsCount; i++) {
+		size_t offset;
+		if (!_spImage_contains(length, offsets[i], sizeof(size_t))) return 0;
+		memcpy(&offset, data + offsets[i], sizeof(offset));
+		if (offset > (size_t) length) return 0;
+	}
+
+	offsets = (const int *) (data + header->attachments);
+	for (i = 0; i < header->attachmentsCount; i++) {
+		const spAttachment *attachment = (const spAttachment *) (data + offsets[i]);
+		if (!_spImage_contains(length, offsets[i], sizeof(spAttachment)) || offsets[i] % IMAGE_ALIGNMENT) return 0;
+		if ((int) attachment->type < SP_ATTACHMENT_REGION || (int) attachment->type > SP_ATTACHMENT_CLIPPING) return 0;
+	}
+
+	offsets = (const int *) (data + header->timelines);
+	for (i = 0; i < header->timelinesCount; i++) {
+		const spTimeline *timeline = (const spTimeline *) (data + offsets[i]);
+		if (!_spImage_contains(length, offsets[i], sizeof(spTimeline)) || offsets[i] % IMAGE_ALIGNMENT) return 0;
+		if ((int) timeline->type < SP_TIMELINE_ATTACHMENT || (int) timeline->type > SP_TIMELINE_EVENT) return 0;
+	}
+	return -1;
+}
+
+spSkeletonDataImage *spSkeletonDataImage_create(char *data, int length, const char *dir, void *rendererObject) {
+	_spSkeletonDataImage *self;
+	_spImageHeader *header = (_spImageHeader *) data;
+	spTimeline *timelineTemplates[SP_TIMELINE_EVENT + 1];
+	spAtlasPage *page;
+	const int *offsets;
+	int i;
+
+	if (length < (int) sizeof(_spImageHeader) || memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0 ||
+		header->version != IMAGE_VERSION || header->layout != _spImage_layout() || header->length != length)
+		return 0;
+	if (!_spImage_validate(data, length)) return 0;
+
+	offsets = (const int *) (data + header->relocations);
+	for (i = 0; i < header->relocationsCount; i++)
+		_spSkeletonDataImage_relocate(data, offsets[i]);
+
+	self = NEW(_spSkeletonDataImage);
+	self->data = data;
+	CONST_CAST(spSkeletonData *, self->super.skeletonData) = (spSkeletonData *) (data + header->skeletonData);
+	if (header->atlas) CONST_CAST(spAtlas *, self->super.atlas) = (spAtlas *) (data + header->atlas);
+
+	/* Attachments share the vtable of a template attachment of the same type, which lives as long as the image. */
+	offsets = (const int *) (data + header->attachments);
+	for (i = 0; i < header->attachmentsCount; i++) {
+		spAttachment *attachment = (spAttachment *) (data + offsets[i]);
+		CONST_CAST(const void *, attachment->vtable) = _spSkeletonDataImage_getTemplate(self, attachment->type)->vtable;
+	}
+
+	memset(timelineTemplates, 0, sizeof(timelineTemplates));
+	offsets = (const int *) (data + header->timelines);
+	for (i = 0; i < header->timelinesCount; i++) {
+		spTimeline *timeline = (spTimeline *) (data + offsets[i]);
+		if (!timelineTemplates[timeline->type])
+			timelineTemplates[timeline->type] = _spTimeline_createTemplate(
+					timeline->type, _spSkeletonDataImage_getTemplate(self, SP_ATTACHMENT_BOUNDING_BOX));
+		timeline->vtable = timelineTemplates[timeline->type]->vtable;
+	}
+	for (i = 0; i <= SP_TIMELINE_EVENT; i++)
+		if (timelineTemplates[i]) spTimeline_dispose(timelineTemplates[i]);
+
+	if (self->super.atlas) {
+		int dirLength;
+		if (!dir) dir = "";
+		dirLength = (int) strlen(dir);
+		int needsSlash = dirLength > 0 && dir[dirLength - 1] != '/' && dir[dirLength - 1] != '\\';
+		self->super.atlas->rendererObject = rendererObject;
+		for (page = self->super.atlas->pages; page; page = page->next) {
+			char *path = CALLOC(char, dirLength + needsSlash + strlen(page->name) + 1);
+			memcpy(path, dir, dirLength);
+			if (needsSlash) path[dirLength] = '/';
+			strcpy(path + dirLength + needsSlash, page->name);
+			_spAtlasPage_createTexture(page, path);
+			FREE(path);
+		}
+	}
+	return SUPER(self);
+}
+
+spSkeletonDataImage *spSkeletonDataImage_createFromFile(const char *path, void *rendererObject) {
+	int dirLength;
+	char *dir;
+	int length;
+	char *data;
+
+	spSkeletonDataImage *image = 0;
+
+	/* Get directory from image path. */
+	const char *lastForwardSlash = strrchr(path, '/');
+	const char *lastBackwardSlash = strrchr(path, '\\');
+	const char *lastSlash = lastForwardSlash > lastBackwardSlash ? lastForwardSlash : lastBackwardSlash;
+	if (lastSlash == path) lastSlash++; /* Never drop starting slash. */
+	dirLength = (int) (lastSlash ? lastSlash - path : 0);
+	dir = MALLOC(char, dirLength + 1);
+	memcpy(dir, path, dirLength);
+	dir[dirLength] = '\0';
+
+	data = _spUtil_readFile(path, &length);
+	if (data) image = spSkeletonDataImage_create(data, length, dir, rendererObject);
+	if (image)
+		SUB_CAST(_spSkeletonDataImage, image)->ownsData = -1;
+	else
+		FREE(data);
+
+	FREE(dir);
+	return image;
+}
+
+void spSkeletonDataImage_dispose(spSkeletonDataImage *self) {
+	_spSkeletonDataImage *internal = SUB_CAST(_spSkeletonDataImage, self);
+	spAtlasPage *page;
+	int i;
+	if (self->atlas) {
+		for (page = self->atlas->pages; page; page = page->next)
+			_spAtlasPage_disposeTexture(page);
+	}
+	for (i = 0; i <= SP_ATTACHMENT_CLIPPING; i++)
+		if (internal->templates[i]) spAttachment_dispose(internal->templates[i]);
+	if (internal->ownsData) FREE(internal->data);
+	FREE(self);
+}
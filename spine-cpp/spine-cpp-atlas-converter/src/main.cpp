@@ -0,0 +1,60 @@
+#include <spine/Debug.h>
+#include <spine/spine.h>
+#include <stdio.h>
+#include <time.h>
+
+using namespace spine;
+
+// Converts a text .atlas file to the binary atlas format and reports the load time of both.
+// Usage: spine_cpp_atlas_converter <input.atlas> <output>
+
+double loadTime(const char *data, int length, int iterations) {
+	clock_t start = clock();
+	for (int i = 0; i < iterations; i++) {
+		Atlas atlas(data, length, "", NULL, false);
+		atlas.findRegion("");
+	}
+	return (double) (clock() - start) / CLOCKS_PER_SEC / iterations * 1000000;
+}
+
+namespace spine {
+	SpineExtension *getDefaultExtension() {
+		return new DefaultSpineExtension();
+	}
+}// namespace spine
+
+int main(int argc, char **argv) {
+	if (argc < 3) {
+		printf("Usage: %s <input.atlas> <output>\n", argv[0]);
+		return 1;
+	}
+
+	int textLength;
+	char *text = SpineExtension::readFile(argv[1], &textLength);
+	if (!text) {
+		printf("Error: could not read %s\n", argv[1]);
+		return 1;
+	}
+
+	Atlas atlas(text, textLength, "", NULL, false);
+	Vector<char> binary;
+	atlas.writeBinary(binary);
+
+	FILE *file = fopen(argv[2], "wb");
+	if (!file || fwrite(binary.buffer(), 1, binary.size(), file) != binary.size()) {
+		printf("Error: could not write %s\n", argv[2]);
+		if (file) fclose(file);
+		SpineExtension::free(text, __FILE__, __LINE__);
+		return 1;
+	}
+	fclose(file);
+
+	const int iterations = 100;
+	printf("%d pages, %d regions\n", (int) atlas.getPages().size(), (int) atlas.getRegions().size());
+	printf("text:   %8d bytes, %10.1f us per load\n", textLength, loadTime(text, textLength, iterations));
+	printf("binary: %8d bytes, %10.1f us per load\n", (int) binary.size(),
+		   loadTime(binary.buffer(), (int) binary.size(), iterations));
+
+	SpineExtension::free(text, __FILE__, __LINE__);
+	return 0;
+}
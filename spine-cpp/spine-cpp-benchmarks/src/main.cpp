@@ -0,0 +1,348 @@
+#include <spine/Debug.h>
+#include <spine/spine.h>
+#include <spine/Version.h>
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+
+using namespace spine;
+
+// Benchmarks loading, animating, posing and rendering skeletons and writes the results as JSON, eg to track performance
+// across releases. Without a skeleton, the example skeletons copied to testdata are used.
+// Usage: spine_cpp_benchmarks [<skeleton.json> <skeleton.skel> <atlas>] [output.json]
+
+struct Rig {
+	String name;
+	String jsonFile;
+	String binaryFile;
+	String atlasFile;
+};
+
+struct Results {
+	int bones, slots, animations, skins;
+	double atlasLoad, jsonLoad, binaryLoad;
+	size_t jsonPeak, jsonRetained, binaryPeak, binaryRetained;
+	double updateApply, worldTransform, worldTransformIncremental, worldTransformFastTrig;
+	double worldVertices, worldVerticesClipped, bounds, skinSwitch;
+	double snapshotSave, snapshotRestore;
+	size_t snapshotBytes;
+};
+
+typedef std::chrono::steady_clock Clock;
+
+static const int LOAD_ITERATIONS = 20;
+static const int FRAMES = 3000;
+static const int FRAMES_PER_ANIMATION = 120;
+static const int SKIN_SWITCHES = 2000;
+static const int SNAPSHOTS = 2000;
+
+static double microseconds(Clock::duration duration) {
+	return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+static SkeletonData *readSkeletonData(const String &file, Atlas *atlas, bool binary) {
+	SkeletonData *skeletonData;
+	if (binary) {
+		SkeletonBinary reader(atlas);
+		skeletonData = reader.readSkeletonDataFile(file);
+		if (!skeletonData) printf("Error: %s\n", reader.getError().buffer());
+	} else {
+		SkeletonJson reader(atlas);
+		skeletonData = reader.readSkeletonDataFile(file);
+		if (!skeletonData) printf("Error: %s\n", reader.getError().buffer());
+	}
+	return skeletonData;
+}
+
+static double loadTime(const String &file, Atlas *atlas, bool binary) {
+	Clock::time_point start = Clock::now();
+	for (int i = 0; i < LOAD_ITERATIONS; i++)
+		delete readSkeletonData(file, atlas, binary);
+	return microseconds(Clock::now() - start) / LOAD_ITERATIONS;
+}
+
+// Measures the memory allocated while loading and the memory retained by the loaded skeleton data.
+static void loadMemory(const String &file, Atlas *atlas, bool binary, size_t &peak, size_t &retained) {
+	SpineExtension *extension = SpineExtension::getInstance();
+	DebugExtension debug(extension);
+	SpineExtension::setInstance(&debug);
+	debug.resetPeakMemory();
+	SkeletonData *skeletonData = readSkeletonData(file, atlas, binary);
+	peak = debug.getPeakMemory();
+	retained = debug.getUsedMemory();
+	delete skeletonData;
+	SpineExtension::setInstance(extension);
+}
+
+// Computes the world vertices of all visible region and mesh attachments the way a renderer does, optionally clipping
+// them.
+static void render(Skeleton &skeleton, SkeletonClipping *clipper, Vector<float> &worldVertices,
+				   Vector<unsigned short> &quadIndices) {
+	for (size_t i = 0, n = skeleton.getDrawOrder().size(); i < n; i++) {
+		Slot &slot = *skeleton.getDrawOrder()[i];
+		Attachment *attachment = slot.getAttachment();
+		if (!attachment) continue;
+		if (slot.getColor().a == 0 || !slot.getBone().isActive()) {
+			if (clipper) clipper->clipEnd(slot);
+			continue;
+		}
+
+		Vector<float> *uvs;
+		Vector<unsigned short> *indices;
+		if (attachment->getRTTI().isExactly(RegionAttachment::rtti)) {
+			RegionAttachment *region = (RegionAttachment *) attachment;
+			worldVertices.setSize(8, 0);
+			region->computeWorldVertices(slot, worldVertices, 0, 2);
+			uvs = &region->getUVs();
+			indices = &quadIndices;
+		} else if (attachment->getRTTI().isExactly(MeshAttachment::rtti)) {
+			MeshAttachment *mesh = (MeshAttachment *) attachment;
+			worldVertices.setSize(mesh->getWorldVerticesLength(), 0);
+			mesh->computeWorldVertices(slot, 0, mesh->getWorldVerticesLength(), worldVertices.buffer(), 0, 2);
+			uvs = &mesh->getUVs();
+			indices = &mesh->getTriangles();
+		} else if (attachment->getRTTI().isExactly(ClippingAttachment::rtti)) {
+			if (clipper) clipper->clipStart(slot, (ClippingAttachment *) attachment);
+			continue;
+		} else
+			continue;
+
+		if (clipper) {
+			if (clipper->isClipping()) clipper->clipTriangles(worldVertices, *indices, *uvs, 2);
+			clipper->clipEnd(slot);
+		}
+	}
+	if (clipper) clipper->clipEnd();
+}
+
+// Plays all animations in turn, mixing between them, and measures each stage of a frame.
+static void animate(SkeletonData *skeletonData, Results &results) {
+	AnimationStateData stateData(skeletonData);
+	stateData.setDefaultMix(0.2f);
+	Skeleton skeleton(skeletonData);
+	AnimationState state(&stateData);
+	SkeletonClipping clipper;
+	SkeletonBounds bounds;
+	Vector<float> worldVertices;
+	Vector<unsigned short> quadIndices;
+	unsigned short quad[] = {0, 1, 2, 2, 3, 0};
+	for (int i = 0; i < 6; i++)
+		quadIndices.add(quad[i]);
+	if (skeletonData->getSkins().size() > 1) skeleton.setSkin(skeletonData->getSkins()[1]);
+	skeleton.setSlotsToSetupPose();
+
+	Vector<Animation *> &animations = skeletonData->getAnimations();
+	Clock::duration updateApply(0), worldTransform(0), vertices(0), clippedVertices(0), boundsUpdate(0);
+	for (int frame = 0; frame < FRAMES; frame++) {
+		if (frame % FRAMES_PER_ANIMATION == 0 && animations.size() > 0)
+			state.setAnimation(0, animations[(frame / FRAMES_PER_ANIMATION) % animations.size()], true);
+		Clock::time_point start = Clock::now();
+		state.update(1 / 60.0f);
+		state.apply(skeleton);
+		Clock::time_point end = Clock::now();
+		updateApply += end - start;
+
+		start = end;
+		skeleton.updateWorldTransform();
+		end = Clock::now();
+		worldTransform += end - start;
+
+		start = end;
+		render(skeleton, NULL, worldVertices, quadIndices);
+		end = Clock::now();
+		vertices += end - start;
+
+		start = end;
+		render(skeleton, &clipper, worldVertices, quadIndices);
+		end = Clock::now();
+		clippedVertices += end - start;
+
+		start = end;
+		bounds.update(skeleton, true);
+		end = Clock::now();
+		boundsUpdate += end - start;
+	}
+	results.updateApply = microseconds(updateApply) / FRAMES;
+	results.worldTransform = microseconds(worldTransform) / FRAMES;
+	results.worldVertices = microseconds(vertices) / FRAMES;
+	results.worldVerticesClipped = microseconds(clippedVertices) / FRAMES;
+	results.bounds = microseconds(boundsUpdate) / FRAMES;
+}
+
+// Measures only Skeleton::updateWorldTransform() while playing all animations in turn.
+static double worldTransformTime(SkeletonData *skeletonData, bool incremental, bool fastTrig) {
+	Skeleton skeleton(skeletonData);
+	skeleton.setIncremental(incremental);
+	MathUtil::setFastTrig(fastTrig);
+	Vector<Animation *> &animations = skeletonData->getAnimations();
+	Clock::duration duration(0);
+	for (int frame = 0; frame < FRAMES; frame++) {
+		if (animations.size() > 0) {
+			Animation *animation = animations[(frame / FRAMES_PER_ANIMATION) % animations.size()];
+			float time = (frame % FRAMES_PER_ANIMATION) / 60.0f;
+			animation->apply(skeleton, time, time, true, NULL, 1, MixBlend_Setup, MixDirection_In);
+		}
+		Clock::time_point start = Clock::now();
+		skeleton.updateWorldTransform();
+		duration += Clock::now() - start;
+	}
+	MathUtil::setFastTrig(false);
+	return microseconds(duration) / FRAMES;
+}
+
+// Measures setting each skin in turn, including the slot attachments and the update cache.
+static double skinSwitchTime(SkeletonData *skeletonData) {
+	Vector<Skin *> &skins = skeletonData->getSkins();
+	if (skins.size() < 2) return 0;
+	Skeleton skeleton(skeletonData);
+	Clock::time_point start = Clock::now();
+	for (int i = 0; i < SKIN_SWITCHES; i++) {
+		skeleton.setSkin(skins[i % skins.size()]);
+		skeleton.setSlotsToSetupPose();
+	}
+	return microseconds(Clock::now() - start) / SKIN_SWITCHES;
+}
+
+// Measures saving and restoring a snapshot of the skeleton and an animation state mixing between two animations.
+static void snapshotTime(SkeletonData *skeletonData, Results &results) {
+	AnimationStateData stateData(skeletonData);
+	stateData.setDefaultMix(0.5f);
+	Skeleton skeleton(skeletonData);
+	AnimationState state(&stateData);
+	Vector<Animation *> &animations = skeletonData->getAnimations();
+	if (animations.size() > 0) {
+		state.setAnimation(0, animations[0], true);
+		state.update(0.25f);
+		state.setAnimation(0, animations[animations.size() - 1], true);
+		state.update(0.25f);
+	}
+	state.apply(skeleton);
+	skeleton.updateWorldTransform();
+
+	SkeletonSnapshot snapshot;
+	snapshot.save(skeleton, &state);
+	Clock::time_point start = Clock::now();
+	for (int i = 0; i < SNAPSHOTS; i++)
+		snapshot.save(skeleton, &state);
+	Clock::time_point end = Clock::now();
+	results.snapshotSave = microseconds(end - start) / SNAPSHOTS;
+
+	start = end;
+	for (int i = 0; i < SNAPSHOTS; i++)
+		snapshot.restore(skeleton, &state);
+	results.snapshotRestore = microseconds(Clock::now() - start) / SNAPSHOTS;
+	results.snapshotBytes = snapshot.getSize();
+}
+
+static bool benchmark(Rig &rig, Results &results) {
+	Clock::time_point start = Clock::now();
+	for (int i = 0; i < LOAD_ITERATIONS; i++)
+		delete new (__FILE__, __LINE__) Atlas(rig.atlasFile, NULL);
+	results.atlasLoad = microseconds(Clock::now() - start) / LOAD_ITERATIONS;
+
+	Atlas *atlas = new (__FILE__, __LINE__) Atlas(rig.atlasFile, NULL);
+	SkeletonData *skeletonData = readSkeletonData(rig.binaryFile, atlas, true);
+	if (!skeletonData) {
+		delete atlas;
+		return false;
+	}
+	results.bones = (int) skeletonData->getBones().size();
+	results.slots = (int) skeletonData->getSlots().size();
+	results.animations = (int) skeletonData->getAnimations().size();
+	results.skins = (int) skeletonData->getSkins().size();
+
+	results.jsonLoad = loadTime(rig.jsonFile, atlas, false);
+	results.binaryLoad = loadTime(rig.binaryFile, atlas, true);
+	loadMemory(rig.jsonFile, atlas, false, results.jsonPeak, results.jsonRetained);
+	loadMemory(rig.binaryFile, atlas, true, results.binaryPeak, results.binaryRetained);
+
+	animate(skeletonData, results);
+	results.worldTransformIncremental = worldTransformTime(skeletonData, true, false);
+	results.worldTransformFastTrig = worldTransformTime(skeletonData, false, true);
+	results.skinSwitch = skinSwitchTime(skeletonData);
+	snapshotTime(skeletonData, results);
+
+	delete skeletonData;
+	delete atlas;
+	return true;
+}
+
+static void writeResults(FILE *file, Rig &rig, Results &results, bool last) {
+	fprintf(file, "    {\n");
+	fprintf(file, "      \"name\": \"%s\",\n", rig.name.buffer());
+	fprintf(file, "      \"bones\": %d,\n", results.bones);
+	fprintf(file, "      \"slots\": %d,\n", results.slots);
+	fprintf(file, "      \"animations\": %d,\n", results.animations);
+	fprintf(file, "      \"skins\": %d,\n", results.skins);
+	fprintf(file, "      \"atlas_load_us\": %.3f,\n", results.atlasLoad);
+	fprintf(file, "      \"json_load_us\": %.3f,\n", results.jsonLoad);
+	fprintf(file, "      \"json_load_peak_bytes\": %zu,\n", results.jsonPeak);
+	fprintf(file, "      \"json_load_retained_bytes\": %zu,\n", results.jsonRetained);
+	fprintf(file, "      \"binary_load_us\": %.3f,\n", results.binaryLoad);
+	fprintf(file, "      \"binary_load_peak_bytes\": %zu,\n", results.binaryPeak);
+	fprintf(file, "      \"binary_load_retained_bytes\": %zu,\n", results.binaryRetained);
+	fprintf(file, "      \"update_apply_us\": %.3f,\n", results.updateApply);
+	fprintf(file, "      \"update_world_transform_us\": %.3f,\n", results.worldTransform);
+	fprintf(file, "      \"update_world_transform_incremental_us\": %.3f,\n", results.worldTransformIncremental);
+	fprintf(file, "      \"update_world_transform_fast_trig_us\": %.3f,\n", results.worldTransformFastTrig);
+	fprintf(file, "      \"compute_world_vertices_us\": %.3f,\n", results.worldVertices);
+	fprintf(file, "      \"compute_world_vertices_clipped_us\": %.3f,\n", results.worldVerticesClipped);
+	fprintf(file, "      \"skeleton_bounds_us\": %.3f,\n", results.bounds);
+	fprintf(file, "      \"skin_switch_us\": %.3f,\n", results.skinSwitch);
+	fprintf(file, "      \"snapshot_save_us\": %.3f,\n", results.snapshotSave);
+	fprintf(file, "      \"snapshot_restore_us\": %.3f,\n", results.snapshotRestore);
+	fprintf(file, "      \"snapshot_bytes\": %zu\n", results.snapshotBytes);
+	fprintf(file, "    }%s\n", last ? "" : ",");
+}
+
+namespace spine {
+	SpineExtension *getDefaultExtension() {
+		return new DefaultSpineExtension();
+	}
+}// namespace spine
+
+int main(int argc, char **argv) {
+	Vector<Rig> rigs;
+	const char *output = NULL;
+	if (argc >= 4) {
+		Rig rig;
+		rig.name = argv[2];
+		rig.jsonFile = argv[1];
+		rig.binaryFile = argv[2];
+		rig.atlasFile = argv[3];
+		rigs.add(rig);
+		if (argc > 4) output = argv[4];
+	} else if (argc == 3) {
+		printf("Usage: %s [<skeleton.json> <skeleton.skel> <atlas>] [output.json]\n", argv[0]);
+		return 1;
+	} else {
+		const char *names[] = {"spineboy", "raptor", "goblins", "mix-and-match", "coin", "tank", "stretchyman"};
+		for (int i = 0; i < 7; i++) {
+			Rig rig;
+			rig.name = names[i];
+			rig.jsonFile.append("testdata/").append(names[i]).append("/").append(names[i]).append("-pro.json");
+			rig.binaryFile.append("testdata/").append(names[i]).append("/").append(names[i]).append("-pro.skel");
+			rig.atlasFile.append("testdata/").append(names[i]).append("/").append(names[i]).append(".atlas");
+			rigs.add(rig);
+		}
+		if (argc > 1) output = argv[1];
+	}
+
+	FILE *file = output ? fopen(output, "w") : stdout;
+	if (!file) {
+		printf("Error: could not write %s\n", output);
+		return 1;
+	}
+	fprintf(file, "{\n  \"version\": \"%s\",\n  \"skeletons\": [\n", SPINE_VERSION_STRING);
+	for (size_t i = 0; i < rigs.size(); i++) {
+		Results result;
+		if (!benchmark(rigs[i], result)) {
+			if (output) fclose(file);
+			return 1;
+		}
+		writeResults(file, rigs[i], result, i == rigs.size() - 1);
+	}
+	fprintf(file, "  ]\n}\n");
+	if (output) fclose(file);
+	return 0;
+}
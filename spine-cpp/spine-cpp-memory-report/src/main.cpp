@@ -0,0 +1,104 @@
+#include <spine/Debug.h>
+#include <spine/spine.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+using namespace spine;
+
+// Reports the keyframe memory of each animation of a skeleton before and after Animation::compress(), and the heap used
+// by the skeleton data when read normally, with compacted attachments and headless.
+// Usage: spine_cpp_memory_report <skeleton.json|skeleton.skel> <atlas> [angle translate scale tolerances]
+
+// Reads the skeleton data headless if atlas is NULL.
+SkeletonData *readSkeletonData(const char *skeletonFile, Atlas *atlas, bool vertices = true, bool compact = false) {
+	AttachmentLoader *loader;
+	if (atlas)
+		loader = new (__FILE__, __LINE__) AtlasAttachmentLoader(atlas);
+	else
+		loader = new (__FILE__, __LINE__) HeadlessAttachmentLoader();
+	size_t length = strlen(skeletonFile);
+	if (length > 5 && strcmp(skeletonFile + length - 5, ".skel") == 0) {
+		SkeletonBinary binary(loader, true);
+		binary.setHeadless(!atlas, vertices);
+		binary.setCompactAttachments(compact);
+		SkeletonData *skeletonData = binary.readSkeletonDataFile(skeletonFile);
+		if (!skeletonData) printf("Error: %s\n", binary.getError().buffer());
+		return skeletonData;
+	}
+	SkeletonJson json(loader, true);
+	json.setHeadless(!atlas, vertices);
+	json.setCompactAttachments(compact);
+	SkeletonData *skeletonData = json.readSkeletonDataFile(skeletonFile);
+	if (!skeletonData) printf("Error: %s\n", json.getError().buffer());
+	return skeletonData;
+}
+
+// Returns the heap used by the skeleton data and, unless read headless, its atlas.
+size_t loadedMemory(DebugExtension &debug, const char *skeletonFile, const char *atlasFile, bool headless, bool vertices,
+					bool compact) {
+	size_t usedBefore = debug.getUsedMemory();
+	Atlas *atlas = headless ? NULL : new (__FILE__, __LINE__) Atlas(atlasFile, NULL);
+	SkeletonData *skeletonData = readSkeletonData(skeletonFile, atlas, vertices, compact);
+	size_t used = debug.getUsedMemory() - usedBefore;
+	delete skeletonData;
+	delete atlas;
+	return used;
+}
+
+namespace spine {
+	SpineExtension *getDefaultExtension() {
+		return new DefaultSpineExtension();
+	}
+}// namespace spine
+
+int main(int argc, char **argv) {
+	if (argc < 3) {
+		printf("Usage: %s <skeleton.json|skeleton.skel> <atlas> [angle translate scale tolerances]\n", argv[0]);
+		return 1;
+	}
+	float angleTolerance = argc > 3 ? (float) atof(argv[3]) : 0.05f;
+	float translateTolerance = argc > 4 ? (float) atof(argv[4]) : 0.05f;
+	float scaleTolerance = argc > 5 ? (float) atof(argv[5]) : 0.001f;
+
+	DebugExtension debug(SpineExtension::getInstance());
+	SpineExtension::setInstance(&debug);
+
+	Atlas *atlas = new (__FILE__, __LINE__) Atlas(argv[2], NULL);
+	SkeletonData *skeletonData = readSkeletonData(argv[1], atlas);
+	if (!skeletonData) {
+		delete atlas;
+		return 1;
+	}
+
+	printf("%-24s %10s %10s %8s\n", "animation", "before", "after", "ratio");
+	size_t totalBefore = 0, totalAfter = 0, usedBefore = debug.getUsedMemory();
+	Vector<Animation *> &animations = skeletonData->getAnimations();
+	for (size_t i = 0; i < animations.size(); i++) {
+		Animation *animation = animations[i];
+		size_t before = animation->getMemoryUsage();
+		animation->compress(angleTolerance, translateTolerance, scaleTolerance);
+		size_t after = animation->getMemoryUsage();
+		printf("%-24s %10d %10d %7.1f%%\n", animation->getName().buffer(), (int) before, (int) after,
+			   before > 0 ? after * 100.0f / before : 100.0f);
+		totalBefore += before;
+		totalAfter += after;
+	}
+	printf("%-24s %10d %10d %7.1f%%\n", "total", (int) totalBefore, (int) totalAfter,
+		   totalBefore > 0 ? totalAfter * 100.0f / totalBefore : 100.0f);
+	printf("Heap in use: %d -> %d bytes\n", (int) usedBefore, (int) debug.getUsedMemory());
+
+	delete skeletonData;
+	delete atlas;
+
+	size_t full = loadedMemory(debug, argv[1], argv[2], false, true, false);
+	size_t compact = loadedMemory(debug, argv[1], argv[2], false, true, true);
+	size_t headless = loadedMemory(debug, argv[1], argv[2], true, true, false);
+	size_t headlessNoVertices = loadedMemory(debug, argv[1], argv[2], true, false, false);
+	printf("\n%-24s %10s %8s\n", "load", "heap", "ratio");
+	printf("%-24s %10d %7.1f%%\n", "full", (int) full, 100.0f);
+	printf("%-24s %10d %7.1f%%\n", "compact", (int) compact, compact * 100.0f / full);
+	printf("%-24s %10d %7.1f%%\n", "headless", (int) headless, headless * 100.0f / full);
+	printf("%-24s %10d %7.1f%%\n", "headless, no vertices", (int) headlessNoVertices, headlessNoVertices * 100.0f / full);
+	return 0;
+}
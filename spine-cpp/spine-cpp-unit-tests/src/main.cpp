@@ -1,6 +1,14 @@
+#include <spine/BulkLoader.h>
+#include <spine/ChromeTraceProfiler.h>
 #include <spine/Debug.h>
 #include <spine/spine.h>
 #include <stdio.h>
+#include <math.h>
+#include <string.h>
+#include <time.h>
+
+#include <atomic>
+#include <thread>
 
 #ifdef MSVC
 #pragma warning(disable : 4710)
@@ -98,12 +106,1607 @@ void testLoading() {
 	}
 }
 
+struct RecordedEvent {
+	RecordedEvent(EventType type, Animation *animation, Event *event) : _type(type), _animation(animation), _event(event) {}
+
+	bool operator==(const RecordedEvent &other) const {
+		return _type == other._type && _animation == other._animation && _event == other._event;
+	}
+
+	bool operator!=(const RecordedEvent &other) const { return !(*this == other); }
+
+	EventType _type;
+	Animation *_animation;
+	Event *_event;
+};
+
+static Vector<RecordedEvent> *recordedEvents = NULL;
+
+void recordEvent(AnimationState *state, EventType type, TrackEntry *entry, Event *event) {
+	SP_UNUSED(state);
+	if (recordedEvents && type != EventType_Dispose) recordedEvents->add(RecordedEvent(type, entry->getAnimation(), event));
+}
+
+void playCulled(AnimationState *state, Skeleton *skeleton, int culledStart, int culledEnd, int applyInterval, Vector<RecordedEvent> &events) {
+	recordedEvents = &events;
+	state->setListener(recordEvent);
+	state->setApplyInterval(applyInterval);
+	state->setAnimation(0, "walk", true);
+	state->addAnimation(0, "run", true, 1.5f);
+	state->addAnimation(0, "jump", false, 1);
+	state->addAnimation(0, "idle", false, 0);
+	for (int frame = 0; frame < 400; frame++) {
+		state->setCulled(frame >= culledStart && frame < culledEnd);
+		state->update(1 / 60.0f);
+		if (state->apply(*skeleton)) skeleton->updateWorldTransform();
+	}
+	recordedEvents = NULL;
+}
+
+void testCulling() {
+	Atlas *atlas = NULL;
+	SkeletonData *skeletonData = NULL;
+	AnimationStateData *stateData = NULL;
+	Skeleton *skeleton = NULL;
+	AnimationState *state = NULL;
+	loadBinary("testdata/spineboy/spineboy-pro.skel", "testdata/spineboy/spineboy.atlas", atlas, skeletonData, stateData, skeleton, state);
+
+	Vector<RecordedEvent> expected;
+	playCulled(state, skeleton, 0, 0, 1, expected);
+	assert(expected.size() > 0);
+
+	// Culled and throttled playback must raise the same events in the same order.
+	int configs[][3] = {{50, 250, 1}, {0, 400, 1}, {0, 0, 3}, {100, 150, 4}};
+	for (size_t i = 0; i < sizeof(configs) / sizeof(configs[0]); i++) {
+		AnimationState *culledState = new (__FILE__, __LINE__) AnimationState(stateData);
+		Vector<RecordedEvent> actual;
+		playCulled(culledState, skeleton, configs[i][0], configs[i][1], configs[i][2], actual);
+		assert(actual == expected);
+		delete culledState;
+	}
+	printf("Culling: %zu events match\n", expected.size());
+
+	dispose(atlas, skeletonData, stateData, skeleton, state);
+}
+
+void testLod() {
+	Atlas *atlas = NULL;
+	SkeletonData *skeletonData = NULL;
+	AnimationStateData *stateData = NULL;
+	Skeleton *skeleton = NULL;
+	AnimationState *state = NULL;
+	loadBinary("testdata/raptor/raptor-pro.skel", "testdata/raptor/raptor.atlas", atlas, skeletonData, stateData, skeleton, state);
+
+	LodLevel *level = new (__FILE__, __LINE__) LodLevel(4);
+	level->getBones().add(skeletonData->findBone("tail1"));
+	skeletonData->getLodLevels().add(level);
+
+	state->setAnimation(0, "walk", true);
+	state->update(0.5f);
+	state->apply(*skeleton);
+	skeleton->updateWorldTransform();
+	Vector<float> expected;
+	for (size_t i = 0; i < skeleton->getBones().size(); i++)
+		expected.add(skeleton->getBones()[i]->getWorldX());
+
+	skeleton->setLodLevel(1);
+	size_t lodCacheSize = skeleton->getUpdateCacheList().size(), rigid = 0;
+	for (size_t i = 0; i < skeleton->getBones().size(); i++)
+		if (skeleton->getBones()[i]->isRigid()) rigid++;
+	assert(rigid > 0);
+	assert(skeleton->findBone("tail10")->isRigid());
+	skeleton->updateWorldTransform();
+
+	// Switching back to full detail must restore the exact pose.
+	skeleton->setLodLevel(0);
+	assert(skeleton->getUpdateCacheList().size() > lodCacheSize);
+	skeleton->updateWorldTransform();
+	for (size_t i = 0; i < skeleton->getBones().size(); i++)
+		assert(expected[i] == skeleton->getBones()[i]->getWorldX());
+	printf("LOD: %zu of %zu bones rigid\n", rigid, skeleton->getBones().size());
+
+	dispose(atlas, skeletonData, stateData, skeleton, state);
+}
+
+void testBaking() {
+	Atlas *atlas = NULL;
+	SkeletonData *skeletonData = NULL, *bakedData = NULL;
+	AnimationStateData *stateData = NULL, *bakedStateData = NULL;
+	Skeleton *skeleton = NULL, *bakedSkeleton = NULL;
+	AnimationState *state = NULL, *bakedState = NULL;
+	loadBinary("testdata/spineboy/spineboy-pro.skel", "testdata/spineboy/spineboy.atlas", atlas, skeletonData, stateData, skeleton, state);
+	Atlas *bakedAtlas = NULL;
+	loadBinary("testdata/spineboy/spineboy-pro.skel", "testdata/spineboy/spineboy.atlas", bakedAtlas, bakedData, bakedStateData, bakedSkeleton, bakedState);
+
+	Animation *walk = bakedData->findAnimation("walk");
+	size_t timelineCount = walk->getTimelines().size();
+	walk->bake(*bakedData, 60);
+	assert(walk->getTimelines().size() < timelineCount);
+	assert(walk->getTimelines()[0]->getRTTI().isExactly(BakedTimeline::rtti));
+
+	state->setAnimation(0, "walk", true);
+	bakedState->setAnimation(0, "walk", true);
+	float maxError = 0;
+	for (int frame = 0; frame < 120; frame++) {
+		state->update(1 / 60.0f);
+		state->apply(*skeleton);
+		skeleton->updateWorldTransform();
+		bakedState->update(1 / 60.0f);
+		bakedState->apply(*bakedSkeleton);
+		bakedSkeleton->updateWorldTransform();
+		for (size_t i = 0; i < skeleton->getBones().size(); i++) {
+			Bone *bone = skeleton->getBones()[i], *bakedBone = bakedSkeleton->getBones()[i];
+			maxError = MathUtil::max(maxError, MathUtil::abs(bone->getWorldX() - bakedBone->getWorldX()));
+			maxError = MathUtil::max(maxError, MathUtil::abs(bone->getWorldY() - bakedBone->getWorldY()));
+		}
+	}
+	assert(maxError < 0.5f);
+	printf("Baking: max world position error %f\n", maxError);
+
+	// Baked animations mix with regular animations the same as the timelines they replace, mixing out and in again.
+	AnimationState *states[] = {state, bakedState};
+	for (int i = 0; i < 2; i++) {
+		states[i]->setAnimation(0, "run", true);
+		states[i]->addAnimation(0, "walk", true, 0.3f);
+		TrackEntry *entry = states[i]->setAnimation(1, "aim", true);
+		entry->setAlpha(0.5f);
+	}
+	float maxMixError = 0;
+	for (int frame = 0; frame < 90; frame++) {
+		state->update(1 / 60.0f);
+		state->apply(*skeleton);
+		skeleton->updateWorldTransform();
+		bakedState->update(1 / 60.0f);
+		bakedState->apply(*bakedSkeleton);
+		bakedSkeleton->updateWorldTransform();
+		for (size_t i = 0; i < skeleton->getBones().size(); i++) {
+			Bone *bone = skeleton->getBones()[i], *bakedBone = bakedSkeleton->getBones()[i];
+			maxMixError = MathUtil::max(maxMixError, MathUtil::abs(bone->getWorldX() - bakedBone->getWorldX()));
+			maxMixError = MathUtil::max(maxMixError, MathUtil::abs(bone->getWorldY() - bakedBone->getWorldY()));
+		}
+	}
+	assert(maxMixError < 0.05f);
+	printf("Baking: max world position error while mixing %f\n", maxMixError);
+
+	// The last sample is at the duration even when it is not a whole number of frames, so the final pose is reached.
+	Animation *death = skeletonData->findAnimation("death"), *bakedDeath = bakedData->findAnimation("death");
+	bakedDeath->bake(*bakedData, 7);
+	assert(bakedDeath->getDuration() * 7 != (int) (bakedDeath->getDuration() * 7));
+	skeleton->setToSetupPose();
+	bakedSkeleton->setToSetupPose();
+	death->apply(*skeleton, death->getDuration(), death->getDuration(), false, NULL, 1, MixBlend_Setup, MixDirection_In);
+	bakedDeath->apply(*bakedSkeleton, death->getDuration(), death->getDuration(), false, NULL, 1, MixBlend_Setup, MixDirection_In);
+	for (size_t i = 0; i < skeleton->getBones().size(); i++) {
+		Bone *bone = skeleton->getBones()[i], *bakedBone = bakedSkeleton->getBones()[i];
+		assert(MathUtil::abs(bone->getRotation() - bakedBone->getRotation()) < 0.01f);
+		assert(MathUtil::abs(bone->getX() - bakedBone->getX()) < 0.01f);
+		assert(MathUtil::abs(bone->getY() - bakedBone->getY()) < 0.01f);
+	}
+
+	dispose(atlas, skeletonData, stateData, skeleton, state);
+	dispose(bakedAtlas, bakedData, bakedStateData, bakedSkeleton, bakedState);
+}
+
+void testCompression() {
+	Atlas *atlas = NULL, *compressedAtlas = NULL;
+	SkeletonData *skeletonData = NULL, *compressedData = NULL;
+	AnimationStateData *stateData = NULL, *compressedStateData = NULL;
+	Skeleton *skeleton = NULL, *compressedSkeleton = NULL;
+	AnimationState *state = NULL, *compressedState = NULL;
+	loadBinary("testdata/spineboy/spineboy-pro.skel", "testdata/spineboy/spineboy.atlas", atlas, skeletonData, stateData, skeleton, state);
+	loadBinary("testdata/spineboy/spineboy-pro.skel", "testdata/spineboy/spineboy.atlas", compressedAtlas, compressedData, compressedStateData, compressedSkeleton, compressedState);
+
+	const float angleTolerance = 0.05f, translateTolerance = 0.05f, scaleTolerance = 0.001f;
+	size_t before = 0, after = 0;
+	for (size_t i = 0; i < compressedData->getAnimations().size(); i++) {
+		Animation *animation = compressedData->getAnimations()[i];
+		before += animation->getMemoryUsage();
+		animation->compress(angleTolerance, translateTolerance, scaleTolerance);
+		after += animation->getMemoryUsage();
+	}
+	// Most of the memory is bezier curves, which quantizing halves.
+	assert(after < before * 0.7f);
+
+	float maxBoneError = 0, maxDeformError = 0, maxAngleError = 0, maxTranslateError = 0, maxScaleError = 0;
+	for (size_t i = 0; i < skeletonData->getAnimations().size(); i++) {
+		Animation *animation = skeletonData->getAnimations()[i];
+		skeleton->setToSetupPose();
+		compressedSkeleton->setToSetupPose();
+		state->setAnimation(0, animation->getName(), false);
+		compressedState->setAnimation(0, animation->getName(), false);
+		for (float time = 0; time < animation->getDuration(); time += 1 / 60.0f) {
+			state->update(1 / 60.0f);
+			state->apply(*skeleton);
+			skeleton->updateWorldTransform();
+			compressedState->update(1 / 60.0f);
+			compressedState->apply(*compressedSkeleton);
+			compressedSkeleton->updateWorldTransform();
+			for (size_t ii = 0; ii < skeleton->getBones().size(); ii++) {
+				Bone *bone = skeleton->getBones()[ii], *compressedBone = compressedSkeleton->getBones()[ii];
+				maxBoneError = MathUtil::max(maxBoneError, MathUtil::abs(bone->getWorldX() - compressedBone->getWorldX()));
+				maxBoneError = MathUtil::max(maxBoneError, MathUtil::abs(bone->getWorldY() - compressedBone->getWorldY()));
+				maxAngleError = MathUtil::max(maxAngleError, MathUtil::abs(bone->getRotation() - compressedBone->getRotation()));
+				maxAngleError = MathUtil::max(maxAngleError, MathUtil::abs(bone->getShearX() - compressedBone->getShearX()));
+				maxAngleError = MathUtil::max(maxAngleError, MathUtil::abs(bone->getShearY() - compressedBone->getShearY()));
+				maxTranslateError = MathUtil::max(maxTranslateError, MathUtil::abs(bone->getX() - compressedBone->getX()));
+				maxTranslateError = MathUtil::max(maxTranslateError, MathUtil::abs(bone->getY() - compressedBone->getY()));
+				maxScaleError = MathUtil::max(maxScaleError, MathUtil::abs(bone->getScaleX() - compressedBone->getScaleX()));
+				maxScaleError = MathUtil::max(maxScaleError, MathUtil::abs(bone->getScaleY() - compressedBone->getScaleY()));
+			}
+			for (size_t ii = 0; ii < skeleton->getSlots().size(); ii++) {
+				Vector<float> &deform = skeleton->getSlots()[ii]->getDeform();
+				Vector<float> &compressedDeform = compressedSkeleton->getSlots()[ii]->getDeform();
+				assert(deform.size() == compressedDeform.size());
+				for (size_t iii = 0; iii < deform.size(); iii++)
+					maxDeformError = MathUtil::max(maxDeformError, MathUtil::abs(deform[iii] - compressedDeform[iii]));
+			}
+		}
+	}
+	// Reducing keeps each local value within its tolerance, quantizing adds much less error than that.
+	assert(maxAngleError <= angleTolerance && maxTranslateError <= translateTolerance && maxScaleError <= scaleTolerance);
+	assert(maxBoneError < 1);
+	assert(maxDeformError < 0.02f);
+	printf("Compression: %d -> %d bytes, max bone error %f, max deform error %f\n", (int) before, (int) after, maxBoneError, maxDeformError);
+	printf("Compression: max angle error %f, translate error %f, scale error %f\n", maxAngleError, maxTranslateError, maxScaleError);
+
+	dispose(atlas, skeletonData, stateData, skeleton, state);
+	dispose(compressedAtlas, compressedData, compressedStateData, compressedSkeleton, compressedState);
+}
+
+void testSparseDeform() {
+	Atlas *atlas = NULL;
+	SkeletonData *skeletonData = NULL;
+	AnimationStateData *stateData = NULL;
+	Skeleton *skeleton = NULL;
+	AnimationState *state = NULL;
+	loadBinary("testdata/goblins/goblins-pro.skel", "testdata/goblins/goblins.atlas", atlas, skeletonData, stateData, skeleton, state);
+	skeleton->setSkin("goblin");
+	skeleton->setSlotsToSetupPose();
+
+	int deformed = 0, sparse = 0;
+	Vector<float> worldVertices, fullWorldVertices;
+	state->setAnimation(0, "walk", true);
+	for (int frame = 0; frame < 120; frame++) {
+		state->update(1 / 60.0f);
+		state->apply(*skeleton);
+		skeleton->updateWorldTransform();
+		for (size_t i = 0; i < skeleton->getSlots().size(); i++) {
+			Slot *slot = skeleton->getSlots()[i];
+			// Reading the deform values keeps the deform range.
+			int start = slot->getDeformStart(), end = slot->getDeformEnd();
+			Vector<float> &deform = slot->getDeform();
+			assert(slot->getDeformStart() == start && slot->getDeformEnd() == end);
+			if (deform.size() == 0 || !slot->getAttachment()->getRTTI().instanceOf(VertexAttachment::rtti)) continue;
+			VertexAttachment *attachment = static_cast<VertexAttachment *>(slot->getAttachment());
+			deformed++;
+
+			// Values outside the deform range match the setup pose.
+			if (end - start < (int) deform.size()) sparse++;
+			for (int ii = 0; ii < (int) deform.size(); ii++) {
+				if (ii >= start && ii < end) continue;
+				assert(deform[ii] == (attachment->getBones().size() > 0 ? 0 : attachment->getVertices()[ii]));
+			}
+
+			worldVertices.setSize(attachment->getWorldVerticesLength(), 0);
+			fullWorldVertices.setSize(attachment->getWorldVerticesLength(), 0);
+			attachment->computeWorldVertices(*slot, worldVertices);
+			slot->setDeformRange(0, (int) deform.size());
+			attachment->computeWorldVertices(*slot, fullWorldVertices);
+			slot->setDeformRange(start, end);
+			for (size_t ii = 0; ii < worldVertices.size(); ii++)
+				assert(worldVertices[ii] == fullWorldVertices[ii]);
+
+			// Values written through getDeformForWrite() are used even outside the previous range.
+			if (start > 0) {
+				float value = deform[0];
+				slot->getDeformForWrite()[0] = value + 1;
+				assert(slot->getDeformStart() == 0 && slot->getDeformEnd() >= (int) deform.size());
+				attachment->computeWorldVertices(*slot, fullWorldVertices);
+				assert(fullWorldVertices[0] != worldVertices[0]);
+				deform[0] = value;
+			}
+			slot->setDeformRange(start, end);
+		}
+	}
+	assert(deformed > 0);
+	printf("Sparse deform: %d of %d deformed slots used a partial range\n", sparse, deformed);
+
+	dispose(atlas, skeletonData, stateData, skeleton, state);
+}
+
+void testSkinCache() {
+	Atlas *atlas = NULL;
+	SkeletonData *skeletonData = NULL;
+	AnimationStateData *stateData = NULL;
+	Skeleton *skeleton = NULL;
+	AnimationState *state = NULL;
+	loadBinary("testdata/mix-and-match/mix-and-match-pro.skel", "testdata/mix-and-match/mix-and-match.atlas", atlas, skeletonData, stateData, skeleton, state);
+	Skeleton *cachedSkeleton = new (__FILE__, __LINE__) Skeleton(skeletonData);
+	Skeleton *otherSkeleton = new (__FILE__, __LINE__) Skeleton(skeletonData);
+
+	const char *names[] = {"skin-base", "nose/short", "eyelids/girly", "eyes/violet", "hair/brown", "clothes/hoodie-orange",
+						   "legs/pants-jeans", "accessories/bag", "accessories/hat-red-yellow"};
+	Vector<Skin *> skins;
+	for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++)
+		skins.add(skeletonData->findSkin(names[i]));
+
+	// Compose the skin by hand for comparison.
+	Skin custom("custom");
+	for (size_t i = 0; i < skins.size(); i++)
+		custom.addSkin(skins[i]);
+	skeleton->setSkin(&custom);
+	skeleton->setSlotsToSetupPose();
+
+	SkinCache cache;
+	cache.setSkin(*cachedSkeleton, skins);
+	cache.setSkin(*otherSkeleton, skins);
+	assert(cache.size() == 1);
+	assert(cachedSkeleton->getSkin() == otherSkeleton->getSkin());
+	assert(cache.getSkin(skins) == cachedSkeleton->getSkin());
+	cachedSkeleton->setSlotsToSetupPose();
+	otherSkeleton->setSlotsToSetupPose();
+
+	// The restored update cache matches the sorted one.
+	Vector<Updatable *> &updateCache = skeleton->getUpdateCacheList();
+	assert(updateCache.size() == otherSkeleton->getUpdateCacheList().size());
+	for (size_t i = 0; i < updateCache.size(); i++) {
+		Updatable *updatable = updateCache[i], *other = otherSkeleton->getUpdateCacheList()[i];
+		assert(&updatable->getRTTI() == &other->getRTTI());
+		if (updatable->getRTTI().isExactly(Bone::rtti))
+			assert(&static_cast<Bone *>(updatable)->getData() == &static_cast<Bone *>(other)->getData());
+	}
+	for (size_t i = 0; i < skeleton->getSlots().size(); i++) {
+		Attachment *attachment = skeleton->getSlots()[i]->getAttachment();
+		Attachment *otherAttachment = otherSkeleton->getSlots()[i]->getAttachment();
+		assert(attachment == otherAttachment);
+	}
+
+	// A different combination composes a new skin.
+	skins.removeAt(skins.size() - 1);
+	cache.setSkin(*otherSkeleton, skins);
+	assert(cache.size() == 2);
+	assert(otherSkeleton->getSkin() != cachedSkeleton->getSkin());
+
+	// Composed skins are found again after the cache grows, and the order of the source skins matters.
+	Vector<Skin *> pair;
+	pair.setSize(2, NULL);
+	Vector<Skin *> composed;
+	for (size_t i = 0; i < skins.size(); i++) {
+		for (size_t ii = 0; ii < skins.size(); ii++) {
+			pair[0] = skins[i];
+			pair[1] = skins[ii];
+			composed.add(cache.getSkin(pair));
+		}
+	}
+	assert(cache.size() == 2 + skins.size() * skins.size());
+	for (size_t i = 0, n = 0; i < skins.size(); i++) {
+		for (size_t ii = 0; ii < skins.size(); ii++, n++) {
+			pair[0] = skins[i];
+			pair[1] = skins[ii];
+			assert(cache.getSkin(pair) == composed[n]);
+			if (i != ii) assert(composed[n] != composed[ii * skins.size() + i]);
+		}
+	}
+	assert(cache.getSkin(skins) == otherSkeleton->getSkin());
+	printf("Skin cache: %d skins, %d updatables\n", (int) cache.size(), (int) updateCache.size());
+
+	delete cachedSkeleton;
+	delete otherSkeleton;
+	dispose(atlas, skeletonData, stateData, skeleton, state);
+}
+
+class PixelTextureLoader : public TextureLoader {
+public:
+	// Generates pixels encoding their position instead of decoding the page image.
+	virtual void load(AtlasPage &page, const String &path) {
+		SP_UNUSED(path);
+		unsigned char *pixels = SpineExtension::alloc<unsigned char>(page.width * page.height * 4, __FILE__, __LINE__);
+		for (int y = 0; y < page.height; y++) {
+			for (int x = 0; x < page.width; x++) {
+				unsigned char *pixel = pixels + (y * page.width + x) * 4;
+				pixel[0] = (unsigned char) x;
+				pixel[1] = (unsigned char) y;
+				pixel[2] = (unsigned char) ((x >> 8) | ((y >> 8) << 4));
+				pixel[3] = 255;
+			}
+		}
+		page.texture = pixels;
+	}
+
+	virtual void unload(void *texture) {
+		SpineExtension::free(texture, __FILE__, __LINE__);
+	}
+
+	virtual const unsigned char *getPixels(AtlasPage &page) {
+		return (const unsigned char *) page.texture;
+	}
+};
+
+void testAtlasRepacker() {
+	PixelTextureLoader textureLoader;
+	Atlas *atlas = new (__FILE__, __LINE__) Atlas("testdata/mix-and-match/mix-and-match.atlas", &textureLoader);
+	SkeletonBinary binary(atlas);
+	SkeletonData *skeletonData = binary.readSkeletonDataFile("testdata/mix-and-match/mix-and-match-pro.skel");
+	assert(skeletonData);
+
+	Skin custom("custom");
+	custom.addSkin(skeletonData->findSkin("skin-base"));
+	custom.addSkin(skeletonData->findSkin("hair/brown"));
+	custom.addSkin(skeletonData->findSkin("clothes/hoodie-orange"));
+	custom.addSkin(skeletonData->findSkin("legs/pants-jeans"));
+
+	AtlasRepacker repacker;
+	assert(repacker.repack(custom, textureLoader, "custom"));
+	AtlasPage *page = repacker.getPage();
+	Vector<AtlasRegion *> &regions = repacker.getRegions();
+	assert(regions.size() > 0 && regions.size() < atlas->getRegions().size());
+
+	// The packed pixels match the source regions.
+	for (size_t i = 0; i < regions.size(); i++) {
+		AtlasRegion *region = regions[i], *source = atlas->findRegion(region->name);
+		assert(source && region->page == page);
+		int width = region->degrees == 90 ? region->height : region->width;
+		int height = region->degrees == 90 ? region->width : region->height;
+		const unsigned char *sourcePixels = textureLoader.getPixels(*source->page);
+		for (int y = 0; y < height; y++) {
+			const unsigned char *from = sourcePixels + ((source->y + y) * source->page->width + source->x) * 4;
+			const unsigned char *to = repacker.getPixels().buffer() + ((region->y + y) * page->width + region->x) * 4;
+			assert(memcmp(from, to, width * 4) == 0);
+		}
+	}
+
+	// The repacked skin's attachments use the new page.
+	Skin::AttachmentMap::Entries entries = repacker.getSkin()->getAttachments();
+	int attachments = 0;
+	while (entries.hasNext()) {
+		Attachment *attachment = entries.next()._attachment;
+		TextureRegion *region = NULL;
+		if (attachment->getRTTI().isExactly(RegionAttachment::rtti))
+			region = static_cast<RegionAttachment *>(attachment)->getRegion();
+		else if (attachment->getRTTI().isExactly(MeshAttachment::rtti))
+			region = static_cast<MeshAttachment *>(attachment)->getRegion();
+		if (!region) continue;
+		assert(static_cast<AtlasRegion *>(region)->page == page);
+		attachments++;
+	}
+	printf("Atlas repacker: %d regions, %d attachments on a %dx%d page\n", (int) regions.size(), attachments, page->width,
+		   page->height);
+
+	Skeleton skeleton(skeletonData);
+	skeleton.setSkin(repacker.getSkin());
+	skeleton.setSlotsToSetupPose();
+	skeleton.updateWorldTransform();
+
+	delete skeletonData;
+	delete atlas;
+}
+
+void testBinaryAtlas() {
+	Atlas *atlas = new (__FILE__, __LINE__) Atlas("testdata/mix-and-match/mix-and-match.atlas", NULL);
+	Vector<char> data;
+	atlas->writeBinary(data);
+	assert(Atlas::isBinary(data.buffer(), (int) data.size()));
+	Atlas *binaryAtlas = new (__FILE__, __LINE__) Atlas(data.buffer(), (int) data.size(), "testdata/mix-and-match", NULL);
+
+	assert(binaryAtlas->getPages().size() == atlas->getPages().size());
+	for (size_t i = 0; i < atlas->getPages().size(); i++) {
+		AtlasPage *page = atlas->getPages()[i], *binaryPage = binaryAtlas->getPages()[i];
+		assert(page->name == binaryPage->name && page->width == binaryPage->width && page->height == binaryPage->height);
+		assert(page->format == binaryPage->format && page->minFilter == binaryPage->minFilter && page->pma == binaryPage->pma);
+	}
+	Vector<AtlasRegion *> &regions = atlas->getRegions();
+	assert(binaryAtlas->getRegions().size() == regions.size());
+	for (size_t i = 0; i < regions.size(); i++) {
+		AtlasRegion *region = regions[i], *binaryRegion = binaryAtlas->findRegion(region->name);
+		assert(binaryRegion == binaryAtlas->getRegions()[i] && atlas->findRegion(region->name) == region);
+		assert(binaryRegion->page->index == region->page->index && binaryRegion->index == region->index);
+		assert(binaryRegion->x == region->x && binaryRegion->y == region->y && binaryRegion->degrees == region->degrees);
+		assert(binaryRegion->width == region->width && binaryRegion->height == region->height);
+		assert(binaryRegion->originalWidth == region->originalWidth && binaryRegion->offsetX == region->offsetX);
+		assert(binaryRegion->u == region->u && binaryRegion->v2 == region->v2);
+	}
+	assert(binaryAtlas->findRegion("missing") == NULL);
+
+	// Names keep their own value counts.
+	const char *text = "custom.png\nsize: 64, 64\nfilter: Linear, Linear\nregion\nbounds: 0, 0, 8, 8\none: 1, 2, 3\ntwo: 4\nthree: 5, 6\n";
+	Atlas textAtlas(text, (int) strlen(text), "", NULL);
+	Vector<char> customData;
+	textAtlas.writeBinary(customData);
+	Atlas customAtlas(customData.buffer(), (int) customData.size(), "", NULL);
+	AtlasRegion *textRegion = textAtlas.findRegion("region"), *customRegion = customAtlas.findRegion("region");
+	assert(textRegion && customRegion && customRegion->names.size() == 3);
+	for (size_t i = 0; i < textRegion->names.size(); i++) {
+		assert(customRegion->names[i] == textRegion->names[i]);
+		assert(customRegion->valueCounts[i] == textRegion->valueCounts[i]);
+	}
+	assert(customRegion->valueCounts[0] == 3 && customRegion->valueCounts[1] == 1 && customRegion->valueCounts[2] == 2);
+	assert(customRegion->values.size() == 6);
+	for (size_t i = 0; i < customRegion->values.size(); i++)
+		assert(customRegion->values[i] == (float) (i + 1));
+	// Regions own their names, like those of text atlases.
+	customRegion->name = "renamed";
+
+	SkeletonBinary binary(binaryAtlas);
+	SkeletonData *skeletonData = binary.readSkeletonDataFile("testdata/mix-and-match/mix-and-match-pro.skel");
+	assert(skeletonData);
+	printf("Binary atlas: %d regions in %d bytes\n", (int) regions.size(), (int) data.size());
+
+	delete skeletonData;
+	delete binaryAtlas;
+	delete atlas;
+}
+
+void testLazyAnimations() {
+	const char *files[][2] = {{"testdata/spineboy/spineboy-pro.skel", "testdata/spineboy/spineboy.atlas"},
+							  {"testdata/goblins/goblins-pro.skel", "testdata/goblins/goblins.atlas"},
+							  {"testdata/raptor/raptor-pro.skel", "testdata/raptor/raptor.atlas"},
+							  {"testdata/stretchyman/stretchyman-pro.skel", "testdata/stretchyman/stretchyman.atlas"},
+							  {"testdata/tank/tank-pro.skel", "testdata/tank/tank.atlas"},
+							  {"testdata/coin/coin-pro.skel", "testdata/coin/coin.atlas"},
+							  {"testdata/mix-and-match/mix-and-match-pro.skel", "testdata/mix-and-match/mix-and-match.atlas"}};
+	int decodedCount = 0, animationCount = 0;
+	for (int i = 0; i < 7; i++) {
+		Atlas *atlas = new (__FILE__, __LINE__) Atlas(files[i][1], NULL);
+		SkeletonBinary binary(atlas);
+		SkeletonData *skeletonData = binary.readSkeletonDataFile(files[i][0]);
+		binary.setLazyAnimations(true);
+		SkeletonData *lazyData = binary.readSkeletonDataFile(files[i][0]);
+		assert(skeletonData && lazyData);
+
+		// Durations are known before decoding, timelines match after.
+		Vector<Animation *> &animations = skeletonData->getAnimations(), &lazyAnimations = lazyData->getAnimations();
+		assert(animations.size() == lazyAnimations.size());
+		for (size_t ii = 0; ii < animations.size(); ii++) {
+			assert(!lazyData->isAnimationDecoded(lazyAnimations[ii]));
+			assert(lazyAnimations[ii]->getTimelines().size() == 0);
+			assert(lazyAnimations[ii]->getDuration() == animations[ii]->getDuration());
+			assert(lazyData->findAnimation(animations[ii]->getName()) == lazyAnimations[ii]);
+			assert(lazyData->isAnimationDecoded(lazyAnimations[ii]));
+			assert(lazyAnimations[ii]->getTimelines().size() == animations[ii]->getTimelines().size());
+			decodedCount++;
+		}
+		animationCount += (int) animations.size();
+		lazyData->evictAnimations();
+		for (size_t ii = 0; ii < animations.size(); ii++)
+			assert(lazyAnimations[ii]->getTimelines().size() == 0);
+		lazyData->decodeAnimations();
+
+		// A decoded animation poses the skeleton like the eagerly read one.
+		Skeleton skeleton(skeletonData), lazySkeleton(lazyData);
+		for (size_t ii = 0; ii < animations.size(); ii++) {
+			skeleton.setToSetupPose();
+			lazySkeleton.setToSetupPose();
+			float time = animations[ii]->getDuration() * 0.5f;
+			animations[ii]->apply(skeleton, 0, time, false, NULL, 1, MixBlend_Setup, MixDirection_In);
+			lazyAnimations[ii]->apply(lazySkeleton, 0, time, false, NULL, 1, MixBlend_Setup, MixDirection_In);
+			skeleton.updateWorldTransform();
+			lazySkeleton.updateWorldTransform();
+			for (size_t iii = 0; iii < skeleton.getBones().size(); iii++) {
+				assert(skeleton.getBones()[iii]->getWorldX() == lazySkeleton.getBones()[iii]->getWorldX());
+				assert(skeleton.getBones()[iii]->getWorldY() == lazySkeleton.getBones()[iii]->getWorldY());
+			}
+		}
+
+		delete lazyData;
+		delete skeletonData;
+		delete atlas;
+	}
+	printf("Lazy animations: %d of %d animations decoded on demand\n", decodedCount, animationCount);
+}
+
+#ifdef SPINE_BULK_LOADER
+class MainThreadTextureLoader : public TextureLoader {
+public:
+	MainThreadTextureLoader() : _thread(std::this_thread::get_id()), _loaded(0) {
+	}
+
+	virtual void load(AtlasPage &page, const String &path) {
+		SP_UNUSED(path);
+		assert(std::this_thread::get_id() == _thread);
+		page.texture = &page;
+		_loaded++;
+	}
+
+	virtual void unload(void *texture) {
+		SP_UNUSED(texture);
+		assert(std::this_thread::get_id() == _thread);
+	}
+
+	std::thread::id _thread;
+	int _loaded;
+};
+
+void testBulkLoader() {
+	const char *files[][2] = {{"testdata/spineboy/spineboy-pro.skel", "testdata/spineboy/spineboy.atlas"},
+							  {"testdata/goblins/goblins-pro.json", "testdata/goblins/goblins.atlas"},
+							  {"testdata/raptor/raptor-pro.skel", "testdata/raptor/raptor.atlas"},
+							  {"testdata/stretchyman/stretchyman-pro.json", "testdata/stretchyman/stretchyman.atlas"},
+							  {"testdata/tank/tank-pro.skel", "testdata/tank/tank.atlas"},
+							  {"testdata/coin/coin-pro.json", "testdata/coin/coin.atlas"},
+							  {"testdata/mix-and-match/mix-and-match-pro.skel", "testdata/mix-and-match/mix-and-match.atlas"},
+							  {"testdata/coin/missing.skel", "testdata/coin/coin.atlas"},
+							  {"testdata/coin/coin-pro.skel", "testdata/coin/missing.atlas"}};
+	const int pairs = 9, repeats = 4;
+	MainThreadTextureLoader textureLoader;
+	int loaded = 0, failed = 0;
+	{
+		BulkLoader loader(&textureLoader, 4);
+		for (int i = 0; i < pairs * repeats; i++)
+			assert(loader.add(files[i % pairs][0], files[i % pairs][1]) == i);
+		loader.wait();
+		assert(loader.getPendingCount() == 0);
+
+		BulkLoadResult result;
+		while (loader.poll(result)) {
+			bool missing = result.index % pairs >= 7;
+			if (missing) {
+				assert(!result.atlas && !result.skeletonData && !result.error.isEmpty());
+				failed++;
+				continue;
+			}
+			assert(result.error.isEmpty() && result.atlas && result.skeletonData);
+			assert(result.atlas->getPages()[0]->texture == result.atlas->getPages()[0]);
+			assert(result.skeletonData->getBones().size() > 0);
+			delete result.skeletonData;
+			delete result.atlas;
+			loaded++;
+		}
+
+		// Results not polled are disposed by the loader.
+		loader.add(files[0][0], files[0][1]);
+	}
+	assert(loaded == 7 * repeats && failed == 2 * repeats);
+	printf("Bulk loader: %d pairs loaded, %d failed, %d textures created on the main thread\n", loaded, failed,
+		   textureLoader._loaded);
+}
+#endif
+
 namespace spine {
 	SpineExtension *getDefaultExtension() {
 		return new DefaultSpineExtension();
 	}
 }// namespace spine
 
+void assertSameWorldTransforms(Skeleton &skeleton, Skeleton &other) {
+	for (size_t i = 0; i < skeleton.getBones().size(); i++) {
+		Bone *bone = skeleton.getBones()[i], *otherBone = other.getBones()[i];
+		assert(bone->getA() == otherBone->getA() && bone->getB() == otherBone->getB());
+		assert(bone->getC() == otherBone->getC() && bone->getD() == otherBone->getD());
+		assert(bone->getWorldX() == otherBone->getWorldX() && bone->getWorldY() == otherBone->getWorldY());
+	}
+}
+
+void testIncremental() {
+	const char *files[][2] = {{"testdata/spineboy/spineboy-pro.skel", "testdata/spineboy/spineboy.atlas"},
+							  {"testdata/raptor/raptor-pro.skel", "testdata/raptor/raptor.atlas"},
+							  {"testdata/stretchyman/stretchyman-pro.skel", "testdata/stretchyman/stretchyman.atlas"},
+							  {"testdata/tank/tank-pro.skel", "testdata/tank/tank.atlas"}};
+	int updated = 0, total = 0;
+	for (int i = 0; i < 4; i++) {
+		Atlas *atlas = new (__FILE__, __LINE__) Atlas(files[i][1], NULL);
+		SkeletonBinary binary(atlas);
+		SkeletonData *skeletonData = binary.readSkeletonDataFile(files[i][0]);
+		assert(skeletonData);
+
+		// Every animation, including IK, transform and path constraints, poses both skeletons identically.
+		Skeleton skeleton(skeletonData), incremental(skeletonData);
+		incremental.setIncremental(true);
+		Vector<Animation *> &animations = skeletonData->getAnimations();
+		for (size_t ii = 0; ii < animations.size(); ii++) {
+			skeleton.setToSetupPose();
+			incremental.setToSetupPose();
+			for (int frame = 0; frame <= 60; frame++) {
+				float time = animations[ii]->getDuration() * (frame / 60.0f);
+				animations[ii]->apply(skeleton, 0, time, false, NULL, 1, MixBlend_Setup, MixDirection_In);
+				animations[ii]->apply(incremental, 0, time, false, NULL, 1, MixBlend_Setup, MixDirection_In);
+				skeleton.updateWorldTransform();
+				incremental.updateWorldTransform();
+				assertSameWorldTransforms(skeleton, incremental);
+				updated += incremental.getUpdatedBoneCount();
+				total += skeleton.getUpdatedBoneCount();
+			}
+		}
+
+		// A static pose computes only the bones written by constraints.
+		incremental.updateWorldTransform();
+		int constrained = incremental.getUpdatedBoneCount();
+		incremental.updateWorldTransform();
+		assert(incremental.getUpdatedBoneCount() <= constrained);
+		assert(incremental.getUpdatedBoneCount() < (int) skeleton.getUpdateCacheList().size());
+
+		// Moving the skeleton or changing a bone recomputes what depends on it.
+		incremental.setX(10);
+		skeleton.setX(10);
+		skeleton.updateWorldTransform();
+		incremental.updateWorldTransform();
+		assert(incremental.getUpdatedBoneCount() == skeleton.getUpdatedBoneCount());
+		assertSameWorldTransforms(skeleton, incremental);
+		Bone *bone = skeleton.getBones()[1], *incrementalBone = incremental.getBones()[1];
+		bone->setRotation(bone->getRotation() + 10);
+		incrementalBone->setRotation(incrementalBone->getRotation() + 10);
+		skeleton.updateWorldTransform();
+		incremental.updateWorldTransform();
+		assertSameWorldTransforms(skeleton, incremental);
+		incrementalBone->setWorldX(1000);
+		incremental.updateWorldTransform();
+		assertSameWorldTransforms(skeleton, incremental);
+
+		delete skeletonData;
+		delete atlas;
+	}
+	printf("Incremental: %d of %d bone updates computed\n", updated, total);
+}
+
+void testFastTrig() {
+	float sinError = 0, atan2Error = 0;
+	for (float degrees = -10000; degrees <= 10000; degrees += 0.37f) {
+		double radians = degrees * 3.14159265358979323846 / 180;
+		MathUtil::setFastTrig(true);
+		float fastSin = MathUtil::sinDeg(degrees), fastCos = MathUtil::cosDeg(degrees);
+		float fastRadians = MathUtil::sin((float) radians);
+		MathUtil::setFastTrig(false);
+		sinError = MathUtil::max(sinError, (float) fabs(fastSin - sin(radians)));
+		sinError = MathUtil::max(sinError, (float) fabs(fastCos - cos(radians)));
+		sinError = MathUtil::max(sinError, (float) fabs(fastRadians - sin(radians)));
+	}
+	for (float y = -2; y <= 2; y += 0.01f) {
+		for (float x = -2; x <= 2; x += 0.01f) {
+			MathUtil::setFastTrig(true);
+			float fastAtan2 = MathUtil::atan2(y, x);
+			MathUtil::setFastTrig(false);
+			atan2Error = MathUtil::max(atan2Error, (float) fabs(fastAtan2 - atan2(y, x)));
+		}
+	}
+	assert(sinError < 0.0002f);
+	assert(atan2Error < 0.00002f);
+
+	// Posing with fast trigonometry stays close, and switching back restores the exact pose.
+	Atlas *atlas = NULL;
+	SkeletonData *skeletonData = NULL;
+	AnimationStateData *stateData = NULL;
+	Skeleton *skeleton = NULL;
+	AnimationState *state = NULL;
+	loadBinary("testdata/stretchyman/stretchyman-pro.skel", "testdata/stretchyman/stretchyman.atlas", atlas, skeletonData, stateData, skeleton, state);
+	Skeleton exact(skeletonData);
+	Animation *animation = skeletonData->getAnimations()[0];
+	animation->apply(*skeleton, 0, 0.5f, false, NULL, 1, MixBlend_Setup, MixDirection_In);
+	animation->apply(exact, 0, 0.5f, false, NULL, 1, MixBlend_Setup, MixDirection_In);
+	exact.updateWorldTransform();
+	MathUtil::setFastTrig(true);
+	skeleton->updateWorldTransform();
+	MathUtil::setFastTrig(false);
+	float poseError = 0;
+	for (size_t i = 0; i < exact.getBones().size(); i++)
+		poseError = MathUtil::max(poseError, MathUtil::abs(exact.getBones()[i]->getWorldX() - skeleton->getBones()[i]->getWorldX()));
+	assert(poseError < 1);
+	skeleton->updateWorldTransform();
+	assertSameWorldTransforms(exact, *skeleton);
+	printf("Fast trig: sin error %f, atan2 error %f, pose error %f\n", sinError, atan2Error, poseError);
+
+	dispose(atlas, skeletonData, stateData, skeleton, state);
+}
+
+void simulate(AnimationState *state, Skeleton *skeleton, int frames, Vector<float> &pose) {
+	for (int frame = 0; frame < frames; frame++) {
+		state->update(1 / 60.0f);
+		state->apply(*skeleton);
+		skeleton->updateWorldTransform();
+		for (size_t i = 0; i < skeleton->getBones().size(); i++) {
+			pose.add(skeleton->getBones()[i]->getWorldX());
+			pose.add(skeleton->getBones()[i]->getWorldY());
+		}
+		for (size_t i = 0; i < skeleton->getSlots().size(); i++) {
+			pose.add((float) (size_t) skeleton->getSlots()[i]->getAttachment());
+			pose.add((float) skeleton->getDrawOrder()[i]->getData().getIndex());
+		}
+	}
+}
+
+void testSnapshot() {
+	Atlas *atlas = NULL;
+	SkeletonData *skeletonData = NULL;
+	AnimationStateData *stateData = NULL;
+	Skeleton *skeleton = NULL;
+	AnimationState *state = NULL;
+	loadBinary("testdata/spineboy/spineboy-pro.skel", "testdata/spineboy/spineboy.atlas", atlas, skeletonData, stateData, skeleton, state);
+	stateData->setDefaultMix(0.2f);
+	Vector<RecordedEvent> events, replayedEvents;
+	state->setListener(recordEvent);
+	state->setAnimation(0, "walk", true);
+	state->addAnimation(0, "run", true, 0.5f);
+	state->addAnimation(0, "jump", false, 0.3f);
+	state->addAnimation(0, "run", true, 0);
+	state->setAnimation(1, "aim", true)->setAlpha(0.5f);
+	Vector<float> pose, replayedPose;
+	simulate(state, skeleton, 40, pose);
+
+	// Resimulating from a restored snapshot reproduces the pose and events, across mixes and queued entries.
+	SkeletonSnapshot snapshot;
+	snapshot.save(*skeleton, state);
+	pose.clear();
+	recordedEvents = &events;
+	simulate(state, skeleton, 60, pose);
+	for (int i = 0; i < 3; i++) {
+		assert(snapshot.restore(*skeleton, state));
+		replayedPose.clear();
+		replayedEvents.clear();
+		recordedEvents = &replayedEvents;
+		simulate(state, skeleton, 60, replayedPose);
+		assert(pose == replayedPose);
+		assert(events == replayedEvents);
+	}
+	assert(events.size() > 0);
+
+	// A copy of the buffer restores another skeleton using the same data.
+	Skeleton other(skeletonData);
+	AnimationState otherState(stateData);
+	otherState.setListener(recordEvent);
+	otherState.setAnimation(0, "idle", true);
+	SkeletonSnapshot copy;
+	copy.setData(snapshot.getData(), snapshot.getSize());
+	assert(!copy.restore(other, NULL));
+	assert(copy.restore(other, &otherState));
+	replayedPose.clear();
+	replayedEvents.clear();
+	simulate(&otherState, &other, 60, replayedPose);
+	assert(pose == replayedPose);
+	assert(events == replayedEvents);
+	recordedEvents = NULL;
+
+	// Snapshots of other skeleton data are rejected.
+	Atlas *raptorAtlas = NULL;
+	SkeletonData *raptorData = NULL;
+	AnimationStateData *raptorStateData = NULL;
+	Skeleton *raptor = NULL;
+	AnimationState *raptorState = NULL;
+	loadBinary("testdata/raptor/raptor-pro.skel", "testdata/raptor/raptor.atlas", raptorAtlas, raptorData, raptorStateData, raptor, raptorState);
+	assert(!snapshot.restore(*raptor, raptorState));
+	dispose(raptorAtlas, raptorData, raptorStateData, raptor, raptorState);
+
+	// Save and restore times are measured by spine_cpp_benchmarks, this build tracks every allocation.
+	printf("Snapshot: %d bytes\n", (int) snapshot.getSize());
+
+	dispose(atlas, skeletonData, stateData, skeleton, state);
+}
+
+void testProfiler() {
+	DebugExtension *debug = (DebugExtension *) SpineExtension::getInstance();
+	ChromeTraceProfiler profiler(debug);
+	SpineProfiler::setInstance(&profiler);
+	{
+		ProfilerZone zone("outer");
+		Vector<int> values;
+		values.add(1);
+		{
+			ProfilerZone inner("inner");
+		}
+		SpineProfiler::count("counter", 2);
+	}
+	assert(profiler.getEventCount() == 5);
+
+	Atlas *atlas = NULL;
+	SkeletonData *skeletonData = NULL;
+	AnimationStateData *stateData = NULL;
+	Skeleton *skeleton = NULL;
+	AnimationState *state = NULL;
+	loadBinary("testdata/spineboy/spineboy-pro.skel", "testdata/spineboy/spineboy.atlas", atlas, skeletonData, stateData, skeleton, state);
+	state->setAnimation(0, "walk", true);
+	state->update(0.1f);
+	state->apply(*skeleton);
+	skeleton->updateWorldTransform();
+	SpineProfiler::setInstance(NULL);
+
+	String json;
+	profiler.write(json);
+	const char *trace = json.buffer();
+	assert(strstr(trace, "{\"name\":\"inner\",\"ph\":\"E\""));
+	assert(strstr(trace, "{\"name\":\"outer\",\"ph\":\"E\""));
+	assert(strstr(trace, "\"args\":{\"allocations\":1}"));
+	assert(strstr(trace, "\"args\":{\"value\":2}"));
+#ifdef SPINE_PROFILER
+	assert(strstr(trace, "SkeletonBinary::readSkeletonData"));
+	assert(strstr(trace, "AnimationState::apply"));
+	assert(strstr(trace, "RotateTimeline"));
+	assert(strstr(trace, "IkConstraint::update"));
+	assert(strstr(trace, "Skeleton::updateWorldTransform"));
+#else
+	assert(profiler.getEventCount() == 5);
+#endif
+	printf("Profiler: %d events\n", (int) profiler.getEventCount());
+
+	dispose(atlas, skeletonData, stateData, skeleton, state);
+}
+
+void playTransitions(AnimationState *state, Skeleton *skeleton, Vector<float> &pose) {
+	const char *animations[] = {"walk", "run", "jump", "idle", "walk", "run"};
+	state->setAnimation(1, "aim", true)->setAlpha(0.5f);
+	for (int i = 0; i < 3; i++) {
+		for (int ii = 0; ii < 6; ii++) {
+			state->setAnimation(0, animations[ii], true)->setHoldPrevious(ii == 3);
+			simulate(state, skeleton, 4, pose);
+		}
+		state->setAnimation(2, "shoot", false)->setMixBlend(MixBlend_Add);
+		simulate(state, skeleton, 4, pose);
+	}
+}
+
+void testTimelineModeCache() {
+	Atlas *atlas = NULL;
+	SkeletonData *skeletonData = NULL;
+	AnimationStateData *stateData = NULL;
+	Skeleton *skeleton = NULL;
+	AnimationState *state = NULL;
+	loadBinary("testdata/spineboy/spineboy-pro.skel", "testdata/spineboy/spineboy.atlas", atlas, skeletonData, stateData, skeleton, state);
+	stateData->setDefaultMix(0.2f);
+	assert(!stateData->getTimelineModeCache());
+	stateData->setTimelineModeCache(true);
+	Vector<float> pose, uncachedPose;
+	playTransitions(state, skeleton, pose);
+	assert(stateData->getTimelineModeCacheHits() > 0);
+	assert(stateData->getTimelineModeCacheSize() == stateData->getTimelineModeCacheMisses());
+
+	// The cached modes produce the same poses as computing them, and are shared with other states using the data.
+	AnimationStateData uncachedData(skeletonData);
+	uncachedData.setDefaultMix(0.2f);
+	uncachedData.setTimelineModeCache(false);
+	Skeleton uncached(skeletonData);
+	AnimationState uncachedState(&uncachedData);
+	playTransitions(&uncachedState, &uncached, uncachedPose);
+	assert(pose == uncachedPose);
+	assert(uncachedData.getTimelineModeCacheHits() == 0 && uncachedData.getTimelineModeCacheSize() == 0);
+
+	size_t misses = stateData->getTimelineModeCacheMisses();
+	Skeleton other(skeletonData);
+	AnimationState otherState(stateData);
+	pose.clear();
+	playTransitions(&otherState, &other, pose);
+	assert(pose == uncachedPose);
+	assert(stateData->getTimelineModeCacheMisses() == misses);
+	printf("Timeline mode cache: %d hits, %d misses\n", (int) stateData->getTimelineModeCacheHits(), (int) misses);
+
+	stateData->clearTimelineModeCache();
+	assert(stateData->getTimelineModeCacheSize() == 0 && stateData->getTimelineModeCacheHits() == 0);
+
+	dispose(atlas, skeletonData, stateData, skeleton, state);
+}
+
+void playEvents(AnimationState *state, Skeleton *skeleton, int loops) {
+	Vector<float> pose;
+	for (int i = 0; i < loops; i++) {
+		state->setAnimation(0, "walk", true);
+		state->addAnimation(0, "run", true, 0.5f);
+		state->addAnimation(0, "jump", false, 0.3f);
+		state->addAnimation(0, "run", true, 0);
+		simulate(state, skeleton, 120, pose);
+		pose.clear();
+	}
+}
+
+void testEventBuffer() {
+	Atlas *atlas = NULL;
+	SkeletonData *skeletonData = NULL;
+	AnimationStateData *stateData = NULL;
+	Skeleton *skeleton = NULL;
+	AnimationState *state = NULL;
+	loadBinary("testdata/spineboy/spineboy-pro.skel", "testdata/spineboy/spineboy.atlas", atlas, skeletonData, stateData, skeleton, state);
+	stateData->setDefaultMix(0.2f);
+	Vector<RecordedEvent> events, bufferedEvents;
+	recordedEvents = &events;
+	state->setListener(recordEvent);
+	playEvents(state, skeleton, 1);
+	recordedEvents = NULL;
+
+	// The buffer receives the events the listeners would, with a dispose record after each end record.
+	Skeleton other(skeletonData);
+	AnimationState otherState(stateData);
+	EventBuffer buffer(1024);
+	otherState.setEventBuffer(&buffer);
+	playEvents(&otherState, &other, 1);
+	size_t recordCount = buffer.size();
+	EventRecord record;
+	int lastStartId = 0, footsteps = 0;
+	bool disposeExpected = false;
+	while (buffer.poll(record)) {
+		assert(record.state == &otherState && record.trackIndex == 0);
+		assert((record.type == EventType_Dispose) == disposeExpected);
+		disposeExpected = record.type == EventType_End;
+		if (record.type == EventType_Start) {
+			assert(record.entryId > lastStartId);
+			lastStartId = record.entryId;
+		}
+		if (record.type == EventType_Event) {
+			assert(record.data == &record.event->getData() && record.intValue == record.event->getIntValue());
+			assert(record.floatValue == record.event->getFloatValue() && record.volume == record.event->getVolume());
+			if (record.data->getName() == "footstep") footsteps++;
+		}
+		if (record.type != EventType_Dispose) bufferedEvents.add(RecordedEvent(record.type, NULL, record.event));
+	}
+	for (size_t i = 0; i < events.size(); i++)
+		events[i]._animation = NULL;
+	assert(events == bufferedEvents);
+	assert(footsteps > 0 && buffer.size() == 0 && buffer.getDroppedCount() == 0);
+
+	// A consumer thread reads the records while they are added, records which do not fit are dropped.
+	EventBuffer handoff(16);
+	otherState.setEventBuffer(&handoff);
+	std::atomic<bool> done(false);
+	size_t received = 0;
+	std::thread consumer([&]() {
+		EventRecord consumed;
+		while (true) {
+			bool finished = done.load();
+			while (handoff.poll(consumed))
+				received++;
+			if (finished) break;
+		}
+	});
+	playEvents(&otherState, &other, 10);
+	otherState.clearTracks();
+	done.store(true);
+	consumer.join();
+	assert(received > 0 && received + handoff.getDroppedCount() >= recordCount * 10);
+	printf("Event buffer: %d records per loop, %d received and %d dropped by the consumer thread\n", (int) recordCount,
+		   (int) received, (int) handoff.getDroppedCount());
+	otherState.setEventBuffer(NULL);
+
+	dispose(atlas, skeletonData, stateData, skeleton, state);
+}
+
+void testBatchedApply() {
+	Atlas *atlas = NULL;
+	SkeletonData *skeletonData = NULL;
+	AnimationStateData *stateData = NULL;
+	Skeleton *skeleton = NULL;
+	AnimationState *state = NULL;
+	loadBinary("testdata/raptor/raptor-pro.skel", "testdata/raptor/raptor.atlas", atlas, skeletonData, stateData, skeleton, state);
+	Animation *walk = skeletonData->findAnimation("walk");
+	Animation *roar = skeletonData->findAnimation("roar");
+
+	// Applying to many skeletons at once poses them exactly as applying to each skeleton.
+	const int count = 150;
+	Vector<Skeleton *> batched, single;
+	Vector<float> lastTimes, times;
+	Vector<Vector<Event *> *> batchedEvents;
+	Vector<Event *> singleEvents;
+	for (int i = 0; i < count; i++) {
+		batched.add(new (__FILE__, __LINE__) Skeleton(skeletonData));
+		single.add(new (__FILE__, __LINE__) Skeleton(skeletonData));
+		batchedEvents.add(new (__FILE__, __LINE__) Vector<Event *>());
+		times.add(i * 0.037f - 0.5f);
+		lastTimes.add(times[i] - 0.2f);
+	}
+	MixBlend blends[] = {MixBlend_Setup, MixBlend_First, MixBlend_Replace, MixBlend_Add};
+	for (int b = 0; b < 4; b++) {
+		roar->applyBatch(batched.buffer(), lastTimes.buffer(), times.buffer(), count, false, NULL, 1, MixBlend_Setup,
+						 MixDirection_In);
+		walk->applyBatch(batched.buffer(), lastTimes.buffer(), times.buffer(), count, true, batchedEvents.buffer(), 0.7f,
+						 blends[b], MixDirection_In);
+		for (int i = 0; i < count; i++) {
+			roar->apply(*single[i], lastTimes[i], times[i], false, NULL, 1, MixBlend_Setup, MixDirection_In);
+			singleEvents.clear();
+			walk->apply(*single[i], lastTimes[i], times[i], true, &singleEvents, 0.7f, blends[b], MixDirection_In);
+			assert(*batchedEvents[i] == singleEvents);
+			batchedEvents[i]->clear();
+			for (size_t ii = 0; ii < single[i]->getBones().size(); ii++) {
+				Bone *bone = batched[i]->getBones()[ii], *other = single[i]->getBones()[ii];
+				assert(bone->getX() == other->getX() && bone->getY() == other->getY());
+				assert(bone->getRotation() == other->getRotation());
+				assert(bone->getScaleX() == other->getScaleX() && bone->getScaleY() == other->getScaleY());
+			}
+			for (size_t ii = 0; ii < single[i]->getSlots().size(); ii++)
+				assert(batched[i]->getSlots()[ii]->getAttachment() == single[i]->getSlots()[ii]->getAttachment());
+		}
+	}
+
+	clock_t start = clock();
+	for (int i = 0; i < 100; i++)
+		walk->applyBatch(batched.buffer(), lastTimes.buffer(), times.buffer(), count, true, NULL, 1, MixBlend_Replace,
+						 MixDirection_In);
+	double batchedTime = (double) (clock() - start) / CLOCKS_PER_SEC;
+	start = clock();
+	for (int i = 0; i < 100; i++)
+		for (int ii = 0; ii < count; ii++)
+			walk->apply(*single[ii], lastTimes[ii], times[ii], true, NULL, 1, MixBlend_Replace, MixDirection_In);
+	double singleTime = (double) (clock() - start) / CLOCKS_PER_SEC;
+	printf("Batched apply: %f s, single apply: %f s\n", batchedTime, singleTime);
+
+	ContainerUtil::cleanUpVectorOfPointers(batched);
+	ContainerUtil::cleanUpVectorOfPointers(single);
+	ContainerUtil::cleanUpVectorOfPointers(batchedEvents);
+	dispose(atlas, skeletonData, stateData, skeleton, state);
+}
+
+void testBoneMask() {
+	Atlas *atlas = NULL;
+	SkeletonData *skeletonData = NULL;
+	AnimationStateData *stateData = NULL;
+	Skeleton *skeleton = NULL;
+	AnimationState *state = NULL;
+	loadBinary("testdata/raptor/raptor-pro.skel", "testdata/raptor/raptor.atlas", atlas, skeletonData, stateData, skeleton, state);
+	stateData->setDefaultMix(0.3f);
+	Vector<BoneData *> bones;
+	bones.add(skeletonData->findBone("gun"));
+	bones.add(skeletonData->findBone("front-foot2"));
+	BoneMask mask(*skeletonData, bones);
+
+	// The mask contains the ancestors, the IK constraints moving them and the constraint targets.
+	assert(mask.containsBone(*skeletonData->findBone("root")));
+	assert(mask.containsBone(*skeletonData->findBone("front-foot-target")));
+	assert(mask.containsBone(*skeletonData->findBone("front-leg-target")));
+	assert(!mask.containsBone(*skeletonData->findBone("back-foot1")));
+	assert(mask.getConstraints().contains(skeletonData->findIkConstraint("front-foot-ik")));
+	assert(!mask.getConstraints().contains(skeletonData->findIkConstraint("back-foot-ik")));
+	assert(mask.getBones().size() < skeletonData->getBones().size());
+
+	// The bones in the mask are posed exactly as without a mask.
+	Skeleton masked(skeletonData);
+	masked.setBoneMask(&mask);
+	AnimationState maskedState(stateData);
+	state->setAnimation(0, "walk", true);
+	state->addAnimation(0, "roar", false, 0.5f);
+	state->addAnimation(0, "walk", true, 0);
+	maskedState.setAnimation(0, "walk", true);
+	maskedState.addAnimation(0, "roar", false, 0.5f);
+	maskedState.addAnimation(0, "walk", true, 0);
+	for (int frame = 0; frame < 200; frame++) {
+		state->update(1 / 60.0f);
+		state->apply(*skeleton);
+		skeleton->updateWorldTransform();
+		maskedState.update(1 / 60.0f);
+		maskedState.apply(masked);
+		masked.updateWorldTransform();
+		for (size_t i = 0; i < mask.getBones().size(); i++) {
+			int index = mask.getBones()[i]->getIndex();
+			Bone *bone = skeleton->getBones()[index], *maskedBone = masked.getBones()[index];
+			assert(bone->getWorldX() == maskedBone->getWorldX() && bone->getWorldY() == maskedBone->getWorldY());
+			assert(bone->getA() == maskedBone->getA() && bone->getD() == maskedBone->getD());
+		}
+	}
+	assert(masked.getUpdateCacheList().size() < skeleton->getUpdateCacheList().size());
+	printf("Bone mask: %d of %d bones, %d of %d updatables\n", (int) mask.getBones().size(),
+		   (int) skeletonData->getBones().size(), (int) masked.getUpdateCacheList().size(),
+		   (int) skeleton->getUpdateCacheList().size());
+
+	masked.setBoneMask(NULL);
+	assert(masked.getUpdateCacheList().size() == skeleton->getUpdateCacheList().size());
+	dispose(atlas, skeletonData, stateData, skeleton, state);
+}
+
+void testHeadless() {
+	DebugExtension *debug = (DebugExtension *) SpineExtension::getInstance();
+	const char *files[][2] = {{"testdata/spineboy/spineboy-pro.skel", "testdata/spineboy/spineboy.atlas"},
+							  {"testdata/goblins/goblins-pro.skel", "testdata/goblins/goblins.atlas"},
+							  {"testdata/raptor/raptor-pro.skel", "testdata/raptor/raptor.atlas"},
+							  {"testdata/stretchyman/stretchyman-pro.skel", "testdata/stretchyman/stretchyman.atlas"},
+							  {"testdata/tank/tank-pro.skel", "testdata/tank/tank.atlas"},
+							  {"testdata/coin/coin-pro.skel", "testdata/coin/coin.atlas"},
+							  {"testdata/mix-and-match/mix-and-match-pro.skel", "testdata/mix-and-match/mix-and-match.atlas"}};
+	for (int i = 0; i < 7; i++) {
+		size_t usedBefore = debug->getUsedMemory();
+		Atlas *atlas = new (__FILE__, __LINE__) Atlas(files[i][1], NULL);
+		SkeletonBinary binary(atlas);
+		SkeletonData *skeletonData = binary.readSkeletonDataFile(files[i][0]);
+		size_t fullMemory = debug->getUsedMemory() - usedBefore;
+
+		usedBefore = debug->getUsedMemory();
+		SkeletonBinary headlessBinary(new (__FILE__, __LINE__) HeadlessAttachmentLoader(), true);
+		headlessBinary.setHeadless(true);
+		SkeletonData *headlessData = headlessBinary.readSkeletonDataFile(files[i][0]);
+		size_t headlessMemory = debug->getUsedMemory() - usedBefore;
+
+		usedBefore = debug->getUsedMemory();
+		headlessBinary.setHeadless(true, false);
+		SkeletonData *posedData = headlessBinary.readSkeletonDataFile(files[i][0]);
+		size_t posedMemory = debug->getUsedMemory() - usedBefore;
+		assert(skeletonData && headlessData && posedData);
+		assert(headlessMemory < fullMemory && posedMemory <= headlessMemory);
+		printf("Headless %s: %d -> %d bytes, %d without vertices\n", files[i][0], (int) fullMemory,
+			   (int) headlessMemory, (int) posedMemory);
+
+		// Headless skeletons are posed exactly like the full skeleton, bounds only grow by the stripped whitespace.
+		Skeleton skeleton(skeletonData), headless(headlessData), posed(posedData);
+		Vector<float> vertices;
+		Vector<Animation *> &animations = skeletonData->getAnimations();
+		for (size_t ii = 0; ii < animations.size(); ii++) {
+			Animation *animation = animations[ii], *headlessAnimation = headlessData->getAnimations()[ii];
+			for (float time = 0; time < animation->getDuration(); time += 0.1f) {
+				skeleton.setToSetupPose();
+				headless.setToSetupPose();
+				posed.setToSetupPose();
+				animation->apply(skeleton, 0, time, false, NULL, 1, MixBlend_Replace, MixDirection_In);
+				headlessAnimation->apply(headless, 0, time, false, NULL, 1, MixBlend_Replace, MixDirection_In);
+				posedData->getAnimations()[ii]->apply(posed, 0, time, false, NULL, 1, MixBlend_Replace, MixDirection_In);
+				skeleton.updateWorldTransform();
+				headless.updateWorldTransform();
+				posed.updateWorldTransform();
+				for (size_t iii = 0; iii < skeleton.getBones().size(); iii++) {
+					Bone *bone = skeleton.getBones()[iii];
+					Bone *headlessBone = headless.getBones()[iii], *posedBone = posed.getBones()[iii];
+					assert(bone->getWorldX() == headlessBone->getWorldX() && bone->getWorldY() == headlessBone->getWorldY());
+					assert(bone->getWorldX() == posedBone->getWorldX() && bone->getWorldY() == posedBone->getWorldY());
+					assert(bone->getA() == posedBone->getA() && bone->getD() == posedBone->getD());
+				}
+				float x, y, width, height, headlessX, headlessY, headlessWidth, headlessHeight;
+				skeleton.getBounds(x, y, width, height, vertices);
+				headless.getBounds(headlessX, headlessY, headlessWidth, headlessHeight, vertices);
+				assert(headlessX <= x + 0.01f && headlessY <= y + 0.01f);
+				assert(headlessX + headlessWidth >= x + width - 0.01f && headlessY + headlessHeight >= y + height - 0.01f);
+			}
+			assert(headlessAnimation->getTimelines().size() <= animation->getTimelines().size());
+		}
+
+		// Only render data is stripped.
+		Skin::AttachmentMap::Entries entries = headlessData->getDefaultSkin()->getAttachments();
+		while (entries.hasNext()) {
+			Attachment *attachment = entries.next()._attachment;
+			if (!attachment->getRTTI().isExactly(MeshAttachment::rtti)) continue;
+			MeshAttachment *mesh = static_cast<MeshAttachment *>(attachment);
+			assert(mesh->getRegion() == NULL && mesh->getTriangles().size() == 0 && mesh->getUVs().size() == 0);
+			assert(mesh->getVertices().size() > 0);
+		}
+
+		delete posedData;
+		delete headlessData;
+		delete skeletonData;
+		delete atlas;
+	}
+
+	// Lazily read animations are stripped when they are decoded.
+	SkeletonBinary binary(new (__FILE__, __LINE__) HeadlessAttachmentLoader(), true);
+	binary.setHeadless(true);
+	SkeletonData *skeletonData = binary.readSkeletonDataFile("testdata/spineboy/spineboy-pro.skel");
+	binary.setLazyAnimations(true);
+	SkeletonData *lazyData = binary.readSkeletonDataFile("testdata/spineboy/spineboy-pro.skel");
+	for (size_t i = 0; i < skeletonData->getAnimations().size(); i++) {
+		Animation *animation = skeletonData->getAnimations()[i];
+		assert(lazyData->findAnimation(animation->getName())->getTimelines().size() == animation->getTimelines().size());
+	}
+	delete lazyData;
+	delete skeletonData;
+
+	// Without vertices, lazily read animations are decoded up front and can't be evicted, since deform timelines need the
+	// mesh vertices to be read again.
+	binary.setHeadless(true, false);
+	binary.setLazyAnimations(false);
+	skeletonData = binary.readSkeletonDataFile("testdata/spineboy/spineboy-pro.skel");
+	binary.setLazyAnimations(true);
+	lazyData = binary.readSkeletonDataFile("testdata/spineboy/spineboy-pro.skel");
+	lazyData->evictAnimations();
+	for (size_t i = 0; i < skeletonData->getAnimations().size(); i++) {
+		Animation *animation = skeletonData->getAnimations()[i], *lazyAnimation = lazyData->getAnimations()[i];
+		assert(lazyData->isAnimationDecoded(lazyAnimation));
+		lazyData->evictAnimation(lazyAnimation);
+		assert(lazyData->findAnimation(animation->getName())->getTimelines().size() == animation->getTimelines().size());
+	}
+	delete lazyData;
+	delete skeletonData;
+
+	SkeletonJson json(new (__FILE__, __LINE__) HeadlessAttachmentLoader(), true);
+	json.setHeadless(true, false);
+	skeletonData = json.readSkeletonDataFile("testdata/spineboy/spineboy-pro.json");
+	assert(skeletonData);
+	assert(static_cast<MeshAttachment *>(skeletonData->findSkin("default")->getAttachment(
+								 skeletonData->findSlot("head")->getIndex(), "head"))->getVertices().size() == 0);
+	delete skeletonData;
+}
+
+// The index of an update cache entry in the skeleton's bones or constraints of its type.
+static int updatableIndex(Skeleton &skeleton, Updatable *updatable) {
+	const RTTI &rtti = updatable->getRTTI();
+	if (rtti.isExactly(Bone::rtti)) return skeleton.getBones().indexOf(static_cast<Bone *>(updatable));
+	if (rtti.isExactly(IkConstraint::rtti)) return skeleton.getIkConstraints().indexOf(static_cast<IkConstraint *>(updatable));
+	if (rtti.isExactly(TransformConstraint::rtti))
+		return skeleton.getTransformConstraints().indexOf(static_cast<TransformConstraint *>(updatable));
+	return skeleton.getPathConstraints().indexOf(static_cast<PathConstraint *>(updatable));
+}
+
+void testCompactAttachments() {
+	DebugExtension *debug = (DebugExtension *) SpineExtension::getInstance();
+	const char *files[][2] = {{"testdata/spineboy/spineboy-pro.skel", "testdata/spineboy/spineboy.atlas"},
+							  {"testdata/goblins/goblins-pro.skel", "testdata/goblins/goblins.atlas"},
+							  {"testdata/raptor/raptor-pro.skel", "testdata/raptor/raptor.atlas"},
+							  {"testdata/stretchyman/stretchyman-pro.skel", "testdata/stretchyman/stretchyman.atlas"},
+							  {"testdata/tank/tank-pro.skel", "testdata/tank/tank.atlas"},
+							  {"testdata/coin/coin-pro.skel", "testdata/coin/coin.atlas"},
+							  {"testdata/mix-and-match/mix-and-match-pro.skel", "testdata/mix-and-match/mix-and-match.atlas"}};
+	for (int i = 0; i < 7; i++) {
+		Atlas *atlas = new (__FILE__, __LINE__) Atlas(files[i][1], NULL);
+		SkeletonBinary binary(atlas);
+		size_t usedBefore = debug->getUsedMemory();
+		SkeletonData *skeletonData = binary.readSkeletonDataFile(files[i][0]);
+		size_t fullMemory = debug->getUsedMemory() - usedBefore;
+		binary.setCompactAttachments(true);
+		usedBefore = debug->getUsedMemory();
+		SkeletonData *compactData = binary.readSkeletonDataFile(files[i][0]);
+		size_t compactMemory = debug->getUsedMemory() - usedBefore;
+		binary.setLazyAnimations(true);
+		SkeletonData *lazyData = binary.readSkeletonDataFile(files[i][0]);
+		assert(skeletonData && compactData && lazyData);
+
+		// Region UVs are within 1/65535 and world vertices within 1/65534 of the largest local coordinate.
+		size_t vertexBytes = 0, compactBytes = 0;
+		Skin::AttachmentMap::Entries entries = skeletonData->getDefaultSkin()->getAttachments();
+		while (entries.hasNext()) {
+			Skin::AttachmentMap::Entry &entry = entries.next();
+			if (!entry._attachment->getRTTI().isExactly(MeshAttachment::rtti)) continue;
+			MeshAttachment *mesh = static_cast<MeshAttachment *>(entry._attachment);
+			MeshAttachment *compactMesh = static_cast<MeshAttachment *>(compactData->getDefaultSkin()->getAttachment(entry._slotIndex, entry._name));
+			assert(compactMesh->getRegionUVs().size() == 0 && compactMesh->getUVs().size() == mesh->getUVs().size());
+			for (size_t ii = 0; ii < mesh->getUVs().size(); ii++)
+				assert(MathUtil::abs(mesh->getUVs()[ii] - compactMesh->getUVs()[ii]) < 0.0001f);
+			assert(compactMesh->isWeighted() == mesh->isWeighted());
+			if (!mesh->isWeighted()) continue;
+			assert(compactMesh->getBones().size() == 0 && compactMesh->getVertices().size() == 0);
+			vertexBytes += mesh->getBones().size() * sizeof(int) + mesh->getVertices().size() * sizeof(float);
+			compactBytes += compactMesh->getCompactVertices()->getMemoryUsage();
+		}
+		assert(compactMemory <= fullMemory && compactBytes <= vertexBytes / 2);
+		printf("Compact %s: %d -> %d bytes, weighted vertices %d -> %d bytes\n", files[i][0], (int) fullMemory,
+			   (int) compactMemory, (int) vertexBytes, (int) compactBytes);
+
+		// Deform timelines decoded after compacting match too.
+		Skeleton skeleton(skeletonData), compact(lazyData);
+		Vector<float> vertices, compactVertices;
+		Vector<Animation *> &animations = skeletonData->getAnimations();
+		for (size_t ii = 0; ii < animations.size(); ii++) {
+			for (float time = 0; time < animations[ii]->getDuration(); time += 0.1f) {
+				skeleton.setToSetupPose();
+				compact.setToSetupPose();
+				animations[ii]->apply(skeleton, 0, time, false, NULL, 1, MixBlend_Replace, MixDirection_In);
+				lazyData->findAnimation(animations[ii]->getName())->apply(compact, 0, time, false, NULL, 1, MixBlend_Replace, MixDirection_In);
+				skeleton.updateWorldTransform();
+				compact.updateWorldTransform();
+				for (size_t iii = 0; iii < skeleton.getSlots().size(); iii++) {
+					Attachment *attachment = skeleton.getSlots()[iii]->getAttachment();
+					if (!attachment || !attachment->getRTTI().instanceOf(VertexAttachment::rtti)) continue;
+					VertexAttachment *vertexAttachment = static_cast<VertexAttachment *>(attachment);
+					VertexAttachment *compactAttachment = static_cast<VertexAttachment *>(compact.getSlots()[iii]->getAttachment());
+					size_t length = vertexAttachment->getWorldVerticesLength();
+					vertices.setSize(length, 0);
+					compactVertices.setSize(length, 0);
+					vertexAttachment->computeWorldVertices(*skeleton.getSlots()[iii], vertices);
+					compactAttachment->computeWorldVertices(*compact.getSlots()[iii], compactVertices);
+					for (size_t v = 0; v < length; v++)
+						assert(MathUtil::abs(vertices[v] - compactVertices[v]) < 0.5f);
+				}
+			}
+		}
+
+		// Path constraints sort and pose bones the same with every skin.
+		Skeleton full(skeletonData), compactFull(compactData);
+		for (size_t ii = 0; ii < skeletonData->getSkins().size(); ii++) {
+			full.setSkin(skeletonData->getSkins()[ii]);
+			compactFull.setSkin(compactData->getSkins()[ii]);
+			full.setToSetupPose();
+			compactFull.setToSetupPose();
+			Vector<Updatable *> &updateCache = full.getUpdateCacheList(), &compactCache = compactFull.getUpdateCacheList();
+			assert(updateCache.size() == compactCache.size());
+			for (size_t iii = 0; iii < updateCache.size(); iii++) {
+				assert(&updateCache[iii]->getRTTI() == &compactCache[iii]->getRTTI());
+				assert(updatableIndex(full, updateCache[iii]) == updatableIndex(compactFull, compactCache[iii]));
+			}
+			if (animations.size() == 0) continue;
+			for (float time = 0; time < animations[0]->getDuration(); time += 0.25f) {
+				animations[0]->apply(full, 0, time, false, NULL, 1, MixBlend_Setup, MixDirection_In);
+				animations[0]->apply(compactFull, 0, time, false, NULL, 1, MixBlend_Setup, MixDirection_In);
+				full.updateWorldTransform();
+				compactFull.updateWorldTransform();
+				for (size_t iii = 0; iii < full.getBones().size(); iii++) {
+					Bone *bone = full.getBones()[iii], *compactBone = compactFull.getBones()[iii];
+					assert(bone->getWorldX() == compactBone->getWorldX() && bone->getWorldY() == compactBone->getWorldY());
+					assert(bone->getA() == compactBone->getA() && bone->getB() == compactBone->getB());
+					assert(bone->getC() == compactBone->getC() && bone->getD() == compactBone->getD());
+				}
+			}
+		}
+
+		delete lazyData;
+		delete compactData;
+		delete skeletonData;
+		delete atlas;
+	}
+}
+
+struct TestVertex {
+	unsigned int color;
+	float x, y, u, v;
+	unsigned int dark;
+};
+
+struct TestLayout {
+	typedef TestVertex Vertex;
+	typedef unsigned int PackedColor;
+	static const size_t PositionOffset = 1;
+	static const bool DarkColor = true;
+
+	static PackedColor packColor(const Color &color) {
+		return (unsigned int) (color.a * 255) << 24 | (unsigned int) (color.b * 255) << 16 |
+			   (unsigned int) (color.g * 255) << 8 | (unsigned int) (color.r * 255);
+	}
+
+	static void setColor(Vertex &vertex, const PackedColor &light, const PackedColor &dark) {
+		vertex.color = light;
+		vertex.dark = dark;
+	}
+
+	static void setUV(Vertex &vertex, float u, float v) {
+		vertex.u = u;
+		vertex.v = v;
+	}
+};
+
+void testVertexWriter() {
+	const char *skeletons[][3] = {{"testdata/spineboy/spineboy-pro.skel", "testdata/spineboy/spineboy.atlas", "portal"},
+								  {"testdata/tank/tank-pro.skel", "testdata/tank/tank.atlas", "drive"}};
+	int totalClipped = 0;
+	for (int i = 0; i < 2; i++) {
+		Atlas *atlas = NULL;
+		SkeletonData *skeletonData = NULL;
+		AnimationStateData *stateData = NULL;
+		Skeleton *skeleton = NULL;
+		AnimationState *state = NULL;
+		loadBinary(skeletons[i][0], skeletons[i][1], atlas, skeletonData, stateData, skeleton, state);
+		state->setAnimation(0, skeletons[i][2], true);
+
+		// The vertices are the same as those converted from the world vertices and the clipper output.
+		VertexWriter<TestLayout> writer;
+		SkeletonClipping clipper, expectedClipper;
+		Vector<float> worldVertices;
+		Vector<unsigned short> quadIndices;
+		quadIndices.add(0);
+		quadIndices.add(1);
+		quadIndices.add(2);
+		quadIndices.add(2);
+		quadIndices.add(3);
+		quadIndices.add(0);
+		int written = 0, clipped = 0;
+		for (int frame = 0; frame < 120; frame++) {
+			state->update(1 / 30.0f);
+			state->apply(*skeleton);
+			skeleton->updateWorldTransform();
+			for (size_t ii = 0; ii < skeleton->getDrawOrder().size(); ii++) {
+				Slot &slot = *skeleton->getDrawOrder()[ii];
+				Attachment *attachment = slot.getAttachment();
+				if (attachment && attachment->getRTTI().isExactly(ClippingAttachment::rtti)) {
+					clipper.clipStart(slot, static_cast<ClippingAttachment *>(attachment));
+					expectedClipper.clipStart(slot, static_cast<ClippingAttachment *>(attachment));
+					continue;
+				}
+				if (!writer.write(slot, clipper)) {
+					clipper.clipEnd(slot);
+					expectedClipper.clipEnd(slot);
+					continue;
+				}
+
+				Vector<float> *uvs;
+				Vector<unsigned short> *indices;
+				Color *color;
+				if (attachment->getRTTI().isExactly(RegionAttachment::rtti)) {
+					RegionAttachment *region = static_cast<RegionAttachment *>(attachment);
+					worldVertices.setSize(8, 0);
+					region->computeWorldVertices(slot, worldVertices, 0, 2);
+					uvs = &region->getUVs();
+					indices = &quadIndices;
+					color = &region->getColor();
+				} else {
+					MeshAttachment *mesh = static_cast<MeshAttachment *>(attachment);
+					worldVertices.setSize(mesh->getWorldVerticesLength(), 0);
+					mesh->computeWorldVertices(slot, 0, mesh->getWorldVerticesLength(), worldVertices.buffer(), 0, 2);
+					uvs = &mesh->getUVs();
+					indices = &mesh->getTriangles();
+					color = &mesh->getColor();
+				}
+				Vector<float> *vertices = &worldVertices;
+				if (expectedClipper.isClipping()) {
+					expectedClipper.clipTriangles(worldVertices, *indices, *uvs, 2);
+					vertices = &expectedClipper.getClippedVertices();
+					uvs = &expectedClipper.getClippedUVs();
+					indices = &expectedClipper.getClippedTriangles();
+					clipped++;
+				}
+				Color light(skeleton->getColor());
+				light.r *= slot.getColor().r * color->r;
+				light.g *= slot.getColor().g * color->g;
+				light.b *= slot.getColor().b * color->b;
+				light.a *= slot.getColor().a * color->a;
+				Color dark(0, 0, 0, 1);
+				if (slot.hasDarkColor()) dark = slot.getDarkColor();
+
+				assert(writer.getVerticesCount() == vertices->size() >> 1);
+				assert(writer.getIndicesCount() == indices->size());
+				for (size_t iii = 0; iii < writer.getVerticesCount(); iii++) {
+					TestVertex &vertex = writer.getVertices()[iii];
+					assert(vertex.x == (*vertices)[iii << 1] && vertex.y == (*vertices)[(iii << 1) + 1]);
+					assert(vertex.u == (*uvs)[iii << 1] && vertex.v == (*uvs)[(iii << 1) + 1]);
+					assert(vertex.color == TestLayout::packColor(light) && vertex.dark == TestLayout::packColor(dark));
+				}
+				for (size_t iii = 0; iii < writer.getIndicesCount(); iii++)
+					assert(writer.getIndices()[iii] == (*indices)[iii]);
+				written++;
+				clipper.clipEnd(slot);
+				expectedClipper.clipEnd(slot);
+			}
+			clipper.clipEnd();
+			expectedClipper.clipEnd();
+		}
+		printf("Vertex writer %s: %d attachments written, %d clipped\n", skeletons[i][0], written, clipped);
+		totalClipped += clipped;
+		dispose(atlas, skeletonData, stateData, skeleton, state);
+	}
+	assert(totalClipped > 0);
+}
+
+static int steadyStateEvents = 0;
+
+void countEvent(AnimationState *state, EventType type, TrackEntry *entry, Event *event) {
+	SP_UNUSED(state);
+	SP_UNUSED(entry);
+	SP_UNUSED(event);
+	if (type == EventType_Event) steadyStateEvents++;
+}
+
+void playScript(AnimationState *state, Skeleton *skeleton, Animation **animations, int frame) {
+	// walk, run, idle, run on track 0, shoot then aim on track 1 and jump then an additive turn on track 2.
+	int locomotion[] = {0, 1, 2, 1};
+	if (frame % 90 == 0) state->setAnimation(0, animations[locomotion[(frame / 90) % 4]], true);
+	if (frame % 150 == 0) {
+		state->setAnimation(1, animations[3], false);
+		state->addAnimation(1, animations[4], true, 0)->setMixDuration(0.1f);
+	}
+	if (frame % 200 == 50) {
+		TrackEntry *entry = state->setAnimation(2, animations[5], false);
+		entry->setAlpha(0.5f);
+		entry = state->addAnimation(2, animations[6], false, 0.3f);
+		entry->setMixBlend(MixBlend_Add);
+	}
+	state->update(1 / 60.0f);
+	state->apply(*skeleton);
+	skeleton->updateWorldTransform();
+}
+
+void testSteadyState() {
+	DebugExtension *debug = (DebugExtension *) SpineExtension::getInstance();
+	Atlas *atlas = NULL;
+	SkeletonData *skeletonData = NULL;
+	AnimationStateData *stateData = NULL;
+	Skeleton *skeleton = NULL;
+	AnimationState *state = NULL;
+	loadBinary("testdata/spineboy/spineboy-pro.skel", "testdata/spineboy/spineboy.atlas", atlas, skeletonData, stateData, skeleton, state);
+	stateData->setDefaultMix(0.2f);
+	const char *names[] = {"walk", "run", "idle", "shoot", "aim", "jump", "idle-turn"};
+	Animation *animations[7];
+	for (int i = 0; i < 7; i++)
+		animations[i] = skeletonData->findAnimation(names[i]);
+
+	// Without the timeline mode cache, setting animations, updating and applying the state never allocate once its
+	// capacity is ensured, also when baked timelines are mixed per channel. With the cache, they no longer allocate once
+	// the script has run twice and the cache holds all combinations of animations it plays.
+	const char *passes[] = {"mode cache off", "mode cache on", "mode cache off, baked walk and run"};
+	for (int pass = 0; pass < 3; pass++) {
+		bool cache = pass == 1;
+		stateData->setTimelineModeCache(cache);
+		if (pass == 2) {
+			animations[0]->bake(*skeletonData, 60);
+			animations[1]->bake(*skeletonData, 60);
+			assert(animations[0]->getTimelines()[0]->getRTTI().isExactly(BakedTimeline::rtti));
+		}
+		AnimationState steadyState(stateData);
+		steadyState.setListener(countEvent);
+		steadyState.ensureCapacity(3);
+		for (int frame = 0; cache && frame < 3600; frame++)
+			playScript(&steadyState, skeleton, animations, frame);
+		size_t allocations = debug->getAllocations(), reallocations = debug->getReallocations();
+		steadyStateEvents = 0;
+		for (int frame = 0; frame < 10000; frame++)
+			playScript(&steadyState, skeleton, animations, frame);
+		assert(debug->getAllocations() == allocations);
+		assert(debug->getReallocations() == reallocations);
+		assert(steadyStateEvents > 0);
+		printf("Steady state (%s): 10000 frames, %d events, no allocations\n", passes[pass], steadyStateEvents);
+	}
+	dispose(atlas, skeletonData, stateData, skeleton, state);
+}
+
 int main(int argc, char **argv) {
 	SP_UNUSED(argc);
 	SP_UNUSED(argv);
@@ -111,6 +1714,30 @@ int main(int argc, char **argv) {
 	SpineExtension::setInstance(&debug);
 
 	testLoading();
+	testCulling();
+	testLod();
+	testBaking();
+	testCompression();
+	testSparseDeform();
+	testSkinCache();
+	testAtlasRepacker();
+	testBinaryAtlas();
+	testLazyAnimations();
+#ifdef SPINE_BULK_LOADER
+	testBulkLoader();
+#endif
+	testIncremental();
+	testFastTrig();
+	testSnapshot();
+	testProfiler();
+	testTimelineModeCache();
+	testEventBuffer();
+	testBatchedApply();
+	testBoneMask();
+	testHeadless();
+	testCompactAttachments();
+	testVertexWriter();
+	testSteadyState();
 
 	debug.reportLeaks();
 }
@@ -47,6 +47,8 @@ namespace spine {
 
 	class AnimationState;
 
+	class SkeletonData;
+
 	class SP_API Animation : public SpineObject {
 		friend class AnimationState;
 
@@ -96,6 +98,8 @@ namespace spine {
 
 		friend class TwoColorTimeline;
 
+		friend class SkeletonData;
+
 	public:
 		Animation(const String &name, Vector<Timeline *> &timelines, float duration);
 
@@ -106,12 +110,37 @@ namespace spine {
 		void apply(Skeleton &skeleton, float lastTime, float time, bool loop, Vector<Event *> *pEvents, float alpha,
 				   MixBlend blend, MixDirection direction);
 
+		/// Applies all the animation's timelines to several skeletons using the same SkeletonData, each at its own time, with
+		/// the same result as calling apply() for each skeleton. Each timeline is applied to a batch of skeletons before the
+		/// next, so its keyframes stay in cache, see Timeline::applyBatch().
+		/// @param pEvents NULL, or count vectors which fired events are added to, which may be NULL.
+		void applyBatch(Skeleton **skeletons, float *lastTimes, float *times, size_t count, bool loop,
+						Vector<Event *> **pEvents, float alpha, MixBlend blend, MixDirection direction);
+
 		const String &getName();
 
 		Vector<Timeline *> &getTimelines();
 
 		bool hasTimeline(Vector<PropertyId> &ids);
 
+		/// Replaces the timelines keying bone local transforms with a single BakedTimeline sampled at the specified rate. Useful
+		/// at load time for looping animations such as walk or idle cycles, where evaluating the curves of every bone timeline
+		/// each frame is wasteful. Other timelines are kept as is, so baked animations can be mixed with any other animation.
+		/// @param fps The number of samples per second, eg 30 or 60.
+		void bake(SkeletonData &skeletonData, float fps);
+
+		/// Reduces the memory used by the keyframes of the timelines. Bone timeline keyframes which can be linearly interpolated
+		/// from their neighbors within the tolerance for their values are removed. Deform timelines store their keyframes as
+		/// quantized, sparse offsets from the setup pose. The bezier curves of all curve timelines are quantized to 16 bits. See
+		/// CurveTimeline::reduce(), CurveTimeline::quantize() and DeformTimeline::compress().
+		/// @param angleTolerance The largest allowed difference for rotations and shears, in degrees.
+		/// @param translateTolerance The largest allowed difference for translations and deform vertices.
+		/// @param scaleTolerance The largest allowed difference for scales.
+		void compress(float angleTolerance, float translateTolerance, float scaleTolerance);
+
+		/// Returns the number of bytes allocated for the keyframe data of all timelines.
+		size_t getMemoryUsage();
+
 		float getDuration();
 
 		void setDuration(float inValue);
@@ -125,6 +154,9 @@ namespace spine {
 		HashMap<PropertyId, bool> _timelineIds;
 		float _duration;
 		String _name;
+
+		/// Disposes the current timelines and replaces them.
+		void setTimelines(Vector<Timeline *> &timelines);
 	};
 }
 
@@ -69,6 +69,10 @@ namespace spine {
 
 	class AttachmentTimeline;
 
+	class EventBuffer;
+
+	class BoneMask;
+
 #ifdef SPINE_USE_STD_FUNCTION
 	typedef std::function<void (AnimationState* state, EventType type, TrackEntry* entry, Event* event)> AnimationStateListener;
 #else
@@ -94,6 +98,8 @@ namespace spine {
 
 		friend class AnimationState;
 
+		friend class SkeletonSnapshot;
+
 	public:
 		TrackEntry();
 
@@ -102,6 +108,9 @@ namespace spine {
 		/// The index of the track where this entry is either current or queued.
 		int getTrackIndex();
 
+		/// An id which is unique among the entries of the AnimationState, see EventRecord::entryId.
+		int getId();
+
 		/// The animation to apply for this track entry.
 		Animation *getAnimation();
 
@@ -278,6 +287,7 @@ namespace spine {
 		TrackEntry *_mixingFrom;
 		TrackEntry *_mixingTo;
 		int _trackIndex;
+		int _id;
 
 		bool _loop, _holdPrevious, _reverse, _shortestRotation;
 		float _eventThreshold, _attachmentThreshold, _drawOrderThreshold;
@@ -288,6 +298,8 @@ namespace spine {
 		Vector<int> _timelineMode;
 		Vector<TrackEntry *> _timelineHoldMix;
 		Vector<float> _timelinesRotation;
+		BoneMask *_boneMask;
+		Vector<bool> _timelineMasked;
 		AnimationStateListener _listener;
 		AnimationStateListenerObject *_listenerObject;
 
@@ -308,6 +320,8 @@ namespace spine {
 	class SP_API EventQueue : public SpineObject {
 		friend class AnimationState;
 
+		friend class SkeletonSnapshot;
+
 	private:
 		Vector<EventQueueEntry> _eventQueueEntries;
 		AnimationState &_state;
@@ -342,6 +356,10 @@ namespace spine {
 
 		friend class EventQueue;
 
+		friend class SkeletonSnapshot;
+
+		friend class BakedTimeline;
+
 	public:
 		explicit AnimationState(AnimationStateData *data);
 
@@ -353,6 +371,11 @@ namespace spine {
 
 		/// Poses the skeleton using the track entry animations. There are no side effects other than invoking listeners, so the
 		/// animation state can be applied to multiple skeletons to pose them identically.
+		///
+		/// If the animation state is culled or this call is skipped by the apply interval, only event timelines are applied
+		/// and the skeleton pose is left untouched. Events, complete and end notifications are raised exactly as if the pose
+		/// had been applied.
+		/// @return True if the pose of the skeleton was changed. Skeleton::updateWorldTransform() can be skipped if false.
 		bool apply(Skeleton &skeleton);
 
 		/// Removes all animations from all tracks, leaving skeletons in their previous pose.
@@ -424,6 +447,12 @@ namespace spine {
 
 		void setListener(AnimationStateListenerObject *listener);
 
+		/// When set, events are added to the buffer when the queue is drained instead of calling the state and track entry
+		/// listeners. End events are followed by a dispose event, as for listeners. May be NULL.
+		void setEventBuffer(EventBuffer *buffer);
+
+		EventBuffer *getEventBuffer();
+
 		void disableQueue();
 
 		void enableQueue();
@@ -434,6 +463,29 @@ namespace spine {
 
 		void disposeTrackEntry(TrackEntry *entry);
 
+		/// If true, apply() only advances events and never poses the skeleton, eg for skeletons that are off screen. The
+		/// next apply() after culling is disabled poses the skeleton at the current track times.
+		void setCulled(bool inValue);
+
+		bool isCulled();
+
+		/// The skeleton is posed on every Nth call to apply(), the other calls only fire events. Defaults to 1, which poses the
+		/// skeleton on every call.
+		void setApplyInterval(int inValue);
+
+		int getApplyInterval();
+
+		/// Sets the apply interval based on the distance of the skeleton to the viewer. The interval is 1 up to nearDistance,
+		/// grows linearly between nearDistance and farDistance and is maxInterval from farDistance on.
+		void setApplyIntervalForDistance(float distance, float nearDistance, float farDistance, int maxInterval);
+
+		/// Preallocates the track entries, the event queue and the buffers used while applying, sized from the animations
+		/// of the skeleton data, so that update(), apply() and setAnimation() and addAnimation() taking an Animation do not
+		/// allocate for up to tracksCount tracks, each with up to entriesPerTrack entries queued or mixing. Lazily read
+		/// animations are decoded. The timeline mode cache of AnimationStateData still allocates for each combination of
+		/// animations the first time it is seen.
+		void ensureCapacity(size_t tracksCount, size_t entriesPerTrack = 4);
+
 	private:
 		static const int Subsequent = 0;
 		static const int First = 1;
@@ -453,9 +505,12 @@ namespace spine {
 
 		HashMap<PropertyId, bool> _propertyIDs;
 		bool _animationsChanged;
+		Vector<size_t> _timelineModeKey;
 
 		AnimationStateListener _listener;
 		AnimationStateListenerObject *_listenerObject;
+		EventBuffer *_eventBuffer;
+		int _nextTrackEntryId;
 
 		int _unkeyedState;
 
@@ -463,19 +518,32 @@ namespace spine {
 
 		bool _manualTrackEntryDisposal;
 
+		bool _culled;
+
+		int _applyInterval;
+
+		int _applyCounter;
+
 		static Animation *getEmptyAnimation();
 
 		static void
 		applyRotateTimeline(RotateTimeline *rotateTimeline, Skeleton &skeleton, float time, float alpha, MixBlend pose,
 							Vector<float> &timelinesRotation, size_t i, bool firstFrame);
 
+		/// Returns r1 mixed toward r2, keeping the direction and loops of the mix in two floats of timelinesRotation.
+		static float mixRotation(float r1, float r2, float alpha, float *timelinesRotation, bool firstFrame);
+
 		void applyAttachmentTimeline(AttachmentTimeline *attachmentTimeline, Skeleton &skeleton, float animationTime,
 									 MixBlend pose, bool firstFrame);
 
 		/// Returns true when all mixing from entries are complete.
 		bool updateMixingFrom(TrackEntry *to, float delta);
 
-		float applyMixingFrom(TrackEntry *to, Skeleton &skeleton, MixBlend currentPose);
+		float applyMixingFrom(TrackEntry *to, Skeleton &skeleton, MixBlend currentPose, bool pose);
+
+		/// Returns the alpha of a timeline of an entry being mixed out for the timeline's mode and sets its blend.
+		float getMixingFromAlpha(int mode, TrackEntry *holdMix, MixBlend blend, float alphaMix, float alphaHold,
+								 MixBlend &timelineBlend);
 
 		void queueEvents(TrackEntry *entry, float animationTime);
 
@@ -495,6 +563,17 @@ namespace spine {
 
 		void computeHold(TrackEntry *entry);
 
+		/// Sets the modes of the channels of baked timelines, each from its own property like the timeline it replaces.
+		void computeChannelHold(TrackEntry *entry);
+
+		/// Returns flags for the timelines of the entry which key only bones, slots and constraints outside the skeleton's bone
+		/// mask, or NULL if the skeleton has no bone mask.
+		bool *getMaskedTimelines(TrackEntry &entry, Skeleton &skeleton);
+
+		/// Sets the timeline modes from the AnimationStateData cache, or computes and caches them. propertyIDsCount is the
+		/// number of animations in the key whose property IDs were added to _propertyIDs.
+		void computeHoldCached(TrackEntry *entry, size_t &propertyIDsCount);
+
 		void setAttachment(Skeleton &skeleton, spine::Slot &slot, const String &attachmentName, bool attachments);
 	};
 }
@@ -33,6 +33,7 @@
 #include <spine/HashMap.h>
 #include <spine/SpineObject.h>
 #include <spine/SpineString.h>
+#include <spine/Vector.h>
 
 #include <assert.h>
 
@@ -48,6 +49,8 @@ namespace spine {
 	public:
 		explicit AnimationStateData(SkeletonData *skeletonData);
 
+		~AnimationStateData();
+
 		/// The SkeletonData to look up animations when they are specified by name.
 		SkeletonData *getSkeletonData();
 
@@ -70,7 +73,41 @@ namespace spine {
 		/// Removes all mixes and sets the default mix to 0.
 		void clear();
 
+		/// When true, the timeline modes an AnimationState computes when its animations change are cached, keyed by the
+		/// animations on lower tracks and the mixing chain of each track entry. AnimationStates using this data share the
+		/// cache, so repeated transitions between the same animations do not recompute them. Applying an AnimationState then
+		/// writes to this data, so AnimationStates sharing it must be updated from the same thread. Default is false.
+		bool getTimelineModeCache();
+
+		void setTimelineModeCache(bool inValue);
+
+		/// The number of track entries whose timeline modes were found in the cache.
+		size_t getTimelineModeCacheHits();
+
+		/// The number of track entries whose timeline modes were computed and added to the cache.
+		size_t getTimelineModeCacheMisses();
+
+		/// The number of cached timeline modes. The cache keeps every combination of animations it has seen until it is
+		/// cleared.
+		size_t getTimelineModeCacheSize();
+
+		/// Removes all cached timeline modes and resets the hit and miss counters. Must be called when the timelines of an
+		/// animation are replaced or an animation not owned by the SkeletonData is deleted.
+		void clearTimelineModeCache();
+
 	private:
+		class TimelineModes : public SpineObject {
+		public:
+			TimelineModes(size_t hash, Vector<size_t> &key);
+
+			size_t _hash;
+			Vector<size_t> _key;
+			Vector<int> _modes;
+			// The position of the hold mix entry in the mixing chain, 0 when none.
+			Vector<int> _holdMix;
+			TimelineModes *_next; // The next timeline modes in the same bucket.
+		};
+
 		class AnimationPair : public SpineObject {
 		public:
 			Animation *_a1;
@@ -84,6 +121,18 @@ namespace spine {
 		SkeletonData *_skeletonData;
 		float _defaultMix;
 		HashMap<AnimationPair, float> _animationToMixTime;
+		bool _timelineModeCache;
+		size_t _timelineModeCacheHits;
+		size_t _timelineModeCacheMisses;
+		Vector<TimelineModes *> _timelineModes;
+		Vector<TimelineModes *> _timelineModeBuckets; // The first timeline modes of each bucket, the bucket count is a power of two.
+		size_t _timelineModeMask;
+
+		TimelineModes *findTimelineModes(size_t hash, Vector<size_t> &key);
+
+		TimelineModes *addTimelineModes(size_t hash, Vector<size_t> &key);
+
+		void resizeTimelineModes(size_t bucketCount);
 	};
 }
 
@@ -96,6 +96,9 @@ namespace spine {
 
 	class SP_API AtlasRegion : public TextureRegion {
 	public:
+		AtlasRegion() : page(NULL), index(-1), x(0), y(0) {
+		}
+
 		AtlasPage *page;
 		String name;
 		int index;
@@ -104,22 +107,32 @@ namespace spine {
 		Vector<int> pads;
 		Vector <String> names;
 		Vector<float> values;
+		/// The number of values for each name, in order. When empty, the values are shared equally by the names.
+		Vector<int> valueCounts;
 	};
 
 	class TextureLoader;
 
+	/// Stores the pages and regions of a texture atlas. The data can be either the text .atlas format or the binary format written
+	/// by writeBinary(), which is detected by its header. The binary format stores regions as flat records with a prebuilt name
+	/// hash index, so it can be read straight from a memory mapped file without tokenizing.
 	class SP_API Atlas : public SpineObject {
 	public:
 		Atlas(const String &path, TextureLoader *textureLoader, bool createTexture = true);
 
+		/// The data is not referenced after the constructor returns, so a memory mapped file can be unmapped afterwards.
 		Atlas(const char *data, int length, const char *dir, TextureLoader *textureLoader, bool createTexture = true);
 
 		~Atlas();
 
 		void flipV();
 
-		/// Returns the first region found with the specified name. This method uses String comparison to find the region, so the result
-		/// should be cached rather than calling this method multiple times.
+		/// Creates the textures of pages which have none using the texture loader, eg for an atlas created with createTexture
+		/// false on another thread. Regions without a renderer object are assigned their page's texture.
+		void createTextures();
+
+		/// Returns the first region found with the specified name. Regions are looked up through a name hash index, which is
+		/// rebuilt if regions were added or removed since the last lookup.
 		/// @return The region, or NULL.
 		AtlasRegion *findRegion(const String &name);
 
@@ -127,12 +140,29 @@ namespace spine {
 
 		Vector<AtlasRegion *> &getRegions();
 
+		/// Writes the pages and regions of this atlas in the binary atlas format. Texture coordinates are computed from the region
+		/// bounds when loading, so flipV() is not preserved.
+		void writeBinary(Vector<char> &output);
+
+		/// Returns true if the data starts with the binary atlas format header.
+		static bool isBinary(const char *data, int length);
+
 	private:
 		Vector<AtlasPage *> _pages;
 		Vector<AtlasRegion *> _regions;
 		TextureLoader *_textureLoader;
+		Vector<int> _index;
+		size_t _indexedRegions;
+		AtlasRegion *_regionBlock;
+		size_t _regionBlockSize;
 
 		void load(const char *begin, int length, const char *dir, bool createTexture);
+
+		void loadBinary(const char *data, int length, const char *dir, bool createTexture);
+
+		void addPage(AtlasPage *page, const char *dir, bool createTexture);
+
+		void buildIndex();
 	};
 }
 
@@ -0,0 +1,87 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated September 24, 2021. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2021, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_AtlasRepacker_h
+#define Spine_AtlasRepacker_h
+
+#include <spine/Atlas.h>
+
+namespace spine {
+	class Skin;
+
+	class Attachment;
+
+	/// Packs the atlas regions used by a skin into a single new page, so a skin composed from parts on several pages, eg with
+	/// SkinCache, can be rendered without switching textures. Packing and copying pixels is done on the CPU without a renderer,
+	/// so it can run on a worker thread. The texture for the new page is created afterward by the caller.
+	class SP_API AtlasRepacker : public SpineObject {
+	public:
+		/// @param padding The number of transparent pixels between packed regions.
+		/// @param maxSize The maximum width and height of the new page.
+		explicit AtlasRepacker(int padding = 2, int maxSize = 4096);
+
+		~AtlasRepacker();
+
+		/// Packs the regions of the skin's region and mesh attachments, including their sequences, into a new page using the
+		/// page pixels from TextureLoader::getPixels(). The new skin has the skin's bones and constraints, copies of its region
+		/// and mesh attachments using the new regions, and its other attachments. The results of a previous call are disposed.
+		/// @return False if the skin has no regions, the pixels of a page are not available, the pages differ in premultiplied
+		/// alpha, or the regions do not fit in the maximum size.
+		bool repack(Skin &skin, TextureLoader &textureLoader, const String &name);
+
+		/// The skin using the new regions, owned by the repacker. NULL if repack() did not succeed.
+		Skin *getSkin();
+
+		/// The new page, owned by the repacker. Its texture is NULL and must be set before the skin is rendered, eg by creating a
+		/// texture from getPixels() on the render thread. NULL if repack() did not succeed.
+		AtlasPage *getPage();
+
+		/// The new regions, owned by the repacker.
+		Vector<AtlasRegion *> &getRegions();
+
+		/// The RGBA8888 pixels of the new page, with rows from top to bottom.
+		Vector<unsigned char> &getPixels();
+
+	private:
+		int _padding;
+		int _maxSize;
+		Skin *_skin;
+		AtlasPage *_page;
+		Vector<AtlasRegion *> _regions;
+		Vector<unsigned char> _pixels;
+
+		void clear();
+
+		bool pack(Vector<AtlasRegion *> &sources, Vector<int> &positions, int width, int height);
+
+		Attachment *copyAttachment(Attachment *attachment, Vector<AtlasRegion *> &sources);
+	};
+}
+
+#endif /* Spine_AtlasRepacker_h */
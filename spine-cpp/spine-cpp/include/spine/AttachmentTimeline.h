@@ -66,6 +66,8 @@ namespace spine {
 
 		Vector<String> &getAttachmentNames();
 
+		virtual size_t getMemoryUsage();
+
 		int getSlotIndex() { return _slotIndex; }
 
 		void setSlotIndex(int inValue) { _slotIndex = inValue; }
@@ -0,0 +1,102 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated September 24, 2021. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2021, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_BakedTimeline_h
+#define Spine_BakedTimeline_h
+
+#include <spine/Timeline.h>
+
+namespace spine {
+	class SkeletonData;
+
+	class Animation;
+
+	class Bone;
+
+	class BoneData;
+
+	/// Stores the bone local transforms of an animation sampled at a fixed rate and quantized to 16 bits per value. Applying
+	/// the timeline interpolates once per keyed bone property instead of evaluating the curves of each bone timeline.
+	///
+	/// Stepped and bezier curves are approximated by linear interpolation between samples. See Animation::bake().
+	class SP_API BakedTimeline : public Timeline {
+	RTTI_DECL
+
+	public:
+		/// Samples all bone timelines of the animation.
+		/// @param fps The number of samples per second. The last sample is at the animation duration.
+		BakedTimeline(SkeletonData &skeletonData, Animation &animation, float fps);
+
+		virtual ~BakedTimeline();
+
+		virtual void
+		apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha, MixBlend blend,
+			  MixDirection direction);
+
+		/// Applies a single channel, which AnimationState uses when mixing so each channel gets the timeline mode of its
+		/// property, as the timeline it replaces would. Bone rotations are mixed using the direction of the shortest route on
+		/// the first frame while detecting crosses, the same as for a RotateTimeline.
+		/// @param channel The index of the channel's property in getPropertyIds().
+		/// @param timelinesRotation NULL, or two floats of rotation mixing state kept by the track entry between frames.
+		void mixChannel(Skeleton &skeleton, size_t channel, float time, float alpha, MixBlend blend,
+						MixDirection direction, float *timelinesRotation, bool firstFrame);
+
+		float getFps();
+
+		/// The number of bone properties stored per sample.
+		size_t getChannelCount();
+
+		virtual size_t getMemoryUsage();
+
+		/// Returns true if the timeline only keys bone local transforms and can be replaced by a BakedTimeline.
+		static bool isBoneTimeline(Timeline &timeline);
+
+	private:
+		static size_t getSampleCount(float duration, float fps);
+
+		/// Returns the sample before the time and the percentage of the way to the next sample.
+		void getFrame(float time, size_t &frame, float &t);
+
+		static void applyValue(float &target, float setup, int property, float value, float alpha, MixBlend blend,
+							   MixDirection direction, float *timelinesRotation, bool firstFrame);
+
+		static float *getBoneValue(Bone &bone, int property);
+
+		static float getSetupValue(BoneData &data, int property);
+
+		float _fps;
+		Vector<int> _boneIndices;
+		Vector<int> _properties;
+		Vector<float> _offsets;
+		Vector<float> _scales;
+		Vector<unsigned short> _samples;
+	};
+}
+
+#endif /* Spine_BakedTimeline_h */
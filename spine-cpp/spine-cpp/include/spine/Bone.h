@@ -47,6 +47,8 @@ namespace spine {
 	class SP_API Bone : public Updatable {
 		friend class AnimationState;
 
+		friend class BakedTimeline;
+
 		friend class RotateTimeline;
 
 		friend class IkConstraint;
@@ -59,6 +61,8 @@ namespace spine {
 
 		friend class Skeleton;
 
+		friend class SkeletonSnapshot;
+
 		friend class RegionAttachment;
 
 		friend class PointAttachment;
@@ -109,6 +113,10 @@ namespace spine {
 		/// Computes the world transform using the parent bone and this bone's local transform.
 		void updateWorldTransform();
 
+		/// Computes the world transform using the parent bone and this bone's setup pose local transform, ignoring the
+		/// transform mode. Used instead of updateWorldTransform() for bones excluded by the skeleton's level of detail.
+		void updateRigidWorldTransform();
+
 		/// Computes the world transform using the parent bone and the specified local transform.
 		void
 		updateWorldTransform(float x, float y, float rotation, float scaleX, float scaleY, float shearX, float shearY);
@@ -253,6 +261,9 @@ namespace spine {
 
 		void setActive(bool inValue);
 
+		/// True if the bone rigidly follows its parent at the skeleton's current level of detail.
+		bool isRigid();
+
 	private:
 		static bool yDown;
 
@@ -264,8 +275,22 @@ namespace spine {
 		float _ax, _ay, _arotation, _ascaleX, _ascaleY, _ashearX, _ashearY;
 		float _a, _b, _worldX;
 		float _c, _d, _worldY;
+		float _rigidA, _rigidB, _rigidC, _rigidD;
+		float _lastX, _lastY, _lastRotation, _lastScaleX, _lastScaleY, _lastShearX, _lastShearY;
+		float _localRotation, _localScaleX, _localScaleY, _localShearX, _localShearY;
+		float _la, _lb, _lc, _ld;
+		unsigned int _updateFrame;
 		bool _sorted;
 		bool _active;
+		bool _rigid;
+		bool _modified;
+		bool _localFastTrig;
+
+		/// Marks the world transform as changed by something other than update(), see Skeleton::setIncremental().
+		void setModified();
+
+		/// Computes _la, _lb, _lc and _ld from the specified values, unless they are the values last used.
+		void updateLocalMatrix(float rotation, float scaleX, float scaleY, float shearX, float shearY);
 	};
 }
 
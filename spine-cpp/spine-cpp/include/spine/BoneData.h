@@ -43,6 +43,8 @@ namespace spine {
 
 		friend class AnimationState;
 
+		friend class BakedTimeline;
+
 		friend class RotateTimeline;
 
 		friend class ScaleTimeline;
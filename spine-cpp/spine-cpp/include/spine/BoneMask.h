@@ -0,0 +1,90 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated September 24, 2021. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2021, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_BoneMask_h
+#define Spine_BoneMask_h
+
+#include <spine/Vector.h>
+#include <spine/SpineObject.h>
+
+namespace spine {
+	class SkeletonData;
+
+	class BoneData;
+
+	class ConstraintData;
+
+	class Animation;
+
+	/// Stores the bones whose world transforms are needed, eg for hitboxes on a server, together with the ancestor bones,
+	/// constraints and constraint targets they depend on. See Skeleton::setBoneMask().
+	///
+	/// Bones and constraints outside the mask are not updated, and AnimationState does not apply timelines which only key
+	/// bones, slots and constraints outside the mask. Slots are in the mask when their bone is.
+	class SP_API BoneMask : public SpineObject {
+		friend class Skeleton;
+
+		friend class AnimationState;
+
+	public:
+		/// Computes the bones and constraints the specified bones depend on.
+		BoneMask(SkeletonData &skeletonData, Vector<BoneData *> &bones);
+
+		~BoneMask();
+
+		/// The bones in the mask, in the order of SkeletonData::getBones().
+		Vector<BoneData *> &getBones();
+
+		/// The IK, transform and path constraints in the mask.
+		Vector<ConstraintData *> &getConstraints();
+
+		bool containsBone(BoneData &bone);
+
+		/// Sets masked[i] to true when the animation's i-th timeline only keys bones, slots and constraints outside the mask.
+		void getMaskedTimelines(Animation &animation, Vector<bool> &masked);
+
+	private:
+		Vector<BoneData *> _bones;
+		Vector<ConstraintData *> _constraints;
+		Vector<bool> _boneFlags;
+		Vector<bool> _slotFlags;
+		Vector<bool> _ikConstraintFlags;
+		Vector<bool> _transformConstraintFlags;
+		Vector<bool> _pathConstraintFlags;
+
+		bool containsAny(Vector<BoneData *> &bones);
+
+		/// Adds the bones and their ancestors. Returns true if a bone was added.
+		bool addBones(Vector<BoneData *> &bones);
+
+		bool addBone(BoneData *bone);
+	};
+}
+
+#endif /* Spine_BoneMask_h */
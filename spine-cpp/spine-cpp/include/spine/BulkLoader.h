@@ -0,0 +1,115 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated September 24, 2021. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2021, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_BulkLoader_h
+#define Spine_BulkLoader_h
+
+#include <spine/Vector.h>
+#include <spine/SpineObject.h>
+#include <spine/SpineString.h>
+
+namespace spine {
+	class Atlas;
+
+	class SkeletonData;
+
+	class TextureLoader;
+
+	class BulkLoaderThread;
+
+	class BulkLoaderWorkers;
+
+	/// The outcome of loading one skeleton and atlas pair with BulkLoader.
+	class SP_API BulkLoadResult : public SpineObject {
+	public:
+		BulkLoadResult();
+
+		/// The index returned by BulkLoader::add().
+		int index;
+		String skeletonPath;
+		String atlasPath;
+		float scale;
+		/// Owned by the caller once returned by BulkLoader::poll(). NULL if loading failed.
+		Atlas *atlas;
+		/// Owned by the caller once returned by BulkLoader::poll(). NULL if loading failed.
+		SkeletonData *skeletonData;
+		/// Empty if loading succeeded.
+		String error;
+	};
+
+	/// Loads many skeleton and atlas pairs on a pool of worker threads. Atlases are parsed without creating textures, see
+	/// Atlas::createTextures(), and their textures are created on the thread calling poll(), so the texture loader does not
+	/// need to be thread safe. The SpineExtension must be set before the loader is created and must be thread safe.
+	///
+	/// The loader uses the C++11 thread library. It is only compiled when SPINE_BULK_LOADER is defined, eg with the CMake
+	/// option of the same name, and spine.h does not include this header.
+	class SP_API BulkLoader : public SpineObject {
+		friend class BulkLoaderThread;
+
+	public:
+		/// @param textureLoader Creates the textures of each atlas when its result is polled. May be NULL.
+		/// @param threadCount The number of worker threads, or 0 for the number of hardware threads.
+		explicit BulkLoader(TextureLoader *textureLoader, int threadCount = 0);
+
+		/// Waits for all queued pairs to be loaded, then disposes the results which were not polled.
+		~BulkLoader();
+
+		/// Queues a skeleton and atlas pair for loading. Skeleton files ending in .skel are read with SkeletonBinary, others
+		/// with SkeletonJson.
+		/// @return The index of the pair, counting from 0 in the order pairs were added.
+		int add(const String &skeletonPath, const String &atlasPath, float scale = 1);
+
+		/// Returns the next loaded pair in the order loading completed, after creating its textures on the calling thread.
+		/// @return False if no pair has completed since the last call.
+		bool poll(BulkLoadResult &result);
+
+		/// Blocks until all queued pairs are loaded. Their results are then available from poll().
+		void wait();
+
+		/// The number of queued pairs which are not loaded yet.
+		int getPendingCount();
+
+	private:
+		TextureLoader *_textureLoader;
+		BulkLoaderWorkers *_workers; // The worker threads and their synchronization, defined in BulkLoader.cpp.
+		Vector<BulkLoadResult *> _queued;
+		Vector<BulkLoadResult *> _completed;
+		size_t _nextQueued;
+		size_t _nextCompleted;
+		int _added;
+		int _pending;
+		bool _stop;
+
+		void run();
+
+		void load(BulkLoadResult &result);
+	};
+}
+
+#endif /* Spine_BulkLoader_h */
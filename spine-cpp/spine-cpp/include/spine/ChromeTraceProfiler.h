@@ -0,0 +1,83 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated September 24, 2021. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2021, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_ChromeTraceProfiler_h
+#define Spine_ChromeTraceProfiler_h
+
+#include <spine/SpineProfiler.h>
+#include <spine/SpineString.h>
+
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+namespace spine {
+	class DebugExtension;
+
+	/// Records zones and counters in the Chrome trace event format, which can be viewed with chrome://tracing or Perfetto.
+	/// Events are stored outside of SpineExtension so they do not affect allocation counts.
+	class SP_API ChromeTraceProfiler : public SpineProfiler {
+	public:
+		/// @param debugExtension If not NULL, each zone records the number of allocations and reallocations made while it
+		/// was open, on all threads.
+		explicit ChromeTraceProfiler(DebugExtension *debugExtension = NULL);
+
+		virtual void beginZone(const char *name);
+
+		virtual void endZone(const char *name);
+
+		virtual void counter(const char *name, double value);
+
+		/// Appends the recorded events as a JSON trace.
+		void write(String &json);
+
+		/// The number of recorded zone begin, zone end and counter events.
+		size_t getEventCount();
+
+		void clear();
+
+	private:
+		struct Event {
+			const char *name;
+			char phase;
+			size_t thread;
+			double time;
+			double value;
+		};
+
+		DebugExtension *_debugExtension;
+		std::chrono::steady_clock::time_point _start;
+		std::vector<Event> _events;
+		std::mutex _mutex;
+
+		void add(const char *name, char phase, double value);
+	};
+}
+
+#endif /* Spine_ChromeTraceProfiler_h */
@@ -0,0 +1,66 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated September 24, 2021. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2021, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_CompactVertices_h
+#define Spine_CompactVertices_h
+
+#include <spine/Vector.h>
+
+namespace spine {
+	/// Bone weighted vertices stored with quantized values, see VertexAttachment::compact(). Bone indices and counts take 8
+	/// bits if all are less than 256, else 16 bits. Local positions are 16 bit fixed point values scaled to the largest
+	/// coordinate of the attachment and weights are 16 bit normalized values, so each bone influence takes 7 or 8 bytes
+	/// instead of 16.
+	class SP_API CompactVertices : public SpineObject {
+		friend class VertexAttachment;
+
+	public:
+		/// @param bones See VertexAttachment::getBones().
+		/// @param vertices See VertexAttachment::getVertices().
+		CompactVertices(Vector<int> &bones, Vector<float> &vertices);
+
+		/// Decodes the quantized values to the format of VertexAttachment::getBones() and VertexAttachment::getVertices().
+		void decode(Vector<int> &bones, Vector<float> &vertices);
+
+		/// The number of bone influences, a third of the length VertexAttachment::getVertices() had before compacting.
+		size_t getInfluenceCount();
+
+		/// The size of the quantized values in bytes.
+		size_t getMemoryUsage();
+
+	private:
+		Vector<unsigned char> _bones8;
+		Vector<unsigned short> _bones16;
+		Vector<short> _positions;
+		Vector<unsigned short> _weights;
+		float _scale;
+	};
+}
+
+#endif /* Spine_CompactVertices_h */
@@ -55,13 +55,56 @@ namespace spine {
 
 		Vector<float> &getCurves();
 
+		/// Removes keyframes which can be linearly interpolated from the remaining keyframes without the curve deviating by more
+		/// than the tolerance. Linear, stepped and bezier segments are all considered, so eg a bezier that is nearly straight is
+		/// replaced by a linear segment, while segments that are kept retain their curve.
+		/// @return The number of keyframes removed.
+		size_t reduce(float tolerance);
+
+		/// Stores the bezier curve samples in 16 bits each, halving the memory of the curves: times as a fraction of their
+		/// segment, within the range of the fractions of all segments, and values within the range of the samples of the same
+		/// curve value, eg the x or y of a translation. The error of a value is at most half its range divided by 65535. Afterward reduce() and setBezier() must not be called.
+		void quantize();
+
+		bool isQuantized();
+
+		virtual size_t getMemoryUsage();
+
 	protected:
 		static const int LINEAR = 0;
 		static const int STEPPED = 1;
 		static const int BEZIER = 2;
 		static const int BEZIER_SIZE = 18;
 
+		/// Returns the largest difference between the values of a frame and the values linearly interpolated at its time between
+		/// the start and end frames.
+		virtual float getInterpolationError(size_t start, size_t frame, size_t end);
+
+		/// Returns the largest difference between the curve of the segment starting at a frame and the values linearly
+		/// interpolated between the start and end frames.
+		virtual float getCurveError(size_t start, size_t segment, size_t end);
+
+		/// Keeps only the specified frames, which are in ascending order and include the first and last frame.
+		virtual void keepFrames(Vector<size_t> &frames);
+
+		/// Returns the time of the bezier sample at the index in the curves, where the sample is a time.
+		inline float getBezierTime(size_t i, float time1, float time2) {
+			if (!_quantized) return _curves[i];
+			return time1 + (time2 - time1) * (_timeOffset + _packedCurves[i - _curves.size()] * _timeScale);
+		}
+
+		/// Returns the value of the bezier sample at the index in the curves, where the sample is a value of the curve value
+		/// with the index, counting from 0.
+		inline float getBezierSample(size_t i, size_t channel) {
+			if (!_quantized) return _curves[i];
+			return _valueRanges[channel << 1] + _packedCurves[i - _curves.size()] * _valueRanges[(channel << 1) + 1];
+		}
+
 		Vector<float> _curves; // type, x, y, ...
+		Vector<unsigned short> _packedCurves;
+		Vector<float> _valueRanges; // The offset and scale of the quantized samples of each curve value.
+		float _timeOffset, _timeScale; // The offset and scale of the quantized segment fractions of the sample times.
+		bool _quantized;
 	};
 
 	class SP_API CurveTimeline1 : public CurveTimeline {
@@ -76,6 +119,9 @@ namespace spine {
 
 		float getCurveValue(float time);
 
+		/// Sets values[i] to getCurveValue(times[i]). times and values may be the same array.
+		void getCurveValues(float *times, float *values, size_t count);
+
 	protected:
 		static const int ENTRIES = 2;
 		static const int VALUE = 1;
@@ -93,6 +139,10 @@ namespace spine {
 
 		float getCurveValue(float time);
 
+		/// Sets values1[i] and values2[i] to the values at times[i], which must be at or after the first frame. times and
+		/// values1 may be the same array.
+		void getCurveValues(float *times, float *values1, float *values2, size_t count);
+
 	protected:
 		static const int ENTRIES = 3;
 		static const int VALUE1 = 1;
@@ -34,6 +34,7 @@
 #include <spine/Vector.h>
 
 #include <map>
+#include <mutex>
 
 namespace spine {
 
@@ -53,10 +54,11 @@ namespace spine {
 
 	public:
 		DebugExtension(SpineExtension *extension) : _extension(extension), _allocations(0), _reallocations(0),
-													_frees(0) {
+													_frees(0), _usedMemory(0), _peakMemory(0) {
 		}
 
 		void reportLeaks() {
+			std::lock_guard<std::recursive_mutex> lock(_mutex);
 			for (std::map<void *, Allocation>::iterator it = _allocated.begin(); it != _allocated.end(); it++) {
 				printf("\"%s:%i (%zu bytes at %p)\n", it->second.fileName, it->second.line, it->second.size,
 					   it->second.address);
@@ -66,37 +68,46 @@ namespace spine {
 		}
 
 		void clearAllocations() {
+			std::lock_guard<std::recursive_mutex> lock(_mutex);
 			_allocated.clear();
 			_usedMemory = 0;
+			_peakMemory = 0;
 		}
 
 		virtual void *_alloc(size_t size, const char *file, int line) {
+			std::lock_guard<std::recursive_mutex> lock(_mutex);
 			void *result = _extension->_alloc(size, file, line);
 			_allocated[result] = Allocation(result, size, file, line);
 			_allocations++;
 			_usedMemory += size;
+			if (_usedMemory > _peakMemory) _peakMemory = _usedMemory;
 			return result;
 		}
 
 		virtual void *_calloc(size_t size, const char *file, int line) {
+			std::lock_guard<std::recursive_mutex> lock(_mutex);
 			void *result = _extension->_calloc(size, file, line);
 			_allocated[result] = Allocation(result, size, file, line);
 			_allocations++;
 			_usedMemory += size;
+			if (_usedMemory > _peakMemory) _peakMemory = _usedMemory;
 			return result;
 		}
 
 		virtual void *_realloc(void *ptr, size_t size, const char *file, int line) {
+			std::lock_guard<std::recursive_mutex> lock(_mutex);
 			if (_allocated.count(ptr)) _usedMemory -= _allocated[ptr].size;
 			_allocated.erase(ptr);
 			void *result = _extension->_realloc(ptr, size, file, line);
 			_reallocations++;
 			_allocated[result] = Allocation(result, size, file, line);
 			_usedMemory += size;
+			if (_usedMemory > _peakMemory) _peakMemory = _usedMemory;
 			return result;
 		}
 
 		virtual void _free(void *mem, const char *file, int line) {
+			std::lock_guard<std::recursive_mutex> lock(_mutex);
 			if (_allocated.count(mem)) {
 				_extension->_free(mem, file, line);
 				_frees++;
@@ -113,10 +124,48 @@ namespace spine {
 			return _extension->_readFile(path, length);
 		}
 
+		virtual void *_createMutex() {
+			return _extension->_createMutex();
+		}
+
+		virtual void _lockMutex(void *mutex) {
+			_extension->_lockMutex(mutex);
+		}
+
+		virtual void _unlockMutex(void *mutex) {
+			_extension->_unlockMutex(mutex);
+		}
+
+		virtual void _disposeMutex(void *mutex) {
+			_extension->_disposeMutex(mutex);
+		}
+
 		size_t getUsedMemory() {
+			std::lock_guard<std::recursive_mutex> lock(_mutex);
 			return _usedMemory;
 		}
 
+		size_t getAllocations() {
+			std::lock_guard<std::recursive_mutex> lock(_mutex);
+			return _allocations;
+		}
+
+		size_t getReallocations() {
+			std::lock_guard<std::recursive_mutex> lock(_mutex);
+			return _reallocations;
+		}
+
+		/// The largest used memory since the extension was created or resetPeakMemory() was called.
+		size_t getPeakMemory() {
+			std::lock_guard<std::recursive_mutex> lock(_mutex);
+			return _peakMemory;
+		}
+
+		void resetPeakMemory() {
+			std::lock_guard<std::recursive_mutex> lock(_mutex);
+			_peakMemory = _usedMemory;
+		}
+
 	private:
 		SpineExtension *_extension;
 		std::map<void *, Allocation> _allocated;
@@ -124,6 +173,10 @@ namespace spine {
 		size_t _reallocations;
 		size_t _frees;
 		size_t _usedMemory;
+		size_t _peakMemory;
+		// Allocations may come from several threads, eg when using BulkLoader. Recursive because the wrapped extension
+		// may allocate through SpineExtension again.
+		std::recursive_mutex _mutex;
 	};
 }
 
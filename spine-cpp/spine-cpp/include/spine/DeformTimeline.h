@@ -35,6 +35,8 @@
 namespace spine {
 	class VertexAttachment;
 
+	class Slot;
+
 	class SP_API DeformTimeline : public CurveTimeline {
 		friend class SkeletonBinary;
 
@@ -49,10 +51,24 @@ namespace spine {
 		apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha, MixBlend blend,
 			  MixDirection direction);
 
-		/// Sets the time and value of the specified keyframe.
+		/// Sets the time and value of the specified keyframe. Only the range of vertices which differ from the attachment's setup
+		/// pose is stored, as offsets from the setup pose.
+		/// @param vertices Vertex positions for an unweighted VertexAttachment, or deform offsets if it has weights.
 		void setFrame(int frameIndex, float time, Vector<float> &vertices);
 
-		Vector <Vector<float>> &getVertices();
+		/// Stores the vertex positions or deform offsets of the specified keyframe in the vertices, see setFrame().
+		void getFrameVertices(size_t frame, Vector<float> &vertices);
+
+		/// The first vertex component of the specified keyframe that differs from the setup pose.
+		int getFrameStart(size_t frame);
+
+		/// One past the last vertex component of the specified keyframe that differs from the setup pose.
+		int getFrameEnd(size_t frame);
+
+		/// The vertex positions or deform offsets of every keyframe, decoded on each call with getFrameVertices(). Changing the
+		/// returned vertices does not change the timeline, use setFrame() instead.
+		/// @deprecated Allocates a copy of every keyframe, use getFrameVertices().
+		Vector<Vector<float> > &getVertices();
 
 		VertexAttachment *getAttachment();
 
@@ -68,12 +84,45 @@ namespace spine {
 
 		void setSlotIndex(int inValue) { _slotIndex = inValue; }
 
+		/// Removes keyframes using half the tolerance (see CurveTimeline::reduce()), then trims each remaining keyframe's range to
+		/// the vertices that differ from the setup pose by more than the other half and quantizes its offsets and the curves
+		/// to 16 bits, see CurveTimeline::quantize(). Afterward setFrame() must not be called.
+		/// @param tolerance The largest allowed difference for a vertex position or offset.
+		void compress(float tolerance);
+
+		bool isCompressed();
+
+		virtual size_t getMemoryUsage();
+
 	protected:
-		int _slotIndex;
+		virtual float getInterpolationError(size_t start, size_t frame, size_t end);
 
-		Vector <Vector<float>> _vertices;
+		virtual float getCurveError(size_t start, size_t segment, size_t end);
+
+		virtual void keepFrames(Vector<size_t> &frames);
+
+		int _slotIndex;
 
 		VertexAttachment *_attachment;
+
+	private:
+		static const int RANGE_ENTRIES = 3;
+		static const int RANGE_START = 0;
+		static const int RANGE_END = 1;
+		static const int RANGE_OFFSET = 2;
+
+		float getOffset(size_t frame, size_t i);
+
+		void addOffsets(Slot &slot, size_t frame, float alpha);
+
+		size_t _vertexCount;
+
+		Vector<int> _ranges; // start, end, offset in _offsets or _packedOffsets for each frame
+		Vector<float> _offsets;
+		Vector<short> _packedOffsets;
+		float _packedScale;
+		bool _compressed;
+		Vector<Vector<float> > _vertices; // Filled by getVertices() only.
 	};
 }
 
@@ -53,6 +53,8 @@ namespace spine {
 
 		Vector <Vector<int>> &getDrawOrders();
 
+		virtual size_t getMemoryUsage();
+
 	private:
 		Vector <Vector<int>> _drawOrders;
 	};
@@ -0,0 +1,127 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated September 24, 2021. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2021, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_EventBuffer_h
+#define Spine_EventBuffer_h
+
+#include <spine/AnimationState.h>
+#include <spine/SpineObject.h>
+
+#include <atomic>
+
+namespace spine {
+	class Event;
+
+	class EventData;
+
+	/// A compact record of an AnimationState event, see AnimationState::setEventBuffer().
+	class SP_API EventRecord {
+	public:
+		EventRecord();
+
+		EventRecord(AnimationState *animationState, EventType eventType, TrackEntry *entry, Event *trackEvent);
+
+		/// The state which queued the event. Only meant to identify the state, it may be updated while the record is read.
+		AnimationState *state;
+
+		EventType type;
+
+		/// The index of the track of the entry.
+		int trackIndex;
+
+		/// The id of the entry, see TrackEntry::getId(). The entry itself may be disposed by the time the record is read.
+		int entryId;
+
+		/// The event for EventType_Event, NULL for other types. Events are owned by the EventTimeline of their animation, so
+		/// the animation must not be evicted, see SkeletonData::evictAnimation(), or deleted, and its timelines must not be
+		/// replaced while records referencing its events are pending. The fields below are copied from the event and can be
+		/// read regardless.
+		Event *event;
+
+		/// The time of the event for EventType_Event, otherwise the track time of the entry.
+		float time;
+
+		/// The data of the event for EventType_Event, owned by the SkeletonData. NULL for other types.
+		const EventData *data;
+
+		/// The values of the event for EventType_Event, otherwise 0.
+		int intValue;
+
+		float floatValue;
+
+		float volume;
+
+		float balance;
+	};
+
+	/// A fixed capacity queue of event records which AnimationStates add to when they are drained, instead of calling their
+	/// listeners. Records can be added by one thread and read by another without locks, eg to hand events from the thread
+	/// updating the skeletons to an audio thread. Several AnimationStates can share a buffer if they are updated from the
+	/// same thread.
+	class SP_API EventBuffer : public SpineObject {
+	public:
+		explicit EventBuffer(size_t capacity);
+
+		~EventBuffer();
+
+		/// Adds a record, called by the producer. Returns false and drops the record if the buffer is full.
+		bool add(const EventRecord &record);
+
+		/// Removes the oldest record, called by the consumer. Returns false if the buffer is empty.
+		bool poll(EventRecord &record);
+
+		/// The number of records which can be read. When records are added or read at the same time, this is only a snapshot
+		/// between 0 and the capacity.
+		size_t size();
+
+		size_t getCapacity();
+
+		/// The number of records which were dropped because the buffer was full.
+		size_t getDroppedCount();
+
+		/// Removes all records. Must not be called while records are added or read.
+		void clear();
+
+	private:
+		static const size_t CACHE_LINE_SIZE = 64;
+
+		// The head is written by the consumer and the tail by the producer. The padding keeps them on separate cache lines,
+		// and away from the fields which both only read.
+		EventRecord *_records;
+		size_t _capacity;
+		char _headPadding[CACHE_LINE_SIZE];
+		std::atomic<size_t> _head;
+		char _tailPadding[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+		std::atomic<size_t> _tail;
+		std::atomic<size_t> _dropped;
+		char _endPadding[CACHE_LINE_SIZE - 2 * sizeof(std::atomic<size_t>)];
+	};
+}
+
+#endif /* Spine_EventBuffer_h */
@@ -54,6 +54,8 @@ namespace spine {
 
 		Vector<Event *> &getEvents();
 
+		virtual size_t getMemoryUsage();
+
 	private:
 		Vector<Event *> _events;
 	};
@@ -70,6 +70,22 @@ namespace spine {
 			return getInstance()->_readFile(path, length);
 		}
 
+		static void *createMutex() {
+			return getInstance()->_createMutex();
+		}
+
+		static void lockMutex(void *mutex) {
+			getInstance()->_lockMutex(mutex);
+		}
+
+		static void unlockMutex(void *mutex) {
+			getInstance()->_unlockMutex(mutex);
+		}
+
+		static void disposeMutex(void *mutex) {
+			getInstance()->_disposeMutex(mutex);
+		}
+
 		static void setInstance(SpineExtension *inSpineExtension);
 
 		static SpineExtension *getInstance();
@@ -90,6 +106,17 @@ namespace spine {
 
 		virtual void _beforeFree(void *ptr) { SP_UNUSED(ptr); }
 
+		/// Implement these functions to use your platform's mutex, eg when the C++11 thread library is not available. The runtime
+		/// only creates mutexes for data which may be used by several threads, eg lazily read animations. The default uses
+		/// std::mutex.
+		virtual void *_createMutex();
+
+		virtual void _lockMutex(void *mutex);
+
+		virtual void _unlockMutex(void *mutex);
+
+		virtual void _disposeMutex(void *mutex);
+
 	protected:
 		SpineExtension();
 
@@ -87,23 +87,44 @@ namespace spine {
 
 		HashMap() :
 				_head(NULL),
-				_size(0) {
+				_size(0),
+				_free(NULL),
+				_freeCount(0),
+				_capacity(0) {
 		}
 
 		~HashMap() {
+			_capacity = 0;
 			clear();
+			for (Entry *entry = _free; entry != NULL;) {
+				Entry *next = entry->next;
+				delete entry;
+				entry = next;
+			}
 		}
 
 		void clear() {
 			for (Entry *entry = _head; entry != NULL;) {
 				Entry *next = entry->next;
-				delete entry;
+				recycle(entry);
 				entry = next;
 			}
 			_head = NULL;
 			_size = 0;
 		}
 
+		/// Preallocates entries so up to capacity keys can be put without allocating. Entries of keys which are removed or
+		/// cleared are then kept for reuse, up to the capacity.
+		void ensureCapacity(size_t capacity) {
+			for (size_t count = _size + _freeCount; count < capacity; count++) {
+				Entry *entry = new (__FILE__, __LINE__) Entry();
+				entry->next = _free;
+				_free = entry;
+				_freeCount++;
+			}
+			if (_capacity < capacity) _capacity = capacity;
+		}
+
 		size_t size() {
 			return _size;
 		}
@@ -114,7 +135,13 @@ namespace spine {
 				entry->_key = key;
 				entry->_value = value;
 			} else {
-				entry = new(__FILE__, __LINE__) Entry();
+				if (_free) {
+					entry = _free;
+					_free = entry->next;
+					_freeCount--;
+					entry->next = NULL;
+				} else
+					entry = new(__FILE__, __LINE__) Entry();
 				entry->_key = key;
 				entry->_value = value;
 
@@ -154,7 +181,7 @@ namespace spine {
 			else _head = next;
 			if (next) next->prev = entry->prev;
 
-			delete entry;
+			recycle(entry);
 			_size--;
 
 			return true;
@@ -174,6 +201,17 @@ namespace spine {
 		}
 
 	private:
+		void recycle(Entry *entry) {
+			if (_freeCount >= _capacity) {
+				delete entry;
+				return;
+			}
+			entry->prev = NULL;
+			entry->next = _free;
+			_free = entry;
+			_freeCount++;
+		}
+
 		Entry *find(const K &key) {
 			for (Entry *entry = _head; entry != NULL; entry = entry->next) {
 				if (entry->_key == key)
@@ -194,6 +232,9 @@ namespace spine {
 
 		Entry *_head;
 		size_t _size;
+		Entry *_free;
+		size_t _freeCount;
+		size_t _capacity;
 	};
 }
 
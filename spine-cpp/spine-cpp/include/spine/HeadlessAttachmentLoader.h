@@ -0,0 +1,62 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated September 24, 2021. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2021, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_HeadlessAttachmentLoader_h
+#define Spine_HeadlessAttachmentLoader_h
+
+#include <spine/AttachmentLoader.h>
+
+namespace spine {
+	/// An AttachmentLoader for skeletons that are posed but never drawn, eg on a server. Attachments are created without
+	/// texture regions, so no Atlas is needed. Region attachments are sized as if their images were not whitespace stripped,
+	/// so their bounds may be larger than with an atlas. Use it with SkeletonBinary::setHeadless() or SkeletonJson::setHeadless() to
+	/// also strip the remaining render-only data.
+	class SP_API HeadlessAttachmentLoader : public AttachmentLoader {
+	public:
+	RTTI_DECL
+
+		HeadlessAttachmentLoader();
+
+		virtual RegionAttachment *newRegionAttachment(Skin &skin, const String &name, const String &path, Sequence *sequence);
+
+		virtual MeshAttachment *newMeshAttachment(Skin &skin, const String &name, const String &path, Sequence *sequence);
+
+		virtual BoundingBoxAttachment *newBoundingBoxAttachment(Skin &skin, const String &name);
+
+		virtual PathAttachment *newPathAttachment(Skin &skin, const String &name);
+
+		virtual PointAttachment *newPointAttachment(Skin &skin, const String &name);
+
+		virtual ClippingAttachment *newClippingAttachment(Skin &skin, const String &name);
+
+		virtual void configureAttachment(Attachment *attachment);
+	};
+}
+
+#endif /* Spine_HeadlessAttachmentLoader_h */
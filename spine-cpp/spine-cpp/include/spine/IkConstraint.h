@@ -44,6 +44,8 @@ namespace spine {
 	class SP_API IkConstraint : public Updatable {
 		friend class Skeleton;
 
+		friend class SkeletonSnapshot;
+
 		friend class IkConstraintTimeline;
 
 	RTTI_DECL
@@ -74,8 +74,6 @@ namespace spine {
 
 
 	private:
-		static const char *_error;
-
 		Json *_next;
 #if SPINE_JSON_HAVE_PREV
 		Json* _prev; /* next/prev allow you to walk array/object chains. Alternatively, use getSize/getItem */
@@ -0,0 +1,72 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated September 24, 2021. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2021, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_LodLevel_h
+#define Spine_LodLevel_h
+
+#include <spine/Vector.h>
+#include <spine/SpineObject.h>
+
+namespace spine {
+	class BoneData;
+
+	class ConstraintData;
+
+	/// Stores the bones and constraints that are not fully updated at a reduced level of detail. See Skeleton::setLodLevel().
+	///
+	/// Excluded bones and all their descendants rigidly follow their parent bone using their setup pose local transform,
+	/// ignoring their local transform. Excluded constraints and constraints which constrain an excluded bone are not applied.
+	class SP_API LodLevel : public SpineObject {
+		friend class Skeleton;
+
+	public:
+		explicit LodLevel(int maxBoneDepth = -1);
+
+		~LodLevel();
+
+		/// The bones which, together with their descendants, rigidly follow their parent at this level.
+		Vector<BoneData *> &getBones();
+
+		/// The IK, transform and path constraints which are not applied at this level.
+		Vector<ConstraintData *> &getConstraints();
+
+		/// Bones more than this many levels below the root bone rigidly follow their parent at this level. -1 disables the depth
+		/// limit.
+		int getMaxBoneDepth();
+
+		void setMaxBoneDepth(int inValue);
+
+	private:
+		Vector<BoneData *> _bones;
+		Vector<ConstraintData *> _constraints;
+		int _maxBoneDepth;
+	};
+}
+
+#endif /* Spine_LodLevel_h */
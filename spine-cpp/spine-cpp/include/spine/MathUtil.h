@@ -37,6 +37,8 @@
 #undef min
 #undef max
 
+// Define SPINE_FAST_TRIG to enable fast trigonometry by default, see MathUtil::setFastTrig().
+
 namespace spine {
 
 	class SP_API MathUtil : public SpineObject {
@@ -61,22 +63,30 @@ namespace spine {
 
 		static float abs(float v);
 
-		/// Returns the sine in radians from a lookup table.
+		/// Returns the sine in radians, from a lookup table if fast trigonometry is enabled.
 		static float sin(float radians);
 
-		/// Returns the cosine in radians from a lookup table.
+		/// Returns the cosine in radians, from a lookup table if fast trigonometry is enabled.
 		static float cos(float radians);
 
-		/// Returns the sine in radians from a lookup table.
+		/// Returns the sine in degrees, from a lookup table if fast trigonometry is enabled.
 		static float sinDeg(float degrees);
 
-		/// Returns the cosine in radians from a lookup table.
+		/// Returns the cosine in degrees, from a lookup table if fast trigonometry is enabled.
 		static float cosDeg(float degrees);
 
-		/// Returns atan2 in radians, faster but less accurate than Math.Atan2. Average error of 0.00231 radians (0.1323
-		/// degrees), largest error of 0.00488 radians (0.2796 degrees).
+		/// Returns atan2 in radians, from a polynomial approximation if fast trigonometry is enabled.
 		static float atan2(float y, float x);
 
+		/// If true, sin(), cos(), sinDeg() and cosDeg() use a 16384 entry lookup table with a largest error of 0.0002 for
+		/// angles within +-10000 degrees, and atan2() uses a polynomial with a largest error of 0.00002 radians (0.001
+		/// degrees). Default is false, or true if SPINE_FAST_TRIG is defined. The table is built when fast trigonometry is
+		/// first enabled. This must be called before any skeleton is updated, and not while other threads pose skeletons,
+		/// as the setting and the table are not synchronized across threads.
+		static void setFastTrig(bool inValue);
+
+		static bool isFastTrig();
+
 		static float acos(float v);
 
 		static float sqrt(float v);
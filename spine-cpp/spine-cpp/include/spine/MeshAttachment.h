@@ -46,6 +46,8 @@ namespace spine {
 
 		friend class AtlasAttachmentLoader;
 
+		friend class SkeletonData;
+
 	RTTI_DECL
 
 	public:
@@ -64,6 +66,7 @@ namespace spine {
 
 		void setHullLength(int inValue);
 
+		/// Empty after compact(), which stores the region UVs as 16 bit normalized values.
 		Vector<float> &getRegionUVs();
 
 		/// The UV pair for each vertex, normalized within the entire texture. See also MeshAttachment::updateRegion
@@ -104,10 +107,15 @@ namespace spine {
 
 		MeshAttachment *newLinkedMesh();
 
+		/// Also stores the region UVs as 16 bit normalized values. The UVs computed by updateRegion() are not compacted,
+		/// since renderers read them.
+		virtual void compact();
+
 	private:
 		MeshAttachment *_parentMesh;
 		Vector<float> _uvs;
 		Vector<float> _regionUVs;
+		Vector<unsigned short> _compactRegionUVs;
 		Vector<unsigned short> _triangles;
 		Vector<unsigned short> _edges;
 		String _path;
@@ -116,6 +124,8 @@ namespace spine {
 		int _width, _height;
 		TextureRegion *_region;
 		Sequence *_sequence;
+
+		float getRegionUV(int index);
 	};
 }
 
@@ -59,6 +59,9 @@ namespace spine {
 
 		virtual Attachment *copy();
 
+		/// Does nothing, path constraints and bone masks need the bone indices of getBones().
+		virtual void compact();
+
 	private:
 		Vector<float> _lengths;
 		bool _closed;
@@ -48,6 +48,8 @@ namespace spine {
 	class SP_API PathConstraint : public Updatable {
 		friend class Skeleton;
 
+		friend class SkeletonSnapshot;
+
 		friend class PathConstraintMixTimeline;
 
 		friend class PathConstraintPositionTimeline;
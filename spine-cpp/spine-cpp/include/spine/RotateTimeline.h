@@ -49,6 +49,10 @@ namespace spine {
 		apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha, MixBlend blend,
 			  MixDirection direction);
 
+		virtual void
+		applyBatch(Skeleton **skeletons, float *lastTimes, float *times, size_t count, Vector<Event *> **pEvents,
+				   float alpha, MixBlend blend, MixDirection direction);
+
 		int getBoneIndex() { return _boneIndex; }
 
 		void setBoneIndex(int inValue) { _boneIndex = inValue; }
@@ -55,11 +55,23 @@ namespace spine {
 
 	class Attachment;
 
+	class ConstraintData;
+
+	class BoneMask;
+
 	class SP_API Skeleton : public SpineObject {
 		friend class AnimationState;
 
+		friend class Bone;
+
+		friend class BakedTimeline;
+
 		friend class SkeletonBounds;
 
+		friend class SkinCache;
+
+		friend class SkeletonSnapshot;
+
 		friend class SkeletonClipping;
 
 		friend class AttachmentTimeline;
@@ -220,6 +232,30 @@ namespace spine {
 
 		void setScaleY(float inValue);
 
+		/// The level of detail, 0 for the full skeleton. Level n uses SkeletonData::getLodLevels()[n - 1]. Changing the level
+		/// calls updateCache().
+		size_t getLodLevel();
+
+		void setLodLevel(size_t inValue);
+
+		/// When set, only the bones and constraints in the mask are updated and AnimationState only applies timelines which key
+		/// them. Bones outside the mask keep their previous world transform. Changing the mask calls updateCache(). May be
+		/// NULL.
+		void setBoneMask(BoneMask *inValue);
+
+		BoneMask *getBoneMask();
+
+		/// If true, updateWorldTransform() only computes the world transform of bones whose applied transform differs from
+		/// when it was last computed, whose world transform was changed by a constraint or Bone setter since, or whose parent's
+		/// world transform was computed. Constraints are always applied. This saves work for partially animated skeletons.
+		/// Default is false.
+		void setIncremental(bool inValue);
+
+		bool isIncremental();
+
+		/// The number of bones whose world transform was computed by the last updateWorldTransform().
+		int getUpdatedBoneCount();
+
 	private:
 		SkeletonData *_data;
 		Vector<Bone *> _bones;
@@ -233,6 +269,29 @@ namespace spine {
 		Color _color;
 		float _scaleX, _scaleY;
 		float _x, _y;
+		size_t _lodLevel;
+		BoneMask *_boneMask;
+		bool _incremental;
+		bool _updateAll;
+		unsigned int _updateFrame;
+		int _updatedBones;
+		float _updateX, _updateY, _updateScaleX, _updateScaleY;
+
+		void attachSkin(Skin *newSkin);
+
+		/// Starts a world transform update, see setIncremental().
+		void beginUpdate();
+
+		/// Stores the update cache as bone and constraint indices, see SkinCache.
+		void getUpdateCache(Vector<int> &indices);
+
+		/// Restores the update cache stored by getUpdateCache(), instead of sorting the bones and constraints.
+		void setUpdateCache(Vector<int> &indices);
+
+		void updateLodBones();
+
+		/// Returns true if the constraint is excluded by the level of detail or the bone mask.
+		bool isExcluded(ConstraintData &constraintData, Vector<Bone *> &constrained);
 
 		void sortIkConstraint(IkConstraint *constraint);
 
@@ -64,6 +64,8 @@ namespace spine {
 	class Sequence;
 
 	class SP_API SkeletonBinary : public SpineObject {
+		friend class SkeletonData;
+
 	public:
 		static const int BONE_ROTATE = 0;
 		static const int BONE_TRANSLATE = 1;
@@ -106,6 +108,22 @@ namespace spine {
 
 		void setScale(float scale) { _scale = scale; }
 
+		/// If true, readSkeletonData() only records where each animation is stored and computes its duration. The timelines
+		/// of an animation are decoded the first time it is found with SkeletonData::findAnimation() or decoded with
+		/// SkeletonData::decodeAnimation(). Until then, the animation has no timelines. Default is false.
+		void setLazyAnimations(bool lazyAnimations) { _lazyAnimations = lazyAnimations; }
+
+		/// If true, readSkeletonData() strips data that is only needed for rendering, see SkeletonData::stripRenderData().
+		/// Use a HeadlessAttachmentLoader to also skip texture regions, so no Atlas is needed. Default is false.
+		/// @param vertices If false, mesh vertices and the deform timelines of meshes are stripped too. Default is true.
+		void setHeadless(bool headless, bool vertices = true) {
+			_headless = headless;
+			_headlessVertices = vertices;
+		}
+
+		/// If true, readSkeletonData() calls SkeletonData::compactAttachments(). Default is false.
+		void setCompactAttachments(bool compactAttachments) { _compactAttachments = compactAttachments; }
+
 		String &getError() { return _error; }
 
 	private:
@@ -119,6 +137,13 @@ namespace spine {
 		String _error;
 		float _scale;
 		const bool _ownsLoader;
+		bool _lazyAnimations;
+		bool _headless;
+		bool _headlessVertices;
+		bool _compactAttachments;
+
+		/// Only for decoding lazily read animations, which does not use an attachment loader.
+		explicit SkeletonBinary(float scale);
 
 		void setError(const char *value1, const char *value2);
 
@@ -155,6 +180,10 @@ namespace spine {
 
 		Animation *readAnimation(const String &name, DataInput *input, SkeletonData *skeletonData);
 
+		bool skipAnimation(DataInput *input, SkeletonData *skeletonData, float &duration);
+
+		void skipFrames(DataInput *input, int frameCount, int valueSize, int curveCount, int extraSize, float &duration);
+
 		void
 		setBezier(DataInput *input, CurveTimeline *timeline, int bezier, int frame, int value, float time1, float time2,
 				  float value1, float value2, float scale);
@@ -50,6 +50,9 @@ namespace spine {
 
 	class PathConstraintData;
 
+	class LodLevel;
+
+
 /// Stores the setup pose and all of the stateless data for a skeleton.
 	class SP_API SkeletonData : public SpineObject {
 		friend class SkeletonBinary;
@@ -77,6 +80,8 @@ namespace spine {
 		/// @return May be NULL.
 		spine::EventData *findEvent(const String &eventDataName);
 
+		/// If the skeleton data was read with SkeletonBinary::setLazyAnimations(), the timelines of the animation are decoded
+		/// before it is returned.
 		/// @return May be NULL.
 		Animation *findAnimation(const String &animationName);
 
@@ -118,6 +123,40 @@ namespace spine {
 
 		Vector<PathConstraintData *> &getPathConstraints();
 
+		/// Decodes the timelines of an animation read with SkeletonBinary::setLazyAnimations(), if they are not decoded yet.
+		/// Does nothing for animations that were decoded when the skeleton data was read. Can be called from multiple threads.
+		void decodeAnimation(Animation *animation);
+
+		/// Decodes the timelines of all animations, see decodeAnimation().
+		void decodeAnimations();
+
+		/// Frees the timelines of an animation read with SkeletonBinary::setLazyAnimations(). They are decoded again the next
+		/// time the animation is found or decoded. The animation must not be in use by an AnimationState or be applied while
+		/// it is evicted. Changes made to the timelines, eg by Animation::compress(), are lost.
+		void evictAnimation(Animation *animation);
+
+		/// Frees the timelines of all lazily read animations, see evictAnimation().
+		void evictAnimations();
+
+		/// Returns false if the animation was read with SkeletonBinary::setLazyAnimations() and its timelines are not decoded.
+		bool isAnimationDecoded(Animation *animation);
+
+		/// Frees data that is only needed to render the skeleton: mesh UVs, triangles and edges, and color and sequence
+		/// timelines. Bones, constraints, the remaining timelines, bounding boxes and paths are kept, so skeletons can still be
+		/// posed and their bounds computed. Lazily read animations are stripped when they are decoded.
+		/// @param vertices If false, mesh vertices and the deform timelines of meshes are freed too. Lazily read animations are decoded
+		/// first, since decoding deform timelines requires the mesh vertices, and are no longer lazy: evictAnimation() does nothing
+		/// afterward. Meshes are then left out of Skeleton::getBounds().
+		void stripRenderData(bool vertices);
+
+		/// Calls MeshAttachment::compact() for the meshes of all skins, which stores bone weighted vertices and region UVs as
+		/// quantized values. Other attachments are not compacted.
+		void compactAttachments();
+
+		/// The reduced levels of detail, see Skeleton::setLodLevel(). Level 0 is the full skeleton, level n uses the (n - 1)th
+		/// entry. Owned by the SkeletonData.
+		Vector<LodLevel *> &getLodLevels();
+
 		float getX();
 
 		void setX(float inValue);
@@ -167,15 +206,30 @@ namespace spine {
 		Vector<IkConstraintData *> _ikConstraints;
 		Vector<TransformConstraintData *> _transformConstraints;
 		Vector<PathConstraintData *> _pathConstraints;
+		Vector<LodLevel *> _lodLevels;
 		float _x, _y, _width, _height;
 		String _version;
 		String _hash;
 		Vector<char *> _strings;
 
+		// Lazily decoded animations.
+		unsigned char *_animationData;
+		int _animationDataLength;
+		float _animationScale;
+		Vector<int> _animationOffsets;
+		Vector<bool> _animationDecoded;
+		void *_animationLock; // Guards decoding and evicting animations, see SpineExtension::createMutex(). NULL if not lazy.
+		bool _renderDataStripped;
+		bool _verticesStripped;
+
 		// Nonessential.
 		float _fps;
 		String _imagesPath;
 		String _audioPath;
+
+		void decodeAnimation(size_t index);
+
+		void stripTimelines(Animation *animation);
 	};
 }
 
@@ -75,6 +75,17 @@ namespace spine {
 
 		void setScale(float scale) { _scale = scale; }
 
+		/// If true, readSkeletonData() strips data that is only needed for rendering, see SkeletonData::stripRenderData().
+		/// Use a HeadlessAttachmentLoader to also skip texture regions, so no Atlas is needed. Default is false.
+		/// @param vertices If false, mesh vertices and the deform timelines of meshes are stripped too. Default is true.
+		void setHeadless(bool headless, bool vertices = true) {
+			_headless = headless;
+			_headlessVertices = vertices;
+		}
+
+		/// If true, readSkeletonData() calls SkeletonData::compactAttachments(). Default is false.
+		void setCompactAttachments(bool compactAttachments) { _compactAttachments = compactAttachments; }
+
 		String &getError() { return _error; }
 
 	private:
@@ -83,6 +94,9 @@ namespace spine {
 		float _scale;
 		const bool _ownsLoader;
 		String _error;
+		bool _headless;
+		bool _headlessVertices;
+		bool _compactAttachments;
 
 		static Sequence *readSequence(Json *sequence);
 
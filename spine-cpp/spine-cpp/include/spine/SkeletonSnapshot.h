@@ -0,0 +1,89 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated September 24, 2021. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2021, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_SkeletonSnapshot_h
+#define Spine_SkeletonSnapshot_h
+
+#include <spine/Vector.h>
+#include <spine/SpineObject.h>
+
+namespace spine {
+	class Skeleton;
+
+	class AnimationState;
+
+	class TrackEntry;
+
+	/// Stores the complete runtime state of a skeleton and optionally its animation state in one flat buffer, eg to roll
+	/// back and resimulate frames. The state includes bones, slots, deforms, constraints, draw order, skin, level of detail
+	/// and track entries with their mixing and queued entries.
+	///
+	/// The buffer references skins, attachments, animations and listeners by address, so it can be copied with memcpy but
+	/// is only valid in the process that saved it, while the SkeletonData is alive. Snapshots reuse their memory, so
+	/// saving the same snapshot repeatedly does not allocate once it has grown to the skeleton's size.
+	class SP_API SkeletonSnapshot : public SpineObject {
+	public:
+		/// The version of the buffer format, which is stored in the buffer.
+		static const int Version;
+
+		SkeletonSnapshot();
+
+		/// Stores the state of the skeleton and, if not NULL, the animation state. The animation state must not be saved
+		/// from an AnimationStateListener.
+		void save(Skeleton &skeleton, AnimationState *state = NULL);
+
+		/// Restores the state stored by save(). The skeleton must use the same SkeletonData and the animation state must be
+		/// NULL if and only if it was NULL when saving. Track entries of the animation state are returned to its pool without
+		/// events and replaced by new ones, so previously obtained TrackEntry pointers must not be used. Renderer objects of
+		/// track entries are not restored.
+		/// @return false if the snapshot is empty, has a different version or was saved for a different skeleton.
+		bool restore(Skeleton &skeleton, AnimationState *state = NULL);
+
+		/// The stored state.
+		const char *getData();
+
+		/// The number of bytes returned by getData().
+		size_t getSize();
+
+		/// Replaces the stored state with a copy of a buffer returned by getData().
+		void setData(const char *data, size_t size);
+
+	private:
+		Vector<char> _buffer;
+		Vector<TrackEntry *> _entries;
+
+		void write(char *data, Skeleton &skeleton, AnimationState *state, size_t &size);
+
+		void collectEntry(TrackEntry *entry);
+
+		int entryIndex(TrackEntry *entry);
+	};
+}
+
+#endif /* Spine_SkeletonSnapshot_h */
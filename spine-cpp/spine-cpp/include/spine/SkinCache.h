@@ -0,0 +1,92 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated September 24, 2021. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2021, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_SkinCache_h
+#define Spine_SkinCache_h
+
+#include <spine/Vector.h>
+#include <spine/SpineObject.h>
+
+namespace spine {
+	class Skin;
+
+	class Skeleton;
+
+	/// Caches skins composed from an ordered list of source skins, eg the parts of a customizable character. Each combination
+	/// of skins is composed once and shared by all skeletons using it, together with the skeleton update cache computed the
+	/// first time it is set on a skeleton. Skeletons using a cached skin must use the same SkeletonData as the cache.
+	/// See Skin::addSkin(). Composed skins are looked up by a hash of the source skins. The cache is not thread safe, each thread
+	/// must use its own cache or synchronize calls to it.
+	class SP_API SkinCache : public SpineObject {
+	public:
+		SkinCache();
+
+		~SkinCache();
+
+		/// Returns the skin with the attachments, bones and constraints of all the specified skins, with later skins replacing
+		/// attachments of earlier ones. The skin is owned by the cache and must not be modified.
+		Skin *getSkin(Vector<Skin *> &skins);
+
+		/// Sets the composed skin for the specified skins on the skeleton, see Skeleton::setSkin(). Unlike
+		/// Skeleton::setSkin(), the skeleton's update cache is restored from the cache when the skin was set on a skeleton
+		/// with the same level of detail before and the skeleton has no bone mask.
+		void setSkin(Skeleton &skeleton, Vector<Skin *> &skins);
+
+		/// The number of composed skins.
+		size_t size();
+
+		/// Disposes all composed skins. Skeletons must not be using them.
+		void clear();
+
+	private:
+		class Entry : public SpineObject {
+		public:
+			Entry(size_t hash, Vector<Skin *> &skins);
+
+			~Entry();
+
+			size_t _hash;
+			Vector<Skin *> _skins;
+			Skin *_skin;
+			Vector<int> _updateCache;
+			int _lodLevel;
+			Entry *_next; // Next entry in the same bucket.
+		};
+
+		Entry &getEntry(Vector<Skin *> &skins);
+
+		void resize(size_t bucketCount);
+
+		Vector<Entry *> _entries;
+		Vector<Entry *> _buckets; // The first entry of each bucket, the bucket count is a power of two.
+		size_t _mask;
+	};
+}
+
+#endif /* Spine_SkinCache_h */
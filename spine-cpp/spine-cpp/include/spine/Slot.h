@@ -52,6 +52,8 @@ namespace spine {
 
 		friend class SkeletonClipping;
 
+		friend class SkeletonSnapshot;
+
 		friend class AttachmentTimeline;
 
 		friend class RGBATimeline;
@@ -114,8 +116,25 @@ namespace spine {
 
 		void setAttachmentState(int state);
 
+		/// Vertices to deform the slot's attachment. For an unweighted VertexAttachment these are vertex positions, for a weighted one
+		/// they are offsets added to each bone's vertex position. Empty if the attachment's vertices are not deformed. Only values
+		/// in the deform range are used, so use getDeformForWrite() to change them.
 		Vector<float> &getDeform();
 
+		/// Returns the deform values to be changed and resets the deform range to the whole array, so all values are used.
+		Vector<float> &getDeformForWrite();
+
+		/// The first deform value which may differ from the attachment's setup pose. Values outside the deform range must match the
+		/// setup pose, which allows DeformTimeline and VertexAttachment to process only the range.
+		int getDeformStart();
+
+		/// One past the last deform value which may differ from the attachment's setup pose.
+		int getDeformEnd();
+
+		/// Sets the range of deform values which may differ from the setup pose. getDeformForWrite() resets the range to the whole
+		/// array, so this only needs to be called to narrow it again. By default the whole deform array is used.
+		void setDeformRange(int start, int end);
+
 		int getSequenceIndex();
 
 		void setSequenceIndex(int index);
@@ -131,6 +150,7 @@ namespace spine {
 		int _attachmentState;
 		int _sequenceIndex;
 		Vector<float> _deform;
+		int _deformStart, _deformEnd;
 	};
 }
 
@@ -0,0 +1,93 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated September 24, 2021. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2021, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_SpineProfiler_h
+#define Spine_SpineProfiler_h
+
+#include <spine/dll.h>
+
+// Define SPINE_PROFILER to compile profiler zones and counters into the runtime, see SpineProfiler. Without it, the
+// SP_PROFILE_ macros expand to nothing.
+#ifdef SPINE_PROFILER
+#define SP_PROFILE_CONCAT2(a, b) a##b
+#define SP_PROFILE_CONCAT(a, b) SP_PROFILE_CONCAT2(a, b)
+#define SP_PROFILE_ZONE(name) spine::ProfilerZone SP_PROFILE_CONCAT(_profilerZone, __LINE__)(name)
+#define SP_PROFILE_COUNTER(name, value) spine::SpineProfiler::count(name, (double) (value))
+#else
+#define SP_PROFILE_ZONE(name)
+#define SP_PROFILE_COUNTER(name, value)
+#endif
+
+namespace spine {
+	/// Receives zones and counters from the runtime when it is compiled with SPINE_PROFILER, eg to forward them to an external
+	/// profiler. Zones cover AnimationState::apply(), each timeline type, Skeleton::updateWorldTransform(), each constraint
+	/// type, computeWorldVertices(), clipping and loading. Zone and counter names are string literals or RTTI class names
+	/// that are valid for the lifetime of the program. Zones may begin and end on any thread that uses the runtime.
+	class SP_API SpineProfiler {
+	public:
+		virtual ~SpineProfiler();
+
+		virtual void beginZone(const char *name) = 0;
+
+		/// Ends the zone most recently begun on the calling thread.
+		virtual void endZone(const char *name) = 0;
+
+		virtual void counter(const char *name, double value) = 0;
+
+		/// Sets the profiler receiving zones and counters, or NULL to disable profiling. Default is NULL.
+		static void setInstance(SpineProfiler *inValue);
+
+		static SpineProfiler *getInstance();
+
+		static void count(const char *name, double value) {
+			if (_instance) _instance->counter(name, value);
+		}
+
+	private:
+		static SpineProfiler *_instance;
+	};
+
+	/// Begins a zone on the profiler instance when constructed and ends it when destructed.
+	class SP_API ProfilerZone {
+	public:
+		explicit ProfilerZone(const char *name) : _profiler(SpineProfiler::getInstance()), _name(name) {
+			if (_profiler) _profiler->beginZone(name);
+		}
+
+		~ProfilerZone() {
+			if (_profiler) _profiler->endZone(_name);
+		}
+
+	private:
+		SpineProfiler *_profiler;
+		const char *_name;
+	};
+}
+
+#endif /* Spine_SpineProfiler_h */
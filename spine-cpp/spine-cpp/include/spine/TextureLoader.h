@@ -45,6 +45,11 @@ namespace spine {
 		virtual void load(AtlasPage &page, const String &path) = 0;
 
 		virtual void unload(void *texture) = 0;
+
+		/// Returns the decoded pixels of a loaded page as RGBA8888, width * height * 4 bytes with rows from top to bottom, or NULL
+		/// if they are not available. Used by AtlasRepacker, which may call this from a thread other than the one which loaded the
+		/// page. The pixels must remain valid until the page is unloaded.
+		virtual const unsigned char *getPixels(AtlasPage &page);
 	};
 }
 
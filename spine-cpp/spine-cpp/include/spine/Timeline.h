@@ -64,6 +64,15 @@ namespace spine {
 		apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha, MixBlend blend,
 			  MixDirection direction) = 0;
 
+		/// Sets the value(s) for the specified times on several skeletons, as apply() would for each skeleton. The default
+		/// implementation calls apply() for each skeleton, timelines which are common in animations evaluate the keyframes
+		/// of all skeletons before changing their bones. See Animation::applyBatch().
+		/// @param count The number of skeletons, at most BatchSize.
+		/// @param pEvents NULL, or count vectors which fired events are added to, which may be NULL.
+		virtual void
+		applyBatch(Skeleton **skeletons, float *lastTimes, float *times, size_t count, Vector<Event *> **pEvents,
+				   float alpha, MixBlend blend, MixDirection direction);
+
 		size_t getFrameEntries();
 
 		size_t getFrameCount();
@@ -74,6 +83,11 @@ namespace spine {
 
 		virtual Vector <PropertyId> &getPropertyIds();
 
+		/// Returns the number of bytes allocated for the keyframe data of this timeline, excluding the timeline object itself.
+		virtual size_t getMemoryUsage();
+
+		static const size_t BatchSize = 64;
+
 	protected:
 		void setPropertyIds(PropertyId propertyIds[], size_t propertyIdsCount);
 
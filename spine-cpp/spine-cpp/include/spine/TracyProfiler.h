@@ -0,0 +1,74 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated September 24, 2021. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2021, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_TracyProfiler_h
+#define Spine_TracyProfiler_h
+
+#ifdef TRACY_ENABLE
+
+#include <spine/Extension.h>
+#include <spine/SpineProfiler.h>
+
+#include <string.h>
+#include <tracy/TracyC.h>
+#include <vector>
+
+namespace spine {
+	/// Forwards zones and counters to the Tracy profiler (0.10 or later). Only available when compiling with TRACY_ENABLE and
+	/// the Tracy client include directory. Counters are shown as Tracy plots.
+	class TracyProfiler : public SpineProfiler {
+	public:
+		virtual void beginZone(const char *name) {
+			size_t length = strlen(name);
+			uint64_t location = ___tracy_alloc_srcloc_name(0, "spine-cpp", 9, name, length, name, length, 0);
+			zones().push_back(___tracy_emit_zone_begin_alloc(location, 1));
+		}
+
+		virtual void endZone(const char *name) {
+			SP_UNUSED(name);
+			std::vector<TracyCZoneCtx> &stack = zones();
+			___tracy_emit_zone_end(stack.back());
+			stack.pop_back();
+		}
+
+		virtual void counter(const char *name, double value) {
+			___tracy_emit_plot(name, value);
+		}
+
+	private:
+		static std::vector<TracyCZoneCtx> &zones() {
+			static thread_local std::vector<TracyCZoneCtx> stack;
+			return stack;
+		}
+	};
+}
+
+#endif
+
+#endif /* Spine_TracyProfiler_h */
@@ -44,6 +44,8 @@ namespace spine {
 	class SP_API TransformConstraint : public Updatable {
 		friend class Skeleton;
 
+		friend class SkeletonSnapshot;
+
 		friend class TransformConstraintTimeline;
 
 	RTTI_DECL
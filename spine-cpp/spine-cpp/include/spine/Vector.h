@@ -94,6 +94,18 @@ namespace spine {
 			_buffer = SpineExtension::realloc<T>(_buffer, newCapacity, __FILE__, __LINE__);
 		}
 
+		/// Releases any capacity beyond the current size.
+		inline void shrinkToFit() {
+			if (_capacity == _size) return;
+			if (_size == 0) {
+				deallocate(_buffer);
+				_buffer = NULL;
+			} else {
+				_buffer = SpineExtension::realloc<T>(_buffer, _size, __FILE__, __LINE__);
+			}
+			_capacity = _size;
+		}
+
 		inline void add(const T &inValue) {
 			if (_size == _capacity) {
 				// inValue might reference an element in this buffer
@@ -37,6 +37,8 @@
 namespace spine {
 	class Slot;
 
+	class CompactVertices;
+
 	/// An attachment with vertices that are transformed by one or more bones and can be deformed by a slot's vertices.
 	class SP_API VertexAttachment : public Attachment {
 		friend class SkeletonBinary;
@@ -45,6 +47,8 @@ namespace spine {
 
 		friend class DeformTimeline;
 
+		friend class SkeletonData;
+
 	RTTI_DECL
 
 	public:
@@ -85,16 +89,33 @@ namespace spine {
 
 		void copyTo(VertexAttachment *other);
 
+		/// True if the vertices are transformed by more than one bone, see getBones() and getCompactVertices().
+		bool isWeighted();
+
+		/// Replaces bone weighted vertices with CompactVertices, which need less than half the memory. getBones() and
+		/// getVertices() are empty afterward. Does nothing if the vertices are not weighted, since deform timelines use
+		/// unweighted vertices as their setup pose.
+		virtual void compact();
+
+		/// The quantized bone weighted vertices, see compact().
+		/// @return May be NULL.
+		CompactVertices *getCompactVertices();
+
 	protected:
 		Vector <int> _bones;
 		Vector<float> _vertices;
 		size_t _worldVerticesLength;
 		Attachment *_timelineAttachment;
+		CompactVertices *_compactVertices;
 
 	private:
 		const int _id;
 
 		static int getNextID();
+
+		template<typename T>
+		void computeCompactWorldVertices(Slot &slot, Vector<T> &bones, size_t start, size_t count, float *worldVertices,
+										 size_t offset, size_t stride);
 	};
 }
 
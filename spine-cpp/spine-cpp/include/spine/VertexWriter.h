@@ -0,0 +1,196 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated September 24, 2021. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2021, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef Spine_VertexWriter_h
+#define Spine_VertexWriter_h
+
+#include <spine/Vector.h>
+#include <spine/Color.h>
+#include <spine/Slot.h>
+#include <spine/Bone.h>
+#include <spine/Skeleton.h>
+#include <spine/RegionAttachment.h>
+#include <spine/MeshAttachment.h>
+#include <spine/SkeletonClipping.h>
+
+namespace spine {
+	/// Writes the vertices of region and mesh attachments directly into the vertex struct of an engine. World positions
+	/// are computed in place and UVs and colors are written in the same loop, so a renderer needs no world vertices buffer
+	/// and no loop of its own to convert it. The layout is a traits struct describing the engine vertex, for example:
+	///
+	///     struct SDLLayout {
+	///         typedef SDL_Vertex Vertex;
+	///         typedef SDL_Color PackedColor;
+	///         static const size_t PositionOffset = 0;
+	///         static const bool DarkColor = false;
+	///         static PackedColor packColor(const Color &color);
+	///         static void setColor(Vertex &vertex, const PackedColor &light, const PackedColor &dark);
+	///         static void setUV(Vertex &vertex, float u, float v);
+	///     };
+	///
+	/// PositionOffset is the offset in floats of the x and y floats in the vertex, the size of the vertex must be a
+	/// multiple of sizeof(float). packColor() is called once per attachment. If DarkColor is false, the dark color passed
+	/// to setColor() is the light color.
+	///
+	/// Only unclipped attachments are written in place. When the clipper is clipping, the world vertices are computed into
+	/// an internal buffer first, since SkeletonClipping works on float positions, and the clipped vertices are then written.
+	template<typename Layout>
+	class SP_API VertexWriter : public SpineObject {
+	public:
+		typedef typename Layout::Vertex Vertex;
+
+		typedef typename Layout::PackedColor PackedColor;
+
+		VertexWriter() : _indices(NULL), _indicesCount(0) {
+			assert(sizeof(Vertex) % sizeof(float) == 0);
+			_quadIndices.add(0);
+			_quadIndices.add(1);
+			_quadIndices.add(2);
+			_quadIndices.add(2);
+			_quadIndices.add(3);
+			_quadIndices.add(0);
+		}
+
+		/// Writes the vertices and indices of the slot's region or mesh attachment, clipped if the clipper is clipping.
+		/// Returns false without writing if the slot has no region or mesh attachment, its bone is inactive or the slot
+		/// or attachment color is transparent. Clipping attachments are left to the caller, which starts and ends
+		/// clipping as before.
+		bool write(Slot &slot, SkeletonClipping &clipper) {
+			Attachment *attachment = slot.getAttachment();
+			if (!attachment || slot.getColor().a == 0 || !slot.getBone().isActive()) return false;
+
+			bool clipping = clipper.isClipping();
+			size_t verticesCount;
+			Vector<float> *uvs;
+			Vector<unsigned short> *indices;
+			Color *color;
+			if (attachment->getRTTI().isExactly(RegionAttachment::rtti)) {
+				RegionAttachment *region = static_cast<RegionAttachment *>(attachment);
+				color = &region->getColor();
+				if (color->a == 0) return false;
+				verticesCount = 4;
+				if (clipping) {
+					_worldVertices.setSize(8, 0);
+					region->computeWorldVertices(slot, _worldVertices.buffer(), 0, 2);
+				} else {
+					_vertices.setSize(4, Vertex());
+					region->computeWorldVertices(slot, (float *) _vertices.buffer(), Layout::PositionOffset, Stride);
+				}
+				uvs = &region->getUVs();
+				indices = &_quadIndices;
+			} else if (attachment->getRTTI().isExactly(MeshAttachment::rtti)) {
+				MeshAttachment *mesh = static_cast<MeshAttachment *>(attachment);
+				color = &mesh->getColor();
+				if (color->a == 0) return false;
+				size_t length = mesh->getWorldVerticesLength();
+				verticesCount = length >> 1;
+				if (clipping) {
+					_worldVertices.setSize(length, 0);
+					mesh->computeWorldVertices(slot, 0, length, _worldVertices.buffer(), 0, 2);
+				} else {
+					_vertices.setSize(verticesCount, Vertex());
+					mesh->computeWorldVertices(slot, 0, length, (float *) _vertices.buffer(), Layout::PositionOffset,
+											   Stride);
+				}
+				uvs = &mesh->getUVs();
+				indices = &mesh->getTriangles();
+			} else
+				return false;
+
+			Color &skeletonColor = slot.getSkeleton().getColor(), &slotColor = slot.getColor();
+			Color light(skeletonColor.r * slotColor.r * color->r, skeletonColor.g * slotColor.g * color->g,
+						skeletonColor.b * slotColor.b * color->b, skeletonColor.a * slotColor.a * color->a);
+			PackedColor packedLight = Layout::packColor(light), packedDark = packedLight;
+			if (Layout::DarkColor) {
+				Color dark(0, 0, 0, 1);
+				if (slot.hasDarkColor()) dark = slot.getDarkColor();
+				packedDark = Layout::packColor(dark);
+			}
+
+			if (!clipping) {
+				float *uv = uvs->buffer();
+				for (size_t i = 0; i < verticesCount; i++, uv += 2) {
+					Vertex &vertex = _vertices[i];
+					Layout::setUV(vertex, uv[0], uv[1]);
+					Layout::setColor(vertex, packedLight, packedDark);
+				}
+				_indices = indices->buffer();
+				_indicesCount = indices->size();
+				return true;
+			}
+
+			clipper.clipTriangles(_worldVertices.buffer(), indices->buffer(), indices->size(), uvs->buffer(), 2);
+			Vector<float> &clippedVertices = clipper.getClippedVertices();
+			Vector<unsigned short> &clippedTriangles = clipper.getClippedTriangles();
+			float *position = clippedVertices.buffer(), *uv = clipper.getClippedUVs().buffer();
+			verticesCount = clippedVertices.size() >> 1;
+			_vertices.setSize(verticesCount, Vertex());
+			for (size_t i = 0; i < verticesCount; i++, position += 2, uv += 2) {
+				Vertex &vertex = _vertices[i];
+				float *vertexPosition = (float *) &vertex + Layout::PositionOffset;
+				vertexPosition[0] = position[0];
+				vertexPosition[1] = position[1];
+				Layout::setUV(vertex, uv[0], uv[1]);
+				Layout::setColor(vertex, packedLight, packedDark);
+			}
+			_indices = clippedTriangles.buffer();
+			_indicesCount = clippedTriangles.size();
+			return true;
+		}
+
+		/// The vertices written by the last write().
+		Vertex *getVertices() {
+			return _vertices.buffer();
+		}
+
+		size_t getVerticesCount() {
+			return _vertices.size();
+		}
+
+		/// The triangle indices of the last write(), valid until the attachment or clipper changes.
+		unsigned short *getIndices() {
+			return _indices;
+		}
+
+		size_t getIndicesCount() {
+			return _indicesCount;
+		}
+
+	private:
+		static const size_t Stride = sizeof(Vertex) / sizeof(float);
+
+		Vector<Vertex> _vertices;
+		Vector<float> _worldVertices;
+		Vector<unsigned short> _quadIndices;
+		unsigned short *_indices;
+		size_t _indicesCount;
+	};
+}
+
+#endif /* Spine_VertexWriter_h */
@@ -35,33 +35,40 @@
 #include <spine/AnimationStateData.h>
 #include <spine/Atlas.h>
 #include <spine/AtlasAttachmentLoader.h>
+#include <spine/AtlasRepacker.h>
 #include <spine/Attachment.h>
 #include <spine/AttachmentLoader.h>
 #include <spine/AttachmentTimeline.h>
 #include <spine/AttachmentType.h>
+#include <spine/BakedTimeline.h>
 #include <spine/BlendMode.h>
 #include <spine/Bone.h>
 #include <spine/BoneData.h>
+#include <spine/BoneMask.h>
 #include <spine/BoundingBoxAttachment.h>
 #include <spine/ClippingAttachment.h>
 #include <spine/Color.h>
 #include <spine/ColorTimeline.h>
+#include <spine/CompactVertices.h>
 #include <spine/ConstraintData.h>
 #include <spine/ContainerUtil.h>
 #include <spine/CurveTimeline.h>
 #include <spine/DeformTimeline.h>
 #include <spine/DrawOrderTimeline.h>
 #include <spine/Event.h>
+#include <spine/EventBuffer.h>
 #include <spine/EventData.h>
 #include <spine/EventTimeline.h>
 #include <spine/Extension.h>
 #include <spine/HashMap.h>
 #include <spine/HasRendererObject.h>
+#include <spine/HeadlessAttachmentLoader.h>
 #include <spine/IkConstraint.h>
 #include <spine/IkConstraintData.h>
 #include <spine/IkConstraintTimeline.h>
 #include <spine/Json.h>
 #include <spine/LinkedMesh.h>
+#include <spine/LodLevel.h>
 #include <spine/MathUtil.h>
 #include <spine/MeshAttachment.h>
 #include <spine/MixBlend.h>
@@ -87,11 +94,14 @@
 #include <spine/SkeletonClipping.h>
 #include <spine/SkeletonData.h>
 #include <spine/SkeletonJson.h>
+#include <spine/SkeletonSnapshot.h>
 #include <spine/Skin.h>
+#include <spine/SkinCache.h>
 #include <spine/Slot.h>
 #include <spine/SlotData.h>
 #include <spine/SpacingMode.h>
 #include <spine/SpineObject.h>
+#include <spine/SpineProfiler.h>
 #include <spine/SpineString.h>
 #include <spine/TextureLoader.h>
 #include <spine/Timeline.h>
@@ -105,6 +115,7 @@
 #include <spine/Updatable.h>
 #include <spine/Vector.h>
 #include <spine/VertexAttachment.h>
+#include <spine/VertexWriter.h>
 #include <spine/Vertices.h>
 
 #endif
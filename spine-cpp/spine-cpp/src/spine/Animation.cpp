@@ -28,12 +28,16 @@
  *****************************************************************************/
 
 #include <spine/Animation.h>
+#include <spine/BakedTimeline.h>
+#include <spine/DeformTimeline.h>
 #include <spine/Event.h>
 #include <spine/Skeleton.h>
+#include <spine/SpineProfiler.h>
 #include <spine/Timeline.h>
 
 #include <spine/ContainerUtil.h>
 
+#include <float.h>
 #include <stdint.h>
 
 using namespace spine;
@@ -57,10 +61,80 @@ bool Animation::hasTimeline(Vector<PropertyId> &ids) {
 	return false;
 }
 
+void Animation::bake(SkeletonData &skeletonData, float fps) {
+	BakedTimeline *baked = new (__FILE__, __LINE__) BakedTimeline(skeletonData, *this, fps);
+	if (baked->getChannelCount() == 0) {
+		delete baked;
+		return;
+	}
+
+	Vector<Timeline *> timelines;
+	timelines.add(baked);
+	for (size_t i = 0, n = _timelines.size(); i < n; i++) {
+		if (BakedTimeline::isBoneTimeline(*_timelines[i]))
+			delete _timelines[i];
+		else
+			timelines.add(_timelines[i]);
+	}
+	_timelines.clearAndAddAll(timelines);
+}
+
+void Animation::compress(float angleTolerance, float translateTolerance, float scaleTolerance) {
+	for (size_t i = 0, n = _timelines.size(); i < n; i++) {
+		Timeline *timeline = _timelines[i];
+		if (timeline->getRTTI().isExactly(DeformTimeline::rtti)) {
+			static_cast<DeformTimeline *>(timeline)->compress(translateTolerance);
+			continue;
+		}
+		if (!timeline->getRTTI().instanceOf(CurveTimeline::rtti)) continue;
+		CurveTimeline *curveTimeline = static_cast<CurveTimeline *>(timeline);
+		if (BakedTimeline::isBoneTimeline(*timeline)) {
+			// Use the smallest tolerance of the bone properties the timeline keys.
+			float tolerance = FLT_MAX;
+			Vector<PropertyId> &ids = timeline->getPropertyIds();
+			for (size_t ii = 0; ii < ids.size(); ii++) {
+				switch ((int) (ids[ii] >> 32)) {
+					case Property_Rotate:
+					case Property_ShearX:
+					case Property_ShearY:
+						tolerance = MathUtil::min(tolerance, angleTolerance);
+						break;
+					case Property_X:
+					case Property_Y:
+						tolerance = MathUtil::min(tolerance, translateTolerance);
+						break;
+					default:
+						tolerance = MathUtil::min(tolerance, scaleTolerance);
+				}
+			}
+			curveTimeline->reduce(tolerance);
+		}
+		curveTimeline->quantize();
+	}
+}
+
+size_t Animation::getMemoryUsage() {
+	size_t usage = _timelines.getCapacity() * sizeof(Timeline *);
+	for (size_t i = 0, n = _timelines.size(); i < n; i++)
+		usage += _timelines[i]->getMemoryUsage();
+	return usage;
+}
+
 Animation::~Animation() {
 	ContainerUtil::cleanUpVectorOfPointers(_timelines);
 }
 
+void Animation::setTimelines(Vector<Timeline *> &timelines) {
+	ContainerUtil::cleanUpVectorOfPointers(_timelines);
+	_timelines.addAll(timelines);
+	_timelineIds.clear();
+	for (size_t i = 0; i < timelines.size(); i++) {
+		Vector<PropertyId> propertyIds = timelines[i]->getPropertyIds();
+		for (size_t ii = 0; ii < propertyIds.size(); ii++)
+			_timelineIds.put(propertyIds[ii], true);
+	}
+}
+
 void Animation::apply(Skeleton &skeleton, float lastTime, float time, bool loop, Vector<Event *> *pEvents, float alpha,
 					  MixBlend blend, MixDirection direction) {
 	if (loop && _duration != 0) {
@@ -71,10 +145,36 @@ void Animation::apply(Skeleton &skeleton, float lastTime, float time, bool loop,
 	}
 
 	for (size_t i = 0, n = _timelines.size(); i < n; ++i) {
+		SP_PROFILE_ZONE(_timelines[i]->getRTTI().getClassName());
 		_timelines[i]->apply(skeleton, lastTime, time, pEvents, alpha, blend, direction);
 	}
 }
 
+void Animation::applyBatch(Skeleton **skeletons, float *lastTimes, float *times, size_t count, bool loop,
+						   Vector<Event *> **pEvents, float alpha, MixBlend blend, MixDirection direction) {
+	float batchLastTimes[Timeline::BatchSize], batchTimes[Timeline::BatchSize];
+	for (size_t start = 0; start < count; start += Timeline::BatchSize) {
+		size_t batchCount = count - start < Timeline::BatchSize ? count - start : Timeline::BatchSize;
+		for (size_t i = 0; i < batchCount; i++) {
+			float lastTime = lastTimes[start + i], time = times[start + i];
+			if (loop && _duration != 0) {
+				time = MathUtil::fmod(time, _duration);
+				if (lastTime > 0) {
+					lastTime = MathUtil::fmod(lastTime, _duration);
+				}
+			}
+			batchLastTimes[i] = lastTime;
+			batchTimes[i] = time;
+		}
+
+		for (size_t i = 0, n = _timelines.size(); i < n; ++i) {
+			SP_PROFILE_ZONE(_timelines[i]->getRTTI().getClassName());
+			_timelines[i]->applyBatch(skeletons + start, batchLastTimes, batchTimes, batchCount,
+									  pEvents ? pEvents + start : NULL, alpha, blend, direction);
+		}
+	}
+}
+
 const String &Animation::getName() {
 	return _name;
 }
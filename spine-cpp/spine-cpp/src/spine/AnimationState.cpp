@@ -31,21 +31,37 @@
 #include <spine/Animation.h>
 #include <spine/AnimationStateData.h>
 #include <spine/AttachmentTimeline.h>
+#include <spine/BakedTimeline.h>
 #include <spine/Bone.h>
+#include <spine/BoneMask.h>
 #include <spine/BoneData.h>
 #include <spine/DrawOrderTimeline.h>
 #include <spine/Event.h>
+#include <spine/EventBuffer.h>
 #include <spine/EventTimeline.h>
 #include <spine/RotateTimeline.h>
 #include <spine/Skeleton.h>
 #include <spine/SkeletonData.h>
 #include <spine/Slot.h>
 #include <spine/SlotData.h>
+#include <spine/SpineProfiler.h>
 
 #include <float.h>
 
 using namespace spine;
 
+/// Returns the number of timeline modes of an animation: one for each timeline, followed by one for each channel of its baked
+/// timelines, which are mixed per channel. Track entries keep two floats of rotation mixing state for each mode.
+static size_t getModesCount(Animation &animation) {
+	Vector<Timeline *> &timelines = animation.getTimelines();
+	size_t count = timelines.size();
+	for (size_t i = 0, n = timelines.size(); i < n; i++) {
+		if (timelines[i]->getRTTI().isExactly(BakedTimeline::rtti))
+			count += static_cast<BakedTimeline *>(timelines[i])->getChannelCount();
+	}
+	return count;
+}
+
 void dummyOnAnimationEventFunc(AnimationState *state, spine::EventType type, TrackEntry *entry, Event *event = NULL) {
 	SP_UNUSED(state);
 	SP_UNUSED(type);
@@ -54,19 +70,21 @@ void dummyOnAnimationEventFunc(AnimationState *state, spine::EventType type, Tra
 }
 
 TrackEntry::TrackEntry() : _animation(NULL), _previous(NULL), _next(NULL), _mixingFrom(NULL), _mixingTo(0),
-						   _trackIndex(0), _loop(false), _holdPrevious(false), _reverse(false),
+						   _trackIndex(0), _id(0), _loop(false), _holdPrevious(false), _reverse(false),
 						   _shortestRotation(false),
 						   _eventThreshold(0), _attachmentThreshold(0), _drawOrderThreshold(0), _animationStart(0),
 						   _animationEnd(0), _animationLast(0), _nextAnimationLast(0), _delay(0), _trackTime(0),
 						   _trackLast(0), _nextTrackLast(0), _trackEnd(0), _timeScale(1.0f), _alpha(0), _mixTime(0),
 						   _mixDuration(0), _interruptAlpha(0), _totalAlpha(0), _mixBlend(MixBlend_Replace),
-						   _listener(dummyOnAnimationEventFunc), _listenerObject(NULL) {
+						   _boneMask(NULL), _listener(dummyOnAnimationEventFunc), _listenerObject(NULL) {
 }
 
 TrackEntry::~TrackEntry() {}
 
 int TrackEntry::getTrackIndex() { return _trackIndex; }
 
+int TrackEntry::getId() { return _id; }
+
 Animation *TrackEntry::getAnimation() { return _animation; }
 
 TrackEntry *TrackEntry::getPrevious() { return _previous; }
@@ -192,6 +210,8 @@ void TrackEntry::reset() {
 	_timelineMode.clear();
 	_timelineHoldMix.clear();
 	_timelinesRotation.clear();
+	_boneMask = NULL;
+	_timelineMasked.clear();
 
 	_listener = dummyOnAnimationEventFunc;
 	_listenerObject = NULL;
@@ -261,12 +281,22 @@ void EventQueue::drain() {
 	_drainDisabled = true;
 
 	AnimationState &state = _state;
+	EventBuffer *buffer = state._eventBuffer;
 
 	// Don't cache _eventQueueEntries.size() so callbacks can queue their own events (eg, call setAnimation in AnimationState_Complete).
 	for (size_t i = 0; i < _eventQueueEntries.size(); ++i) {
 		EventQueueEntry queueEntry = _eventQueueEntries[i];
 		TrackEntry *trackEntry = queueEntry._entry;
 
+		if (buffer) {
+			buffer->add(EventRecord(&state, queueEntry._type, trackEntry, queueEntry._event));
+			if (queueEntry._type == EventType_End) buffer->add(EventRecord(&state, EventType_Dispose, trackEntry, NULL));
+			if ((queueEntry._type == EventType_End || queueEntry._type == EventType_Dispose) &&
+				!_state.getManualTrackEntryDisposal())
+				_state.disposeTrackEntry(trackEntry);
+			continue;
+		}
+
 		switch (queueEntry._type) {
 			case EventType_Start:
 			case EventType_Interrupt:
@@ -317,9 +347,14 @@ AnimationState::AnimationState(AnimationStateData *data) : _data(data),
 														   _animationsChanged(false),
 														   _listener(dummyOnAnimationEventFunc),
 														   _listenerObject(NULL),
+														   _eventBuffer(NULL),
+														   _nextTrackEntryId(0),
 														   _unkeyedState(0),
 														   _timeScale(1),
-														   _manualTrackEntryDisposal(false) {
+														   _manualTrackEntryDisposal(false),
+														   _culled(false),
+														   _applyInterval(1),
+														   _applyCounter(0) {
 }
 
 AnimationState::~AnimationState() {
@@ -411,10 +446,18 @@ void AnimationState::update(float delta) {
 }
 
 bool AnimationState::apply(Skeleton &skeleton) {
+	SP_PROFILE_ZONE("AnimationState::apply");
 	if (_animationsChanged) {
 		animationsChanged();
 	}
 
+	// When culled or between apply intervals only event timelines are applied, the skeleton is not posed.
+	bool pose = !_culled;
+	if (pose && _applyInterval > 1) {
+		pose = _applyCounter == 0;
+		_applyCounter = (_applyCounter + 1) % _applyInterval;
+	}
+
 	bool applied = false;
 	for (size_t i = 0, n = _tracks.size(); i < n; ++i) {
 		TrackEntry *currentP = _tracks[i];
@@ -430,7 +473,7 @@ bool AnimationState::apply(Skeleton &skeleton) {
 		// apply mixing from entries first.
 		float mix = current._alpha;
 		if (current._mixingFrom != NULL) {
-			mix *= applyMixingFrom(currentP, skeleton, blend);
+			mix *= applyMixingFrom(currentP, skeleton, blend, pose);
 		} else if (current._trackTime >= current._trackEnd && current._next == NULL) {
 			mix = 0;// Set to setup pose the last time the entry will be applied.
 		}
@@ -445,9 +488,13 @@ bool AnimationState::apply(Skeleton &skeleton) {
 		}
 		size_t timelineCount = current._animation->_timelines.size();
 		Vector<Timeline *> &timelines = current._animation->_timelines;
+		bool *masked = getMaskedTimelines(current, skeleton);
 		if ((i == 0 && mix == 1) || blend == MixBlend_Add) {
 			for (size_t ii = 0; ii < timelineCount; ++ii) {
 				Timeline *timeline = timelines[ii];
+				if (!pose && !timeline->getRTTI().isExactly(EventTimeline::rtti)) continue;
+				if (masked && masked[ii]) continue;
+				SP_PROFILE_ZONE(timeline->getRTTI().getClassName());
 				if (timeline->getRTTI().isExactly(AttachmentTimeline::rtti))
 					applyAttachmentTimeline(static_cast<AttachmentTimeline *>(timeline), skeleton, applyTime, blend,
 											true);
@@ -458,17 +505,32 @@ bool AnimationState::apply(Skeleton &skeleton) {
 			Vector<int> &timelineMode = current._timelineMode;
 
 			bool shortestRotation = current._shortestRotation;
-			bool firstFrame = !shortestRotation && current._timelinesRotation.size() != timelines.size() << 1;
-			if (firstFrame) current._timelinesRotation.setSize(timelines.size() << 1, 0);
+			bool firstFrame = !shortestRotation && current._timelinesRotation.size() == 0;
+			if (firstFrame) current._timelinesRotation.setSize(getModesCount(*current._animation) << 1, 0);
 			Vector<float> &timelinesRotation = current._timelinesRotation;
 
+			size_t channel = timelineCount;
 			for (size_t ii = 0; ii < timelineCount; ++ii) {
 				Timeline *timeline = timelines[ii];
 				assert(timeline);
+				size_t firstChannel = channel;
+				if (timeline->getRTTI().isExactly(BakedTimeline::rtti))
+					channel += static_cast<BakedTimeline *>(timeline)->getChannelCount();
+				if (!pose && !timeline->getRTTI().isExactly(EventTimeline::rtti)) continue;
+				if (masked && masked[ii]) continue;
+				SP_PROFILE_ZONE(timeline->getRTTI().getClassName());
 
 				MixBlend timelineBlend = timelineMode[ii] == Subsequent ? blend : MixBlend_Setup;
 
-				if (!shortestRotation && timeline->getRTTI().isExactly(RotateTimeline::rtti))
+				if (timeline->getRTTI().isExactly(BakedTimeline::rtti)) {
+					BakedTimeline *bakedTimeline = static_cast<BakedTimeline *>(timeline);
+					for (size_t c = 0, cc = firstChannel; cc < channel; c++, cc++) {
+						MixBlend channelBlend = timelineMode[cc] == Subsequent ? blend : MixBlend_Setup;
+						bakedTimeline->mixChannel(skeleton, c, applyTime, mix, channelBlend, MixDirection_In,
+												  shortestRotation ? NULL : timelinesRotation.buffer() + (cc << 1),
+												  firstFrame);
+					}
+				} else if (!shortestRotation && timeline->getRTTI().isExactly(RotateTimeline::rtti))
 					applyRotateTimeline(static_cast<RotateTimeline *>(timeline), skeleton, applyTime, mix,
 										timelineBlend, timelinesRotation, ii << 1, firstFrame);
 				else if (timeline->getRTTI().isExactly(AttachmentTimeline::rtti))
@@ -486,6 +548,11 @@ bool AnimationState::apply(Skeleton &skeleton) {
 		current._nextTrackLast = current._trackTime;
 	}
 
+	if (!pose) {
+		_queue->drain();
+		return false;
+	}
+
 	int setupState = _unkeyedState + Setup;
 	Vector<Slot *> &slots = skeleton.getSlots();
 	for (int i = 0, n = (int) slots.size(); i < n; i++) {
@@ -657,6 +724,14 @@ void AnimationState::setListener(AnimationStateListenerObject *inValue) {
 	_listenerObject = inValue;
 }
 
+void AnimationState::setEventBuffer(EventBuffer *buffer) {
+	_eventBuffer = buffer;
+}
+
+EventBuffer *AnimationState::getEventBuffer() {
+	return _eventBuffer;
+}
+
 void AnimationState::disableQueue() {
 	_queue->_drainDisabled = true;
 }
@@ -678,6 +753,75 @@ void AnimationState::disposeTrackEntry(TrackEntry *entry) {
 	_trackEntryPool.free(entry);
 }
 
+void AnimationState::setCulled(bool inValue) {
+	// Pose the skeleton on the next apply after culling ends.
+	if (_culled && !inValue) _applyCounter = 0;
+	_culled = inValue;
+}
+
+bool AnimationState::isCulled() {
+	return _culled;
+}
+
+void AnimationState::setApplyInterval(int inValue) {
+	_applyInterval = MathUtil::max(1, inValue);
+	_applyCounter %= _applyInterval;
+}
+
+int AnimationState::getApplyInterval() {
+	return _applyInterval;
+}
+
+void AnimationState::ensureCapacity(size_t tracksCount, size_t entriesPerTrack) {
+	SkeletonData &skeletonData = *_data->getSkeletonData();
+	skeletonData.decodeAnimations();
+
+	size_t timelinesCount = 0, modesCount = 0, eventsCount = 0;
+	HashMap<PropertyId, bool> propertyIds;
+	Vector<Animation *> &animations = skeletonData.getAnimations();
+	for (size_t i = 0, n = animations.size(); i < n; i++) {
+		Vector<Timeline *> &timelines = animations[i]->getTimelines();
+		timelinesCount = MathUtil::max(timelinesCount, timelines.size());
+		modesCount = MathUtil::max(modesCount, getModesCount(*animations[i]));
+		for (size_t ii = 0, nn = timelines.size(); ii < nn; ii++) {
+			Timeline *timeline = timelines[ii];
+			if (timeline->getRTTI().isExactly(EventTimeline::rtti))
+				eventsCount = MathUtil::max(eventsCount, timeline->getFrameCount());
+			propertyIds.addAll(timeline->getPropertyIds(), true);
+		}
+	}
+
+	// An event timeline fires at most all of its events twice in one apply, when the animation loops.
+	size_t entriesCount = tracksCount * entriesPerTrack;
+	_tracks.ensureCapacity(tracksCount);
+	_events.ensureCapacity(eventsCount * 2);
+	_queue->_eventQueueEntries.ensureCapacity(entriesCount * (5 + eventsCount * 2));
+	_propertyIDs.ensureCapacity(propertyIds.size());
+	_timelineModeKey.ensureCapacity(entriesCount * 3 + 1);
+
+	// Obtain the entries from the pool to size their buffers, then return them.
+	Vector<TrackEntry *> entries;
+	for (size_t i = 0; i < entriesCount; i++) {
+		TrackEntry *entry = _trackEntryPool.obtain();
+		entry->_timelineMode.ensureCapacity(modesCount);
+		entry->_timelineHoldMix.ensureCapacity(modesCount);
+		entry->_timelinesRotation.ensureCapacity(modesCount << 1);
+		entry->_timelineMasked.ensureCapacity(timelinesCount);
+		entries.add(entry);
+	}
+	for (size_t i = 0; i < entriesCount; i++)
+		_trackEntryPool.free(entries[i]);
+}
+
+void AnimationState::setApplyIntervalForDistance(float distance, float nearDistance, float farDistance, int maxInterval) {
+	if (distance <= nearDistance || farDistance <= nearDistance) {
+		setApplyInterval(1);
+		return;
+	}
+	float alpha = MathUtil::min(1.0f, (distance - nearDistance) / (farDistance - nearDistance));
+	setApplyInterval(1 + (int) (alpha * (maxInterval - 1) + 0.5f));
+}
+
 Animation *AnimationState::getEmptyAnimation() {
 	static Vector<Timeline *> timelines;
 	static Animation ret(String("<empty>"), timelines, 0);
@@ -731,19 +875,23 @@ void AnimationState::applyRotateTimeline(RotateTimeline *rotateTimeline, Skeleto
 		r2 = bone->_data._rotation + rotateTimeline->getCurveValue(time);
 	}
 
+	bone->_rotation = mixRotation(r1, r2, alpha, timelinesRotation.buffer() + i, firstFrame);
+}
+
+float AnimationState::mixRotation(float r1, float r2, float alpha, float *timelinesRotation, bool firstFrame) {
 	// Mix between rotations using the direction of the shortest route on the first frame while detecting crosses.
 	float total, diff = r2 - r1;
 	diff -= (16384 - (int) (16384.499999999996 - diff / 360)) * 360;
 	if (diff == 0) {
-		total = timelinesRotation[i];
+		total = timelinesRotation[0];
 	} else {
 		float lastTotal, lastDiff;
 		if (firstFrame) {
 			lastTotal = 0;
 			lastDiff = diff;
 		} else {
-			lastTotal = timelinesRotation[i];   // Angle and direction of mix, including loops.
-			lastDiff = timelinesRotation[i + 1];// Difference between bones.
+			lastTotal = timelinesRotation[0];// Angle and direction of mix, including loops.
+			lastDiff = timelinesRotation[1]; // Difference between bones.
 		}
 
 		bool current = diff > 0, dir = lastTotal >= 0;
@@ -758,10 +906,10 @@ void AnimationState::applyRotateTimeline(RotateTimeline *rotateTimeline, Skeleto
 		if (dir != current) {
 			total += 360 * MathUtil::sign(lastTotal);
 		}
-		timelinesRotation[i] = total;
+		timelinesRotation[0] = total;
 	}
-	timelinesRotation[i + 1] = diff;
-	bone->_rotation = r1 + total * alpha;
+	timelinesRotation[1] = diff;
+	return r1 + total * alpha;
 }
 
 bool AnimationState::updateMixingFrom(TrackEntry *to, float delta) {
@@ -793,9 +941,30 @@ bool AnimationState::updateMixingFrom(TrackEntry *to, float delta) {
 	return false;
 }
 
-float AnimationState::applyMixingFrom(TrackEntry *to, Skeleton &skeleton, MixBlend blend) {
+float AnimationState::getMixingFromAlpha(int mode, TrackEntry *holdMix, MixBlend blend, float alphaMix, float alphaHold,
+										  MixBlend &timelineBlend) {
+	switch (mode) {
+		case Subsequent:
+			timelineBlend = blend;
+			return alphaMix;
+		case First:
+			timelineBlend = MixBlend_Setup;
+			return alphaMix;
+		case HoldSubsequent:
+			timelineBlend = blend;
+			return alphaHold;
+		case HoldFirst:
+			timelineBlend = MixBlend_Setup;
+			return alphaHold;
+		default:
+			timelineBlend = MixBlend_Setup;
+			return alphaHold * MathUtil::max(0.0f, 1.0f - holdMix->_mixTime / holdMix->_mixDuration);
+	}
+}
+
+float AnimationState::applyMixingFrom(TrackEntry *to, Skeleton &skeleton, MixBlend blend, bool pose) {
 	TrackEntry *from = to->_mixingFrom;
-	if (from->_mixingFrom != NULL) applyMixingFrom(from, skeleton, blend);
+	if (from->_mixingFrom != NULL) applyMixingFrom(from, skeleton, blend, pose);
 
 	float mix;
 	if (to->_mixDuration == 0) {
@@ -823,50 +992,52 @@ float AnimationState::applyMixingFrom(TrackEntry *to, Skeleton &skeleton, MixBle
 		if (mix < from->_eventThreshold) events = &_events;
 	}
 
+	bool *masked = getMaskedTimelines(*from, skeleton);
 	if (blend == MixBlend_Add) {
-		for (size_t i = 0; i < timelineCount; i++)
+		for (size_t i = 0; i < timelineCount; i++) {
+			if (!pose && !timelines[i]->getRTTI().isExactly(EventTimeline::rtti)) continue;
+			if (masked && masked[i]) continue;
+			SP_PROFILE_ZONE(timelines[i]->getRTTI().getClassName());
 			timelines[i]->apply(skeleton, animationLast, applyTime, events, alphaMix, blend, MixDirection_Out);
+		}
 	} else {
 		Vector<int> &timelineMode = from->_timelineMode;
 		Vector<TrackEntry *> &timelineHoldMix = from->_timelineHoldMix;
 
 		bool shortestRotation = from->_shortestRotation;
-		bool firstFrame = !shortestRotation && from->_timelinesRotation.size() != timelines.size() << 1;
-		if (firstFrame) from->_timelinesRotation.setSize(timelines.size() << 1, 0);
+		bool firstFrame = !shortestRotation && from->_timelinesRotation.size() == 0;
+		if (firstFrame) from->_timelinesRotation.setSize(getModesCount(*from->_animation) << 1, 0);
 
 		Vector<float> &timelinesRotation = from->_timelinesRotation;
 
 		from->_totalAlpha = 0;
+		size_t channel = timelineCount;
 		for (size_t i = 0; i < timelineCount; i++) {
 			Timeline *timeline = timelines[i];
 			MixDirection direction = MixDirection_Out;
 			MixBlend timelineBlend;
 			float alpha;
-			switch (timelineMode[i]) {
-				case Subsequent:
-					if (!drawOrder && (timeline->getRTTI().isExactly(DrawOrderTimeline::rtti))) continue;
-					timelineBlend = blend;
-					alpha = alphaMix;
-					break;
-				case First:
-					timelineBlend = MixBlend_Setup;
-					alpha = alphaMix;
-					break;
-				case HoldSubsequent:
-					timelineBlend = blend;
-					alpha = alphaHold;
-					break;
-				case HoldFirst:
-					timelineBlend = MixBlend_Setup;
-					alpha = alphaHold;
-					break;
-				default:
-					timelineBlend = MixBlend_Setup;
-					TrackEntry *holdMix = timelineHoldMix[i];
-					alpha = alphaHold * MathUtil::max(0.0f, 1.0f - holdMix->_mixTime / holdMix->_mixDuration);
-					break;
+			if (timeline->getRTTI().isExactly(BakedTimeline::rtti)) {
+				BakedTimeline *bakedTimeline = static_cast<BakedTimeline *>(timeline);
+				bool skip = (!pose) || (masked && masked[i]);
+				for (size_t c = 0, n = bakedTimeline->getChannelCount(); c < n; c++, channel++) {
+					alpha = getMixingFromAlpha(timelineMode[channel], timelineHoldMix[channel], blend, alphaMix, alphaHold,
+											   timelineBlend);
+					from->_totalAlpha += alpha;
+					if (skip) continue;
+					bakedTimeline->mixChannel(skeleton, c, applyTime, alpha, timelineBlend, direction,
+											  shortestRotation ? NULL : timelinesRotation.buffer() + (channel << 1),
+											  firstFrame);
+				}
+				continue;
 			}
+			if (timelineMode[i] == Subsequent && !drawOrder && timeline->getRTTI().isExactly(DrawOrderTimeline::rtti))
+				continue;
+			alpha = getMixingFromAlpha(timelineMode[i], timelineHoldMix[i], blend, alphaMix, alphaHold, timelineBlend);
 			from->_totalAlpha += alpha;
+			if (!pose && !timeline->getRTTI().isExactly(EventTimeline::rtti)) continue;
+			if (masked && masked[i]) continue;
+			SP_PROFILE_ZONE(timeline->getRTTI().getClassName());
 			if (!shortestRotation && (timeline->getRTTI().isExactly(RotateTimeline::rtti))) {
 				applyRotateTimeline((RotateTimeline *) timeline, skeleton, applyTime, alpha, timelineBlend,
 									timelinesRotation, i << 1, firstFrame);
@@ -964,6 +1135,7 @@ TrackEntry *AnimationState::newTrackEntry(size_t trackIndex, Animation *animatio
 	TrackEntry &entry = *entryP;
 
 	entry._trackIndex = (int) trackIndex;
+	entry._id = ++_nextTrackEntryId;
 	entry._animation = animation;
 	entry._loop = loop;
 	entry._holdPrevious = 0;
@@ -1010,6 +1182,9 @@ void AnimationState::animationsChanged() {
 	_animationsChanged = false;
 
 	_propertyIDs.clear();
+	_timelineModeKey.clear();
+	size_t propertyIDsCount = 0;
+	bool cache = _data->_timelineModeCache;
 
 	for (size_t i = 0, n = _tracks.size(); i < n; ++i) {
 		TrackEntry *entry = _tracks[i];
@@ -1019,25 +1194,104 @@ void AnimationState::animationsChanged() {
 			entry = entry->_mixingFrom;
 
 		do {
-			if (entry->_mixingTo == NULL || entry->_mixBlend != MixBlend_Add) computeHold(entry);
+			if (entry->_mixingTo == NULL || entry->_mixBlend != MixBlend_Add) {
+				if (cache)
+					computeHoldCached(entry, propertyIDsCount);
+				else
+					computeHold(entry);
+			}
 			entry = entry->_mixingTo;
 		} while (entry != NULL);
 	}
 }
 
+bool *AnimationState::getMaskedTimelines(TrackEntry &entry, Skeleton &skeleton) {
+	BoneMask *mask = skeleton._boneMask;
+	if (!mask) return NULL;
+	if (entry._boneMask != mask) {
+		mask->getMaskedTimelines(*entry._animation, entry._timelineMasked);
+		entry._boneMask = mask;
+	}
+	return entry._timelineMasked.buffer();
+}
+
+void AnimationState::computeHoldCached(TrackEntry *entry, size_t &propertyIDsCount) {
+	// The modes depend only on the animations whose property IDs were added before this entry, the entry's animation and
+	// the mixing chain. The key starts with the former, which are never 0, followed by a 0 and the rest.
+	Vector<size_t> &key = _timelineModeKey;
+	size_t keyCount = key.size();
+	key.add(0);
+	key.add((size_t) entry->_animation);
+	for (TrackEntry *next = entry->_mixingTo; next != NULL; next = next->_mixingTo) {
+		key.add((size_t) next->_animation);
+		key.add((next->_holdPrevious ? 1 : 0) | (next->_mixDuration > 0 ? 2 : 0));
+	}
+	size_t hash = 2166136261u;
+	for (size_t i = 0, n = key.size(); i < n; i++)
+		hash = (hash ^ key[i]) * 16777619u;
+	hash ^= hash >> 16;
+
+	size_t timelinesCount = getModesCount(*entry->_animation);
+	AnimationStateData::TimelineModes *modes = _data->findTimelineModes(hash, key);
+	if (modes && modes->_modes.size() == timelinesCount) {
+		_data->_timelineModeCacheHits++;
+		Vector<int> &timelineMode = entry->_timelineMode;
+		timelineMode.setSize(timelinesCount, 0);
+		Vector<TrackEntry *> &timelineHoldMix = entry->_timelineHoldMix;
+		timelineHoldMix.setSize(timelinesCount, 0);
+		for (size_t i = 0; i < timelinesCount; i++) {
+			timelineMode[i] = modes->_modes[i];
+			TrackEntry *holdMix = NULL;
+			for (int depth = modes->_holdMix[i]; depth > 0; depth--)
+				holdMix = holdMix ? holdMix->_mixingTo : entry->_mixingTo;
+			timelineHoldMix[i] = holdMix;
+		}
+	} else {
+		_data->_timelineModeCacheMisses++;
+		// Add the property IDs of the animations whose modes were found in the cache.
+		for (; propertyIDsCount < keyCount; propertyIDsCount++) {
+			Vector<Timeline *> &timelines = ((Animation *) key[propertyIDsCount])->_timelines;
+			for (size_t i = 0, n = timelines.size(); i < n; i++)
+				_propertyIDs.addAll(timelines[i]->getPropertyIds(), true);
+		}
+		computeHold(entry);
+		propertyIDsCount = keyCount + 1;
+
+		if (!modes) modes = _data->addTimelineModes(hash, key);
+		modes->_modes.clearAndAddAll(entry->_timelineMode);
+		modes->_holdMix.setSize(timelinesCount, 0);
+		for (size_t i = 0; i < timelinesCount; i++) {
+			int depth = 0;
+			TrackEntry *holdMix = entry->_timelineHoldMix[i];
+			if (holdMix) {
+				for (TrackEntry *next = entry->_mixingTo; next != NULL; next = next->_mixingTo) {
+					depth++;
+					if (next == holdMix) break;
+				}
+			}
+			modes->_holdMix[i] = depth;
+		}
+	}
+
+	key.setSize(keyCount, 0);
+	key.add((size_t) entry->_animation);
+}
+
 void AnimationState::computeHold(TrackEntry *entry) {
 	TrackEntry *to = entry->_mixingTo;
 	Vector<Timeline *> &timelines = entry->_animation->_timelines;
 	size_t timelinesCount = timelines.size();
 	Vector<int> &timelineMode = entry->_timelineMode;
-	timelineMode.setSize(timelinesCount, 0);
+	timelineMode.setSize(getModesCount(*entry->_animation), 0);
 	Vector<TrackEntry *> &timelineHoldMix = entry->_timelineHoldMix;
-	timelineHoldMix.setSize(timelinesCount, 0);
+	timelineHoldMix.setSize(timelineMode.size(), 0);
 
 	if (to != NULL && to->_holdPrevious) {
 		for (size_t i = 0; i < timelinesCount; i++) {
+			if (timelines[i]->getRTTI().isExactly(BakedTimeline::rtti)) continue;
 			timelineMode[i] = _propertyIDs.addAll(timelines[i]->getPropertyIds(), true) ? HoldFirst : HoldSubsequent;
 		}
+		computeChannelHold(entry);
 		return;
 	}
 
@@ -1047,7 +1301,9 @@ continue_outer:
 	for (; i < timelinesCount; ++i) {
 		Timeline *timeline = timelines[i];
 		Vector<PropertyId> &ids = timeline->getPropertyIds();
-		if (!_propertyIDs.addAll(ids, true)) {
+		if (timeline->getRTTI().isExactly(BakedTimeline::rtti)) {
+			timelineMode[i] = First;
+		} else if (!_propertyIDs.addAll(ids, true)) {
 			timelineMode[i] = Subsequent;
 		} else {
 			if (to == NULL || timeline->getRTTI().isExactly(AttachmentTimeline::rtti) ||
@@ -1069,4 +1325,40 @@ continue_outer:
 			}
 		}
 	}
+	computeChannelHold(entry);
+}
+
+void AnimationState::computeChannelHold(TrackEntry *entry) {
+	TrackEntry *to = entry->_mixingTo;
+	Vector<Timeline *> &timelines = entry->_animation->_timelines;
+	Vector<int> &timelineMode = entry->_timelineMode;
+	Vector<TrackEntry *> &timelineHoldMix = entry->_timelineHoldMix;
+	size_t channel = timelines.size();
+	for (size_t i = 0, n = timelines.size(); i < n; i++) {
+		if (!timelines[i]->getRTTI().isExactly(BakedTimeline::rtti)) continue;
+		Vector<PropertyId> &ids = timelines[i]->getPropertyIds();
+		for (size_t ii = 0, nn = ids.size(); ii < nn; ii++, channel++) {
+			PropertyId id = ids[ii];
+			size_t oldSize = _propertyIDs.size();
+			_propertyIDs.put(id, true);
+			bool first = _propertyIDs.size() != oldSize;
+			if (to != NULL && to->_holdPrevious)
+				timelineMode[channel] = first ? HoldFirst : HoldSubsequent;
+			else if (!first)
+				timelineMode[channel] = Subsequent;
+			else if (to == NULL || !to->_animation->_timelineIds.containsKey(id))
+				timelineMode[channel] = First;
+			else {
+				timelineMode[channel] = HoldFirst;
+				for (TrackEntry *next = to->_mixingTo; next != NULL; next = next->_mixingTo) {
+					if (next->_animation->_timelineIds.containsKey(id)) continue;
+					if (next->_mixDuration > 0) {
+						timelineMode[channel] = HoldMix;
+						timelineHoldMix[channel] = next;
+					}
+					break;
+				}
+			}
+		}
+	}
 }
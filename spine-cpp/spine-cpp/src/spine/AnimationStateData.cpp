@@ -29,11 +29,19 @@
 
 #include <spine/AnimationStateData.h>
 #include <spine/Animation.h>
+#include <spine/ContainerUtil.h>
+#include <spine/MathUtil.h>
 #include <spine/SkeletonData.h>
 
 using namespace spine;
 
-AnimationStateData::AnimationStateData(SkeletonData *skeletonData) : _skeletonData(skeletonData), _defaultMix(0) {
+AnimationStateData::AnimationStateData(SkeletonData *skeletonData) : _skeletonData(skeletonData), _defaultMix(0),
+																	   _timelineModeCache(false), _timelineModeCacheHits(0),
+																	   _timelineModeCacheMisses(0), _timelineModeMask(0) {
+}
+
+AnimationStateData::~AnimationStateData() {
+	ContainerUtil::cleanUpVectorOfPointers(_timelineModes);
 }
 
 void AnimationStateData::setMix(const String &fromName, const String &toName, float duration) {
@@ -78,6 +86,71 @@ void AnimationStateData::clear() {
 	_animationToMixTime.clear();
 }
 
+bool AnimationStateData::getTimelineModeCache() {
+	return _timelineModeCache;
+}
+
+void AnimationStateData::setTimelineModeCache(bool inValue) {
+	_timelineModeCache = inValue;
+}
+
+size_t AnimationStateData::getTimelineModeCacheHits() {
+	return _timelineModeCacheHits;
+}
+
+size_t AnimationStateData::getTimelineModeCacheMisses() {
+	return _timelineModeCacheMisses;
+}
+
+size_t AnimationStateData::getTimelineModeCacheSize() {
+	return _timelineModes.size();
+}
+
+void AnimationStateData::clearTimelineModeCache() {
+	ContainerUtil::cleanUpVectorOfPointers(_timelineModes);
+	_timelineModeBuckets.clear();
+	_timelineModeMask = 0;
+	_timelineModeCacheHits = 0;
+	_timelineModeCacheMisses = 0;
+}
+
+AnimationStateData::TimelineModes *AnimationStateData::findTimelineModes(size_t hash, Vector<size_t> &key) {
+	if (_timelineModeBuckets.size() == 0) return NULL;
+	for (TimelineModes *modes = _timelineModeBuckets[hash & _timelineModeMask]; modes; modes = modes->_next)
+		if (modes->_hash == hash && modes->_key == key) return modes;
+	return NULL;
+}
+
+AnimationStateData::TimelineModes *AnimationStateData::addTimelineModes(size_t hash, Vector<size_t> &key) {
+	TimelineModes *modes = new (__FILE__, __LINE__) TimelineModes(hash, key);
+	_timelineModes.add(modes);
+	if (_timelineModes.size() > (_timelineModeBuckets.size() >> 1))
+		resizeTimelineModes(MathUtil::max((size_t) 16, _timelineModeBuckets.size() << 1));
+	else {
+		TimelineModes *&bucket = _timelineModeBuckets[hash & _timelineModeMask];
+		modes->_next = bucket;
+		bucket = modes;
+	}
+	return modes;
+}
+
+void AnimationStateData::resizeTimelineModes(size_t bucketCount) {
+	_timelineModeBuckets.setSize(bucketCount, NULL);
+	for (size_t i = 0; i < bucketCount; i++)
+		_timelineModeBuckets[i] = NULL;
+	_timelineModeMask = bucketCount - 1;
+	for (size_t i = 0, n = _timelineModes.size(); i < n; i++) {
+		TimelineModes *modes = _timelineModes[i];
+		TimelineModes *&bucket = _timelineModeBuckets[modes->_hash & _timelineModeMask];
+		modes->_next = bucket;
+		bucket = modes;
+	}
+}
+
+AnimationStateData::TimelineModes::TimelineModes(size_t hash, Vector<size_t> &key) : _hash(hash), _next(NULL) {
+	_key.addAll(key);
+}
+
 AnimationStateData::AnimationPair::AnimationPair(Animation *a1, Animation *a2) : _a1(a1), _a2(a2) {
 }
 
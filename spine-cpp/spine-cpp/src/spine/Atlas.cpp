@@ -29,13 +29,17 @@
 
 #include <spine/Atlas.h>
 #include <spine/ContainerUtil.h>
+#include <spine/SpineProfiler.h>
 #include <spine/TextureLoader.h>
 
 #include <ctype.h>
 
 using namespace spine;
 
-Atlas::Atlas(const String &path, TextureLoader *textureLoader, bool createTexture) : _textureLoader(textureLoader) {
+Atlas::Atlas(const String &path, TextureLoader *textureLoader, bool createTexture) : _textureLoader(textureLoader),
+																					 _indexedRegions(0),
+																					 _regionBlock(NULL),
+																					 _regionBlockSize(0) {
 	int dirLength;
 	char *dir;
 	int length;
@@ -54,26 +58,35 @@ Atlas::Atlas(const String &path, TextureLoader *textureLoader, bool createTextur
 	data = SpineExtension::readFile(path, &length);
 	if (data) {
 		load(data, length, dir, createTexture);
+		SpineExtension::free(data, __FILE__, __LINE__);
 	}
 
-	SpineExtension::free(data, __FILE__, __LINE__);
 	SpineExtension::free(dir, __FILE__, __LINE__);
 }
 
 Atlas::Atlas(const char *data, int length, const char *dir, TextureLoader *textureLoader, bool createTexture)
-	: _textureLoader(
-			  textureLoader) {
+	: _textureLoader(textureLoader), _indexedRegions(0), _regionBlock(NULL), _regionBlockSize(0) {
 	load(data, length, dir, createTexture);
 }
 
 Atlas::~Atlas() {
 	if (_textureLoader) {
 		for (size_t i = 0, n = _pages.size(); i < n; ++i) {
-			_textureLoader->unload(_pages[i]->texture);
+			if (_pages[i]->texture) _textureLoader->unload(_pages[i]->texture);
 		}
 	}
 	ContainerUtil::cleanUpVectorOfPointers(_pages);
-	ContainerUtil::cleanUpVectorOfPointers(_regions);
+	for (size_t i = 0, n = _regions.size(); i < n; ++i) {
+		AtlasRegion *region = _regions[i];
+		if (region >= _regionBlock && region < _regionBlock + _regionBlockSize) continue;
+		delete region;
+	}
+	_regions.clear();
+	if (_regionBlock) {
+		for (size_t i = 0; i < _regionBlockSize; ++i)
+			_regionBlock[i].~AtlasRegion();
+		SpineExtension::free(_regionBlock, __FILE__, __LINE__);
+	}
 }
 
 void Atlas::flipV() {
@@ -85,10 +98,59 @@ void Atlas::flipV() {
 	}
 }
 
+static unsigned int hashName(const String &name) {
+	unsigned int hash = 2166136261u;
+	const char *chars = name.buffer();
+	for (size_t i = 0, n = name.length(); i < n; i++) {
+		hash ^= (unsigned char) chars[i];
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+void Atlas::createTextures() {
+	if (!_textureLoader) return;
+	for (size_t i = 0, n = _pages.size(); i < n; ++i) {
+		AtlasPage *page = _pages[i];
+		if (page->texture) continue;
+		_textureLoader->load(*page, page->texturePath);
+	}
+	for (size_t i = 0, n = _regions.size(); i < n; ++i) {
+		AtlasRegion *region = _regions[i];
+		if (!region->rendererObject && region->page) region->rendererObject = region->page->texture;
+	}
+}
+
 AtlasRegion *Atlas::findRegion(const String &name) {
-	for (size_t i = 0, n = _regions.size(); i < n; ++i)
-		if (_regions[i]->name == name) return _regions[i];
-	return NULL;
+	if (_indexedRegions != _regions.size()) buildIndex();
+	if (_index.size() == 0) return NULL;
+	size_t mask = _index.size() - 1;
+	for (size_t i = hashName(name) & mask;; i = (i + 1) & mask) {
+		int regionIndex = _index[i];
+		if (regionIndex == -1) return NULL;
+		if (_regions[regionIndex]->name == name) return _regions[regionIndex];
+	}
+}
+
+void Atlas::buildIndex() {
+	size_t regionCount = _regions.size();
+	size_t bucketCount = 0;
+	if (regionCount > 0) {
+		// Keep the load factor at or below 0.5 so probes stay short and always reach an empty bucket.
+		bucketCount = 16;
+		while (bucketCount < regionCount * 2)
+			bucketCount <<= 1;
+	}
+	_index.clear();
+	_index.setSize(bucketCount, -1);
+	size_t mask = bucketCount - 1;
+	for (size_t r = 0; r < regionCount; r++) {
+		size_t i = hashName(_regions[r]->name) & mask;
+		while (_index[i] != -1)
+			i = (i + 1) & mask;
+		_index[i] = (int) r;
+	}
+	_indexedRegions = regionCount;
 }
 
 Vector<AtlasPage *> &Atlas::getPages() {
@@ -224,14 +286,18 @@ int indexOf(const char **array, int count, SimpleString *str) {
 }
 
 void Atlas::load(const char *begin, int length, const char *dir, bool createTexture) {
+	SP_PROFILE_ZONE("Atlas::load");
 	static const char *formatNames[] = {"", "Alpha", "Intensity", "LuminanceAlpha", "RGB565", "RGBA4444", "RGB888",
 										"RGBA8888"};
 	static const char *textureFilterNames[] = {"", "Nearest", "Linear", "MipMap", "MipMapNearestNearest",
 											   "MipMapLinearNearest",
 											   "MipMapNearestLinear", "MipMapLinearLinear"};
 
-	int dirLength = (int) strlen(dir);
-	int needsSlash = dirLength > 0 && dir[dirLength - 1] != '/' && dir[dirLength - 1] != '\\';
+	if (isBinary(begin, length)) {
+		loadBinary(begin, length, dir, createTexture);
+		return;
+	}
+
 	AtlasInput reader(begin, length);
 	SimpleString entry[5];
 	AtlasPage *page = NULL;
@@ -252,12 +318,7 @@ void Atlas::load(const char *begin, int length, const char *dir, bool createText
 			page = NULL;
 			line = reader.readLine();
 		} else if (page == NULL) {
-			char *name = line->copy();
-			char *path = SpineExtension::calloc<char>(dirLength + needsSlash + strlen(name) + 1, __FILE__, __LINE__);
-			memcpy(path, dir, dirLength);
-			if (needsSlash) path[dirLength] = '/';
-			strcpy(path + dirLength + needsSlash, name);
-			page = new (__FILE__, __LINE__) AtlasPage(String(name, true));
+			page = new (__FILE__, __LINE__) AtlasPage(String(line->copy(), true));
 
 			while (true) {
 				line = reader.readLine();
@@ -280,14 +341,7 @@ void Atlas::load(const char *begin, int length, const char *dir, bool createText
 				}
 			}
 
-			if (createTexture) {
-				if (_textureLoader) _textureLoader->load(*page, String(path));
-				SpineExtension::free(path, __FILE__, __LINE__);
-			} else {
-				page->texturePath = String(path, true);
-			}
-			page->index = (int) _pages.size();
-			_pages.add(page);
+			addPage(page, dir, createTexture);
 		} else {
 			AtlasRegion *region = new (__FILE__, __LINE__) AtlasRegion();
 			region->page = page;
@@ -328,7 +382,8 @@ void Atlas::load(const char *begin, int length, const char *dir, bool createText
 				} else if (entry[0].equals("index")) {
 					region->index = entry[1].toInt();
 				} else {
-					region->names.add(String(entry[0].copy()));
+					region->names.add(String(entry[0].copy(), true));
+					region->valueCounts.add(count);
 					for (int i = 0; i < count; i++) {
 						region->values.add(entry[i + 1].toInt());
 					}
@@ -351,4 +406,245 @@ void Atlas::load(const char *begin, int length, const char *dir, bool createText
 			_regions.add(region);
 		}
 	}
+	buildIndex();
+}
+
+void Atlas::addPage(AtlasPage *page, const char *dir, bool createTexture) {
+	int dirLength = (int) strlen(dir);
+	int needsSlash = dirLength > 0 && dir[dirLength - 1] != '/' && dir[dirLength - 1] != '\\';
+	int nameLength = (int) page->name.length();
+	char *path = SpineExtension::calloc<char>(dirLength + needsSlash + nameLength + 1, __FILE__, __LINE__);
+	memcpy(path, dir, dirLength);
+	if (needsSlash) path[dirLength] = '/';
+	memcpy(path + dirLength + needsSlash, page->name.buffer(), nameLength);
+	path[dirLength + needsSlash + nameLength] = '\0';
+
+	if (createTexture) {
+		if (_textureLoader) _textureLoader->load(*page, String(path));
+		SpineExtension::free(path, __FILE__, __LINE__);
+	} else {
+		page->texturePath = String(path, true);
+	}
+	page->index = (int) _pages.size();
+	_pages.add(page);
+}
+
+/* Binary atlas format, all values are little endian 32 bit integers:
+ * header: magic, version, page count, region count, value count, index bucket count, string table size
+ * pages: name, format, min filter, mag filter, u wrap, v wrap, width, height, pma
+ * regions: name, page, index, x, y, width, height, offset x, offset y, original width, original height, degrees, first value,
+ *     name count
+ * values: per region name, the name, the value count, then the values
+ * index: region index or -1 per bucket, for open addressing with linear probing of the FNV-1a hash of the region name
+ * string table: null terminated names, referenced by byte offset */
+static const int BINARY_MAGIC = 0x4c544153; /* "SATL" */
+static const int BINARY_VERSION = 1;
+static const int HEADER_ENTRIES = 7;
+static const int PAGE_ENTRIES = 9;
+static const int REGION_ENTRIES = 14;
+
+static int readInt(const unsigned char *input) {
+	return (int) ((unsigned int) input[0] | ((unsigned int) input[1] << 8) | ((unsigned int) input[2] << 16) |
+				  ((unsigned int) input[3] << 24));
+}
+
+static void writeInt(Vector<char> &output, int value) {
+	output.add((char) (value & 0xff));
+	output.add((char) ((value >> 8) & 0xff));
+	output.add((char) ((value >> 16) & 0xff));
+	output.add((char) ((value >> 24) & 0xff));
+}
+
+static int writeString(Vector<char> &strings, const String &value) {
+	int offset = (int) strings.size();
+	for (size_t i = 0, n = value.length(); i < n; i++)
+		strings.add(value.buffer()[i]);
+	strings.add('\0');
+	return offset;
+}
+
+static const char *stringAt(const char *strings, int stringsSize, int offset) {
+	if (offset < 0 || offset >= stringsSize) return "";
+	// The string must be terminated within the string table.
+	if (!memchr(strings + offset, '\0', stringsSize - offset)) return "";
+	return strings + offset;
+}
+
+bool Atlas::isBinary(const char *data, int length) {
+	if (!data || length < HEADER_ENTRIES * 4) return false;
+	const unsigned char *input = (const unsigned char *) data;
+	return readInt(input) == BINARY_MAGIC && readInt(input + 4) == BINARY_VERSION;
+}
+
+void Atlas::loadBinary(const char *data, int length, const char *dir, bool createTexture) {
+	const unsigned char *input = (const unsigned char *) data;
+	int pageCount = readInt(input + 8);
+	int regionCount = readInt(input + 12);
+	int valueCount = readInt(input + 16);
+	int bucketCount = readInt(input + 20);
+	int stringsSize = readInt(input + 24);
+	if (pageCount < 0 || regionCount < 0 || valueCount < 0 || bucketCount < 0 || stringsSize < 0) return;
+	size_t intCount = HEADER_ENTRIES + (size_t) pageCount * PAGE_ENTRIES + (size_t) regionCount * REGION_ENTRIES +
+					  (size_t) valueCount + (size_t) bucketCount;
+	if ((size_t) length < intCount * 4 + (size_t) stringsSize) return;
+
+	const unsigned char *pages = input + HEADER_ENTRIES * 4;
+	const unsigned char *regions = pages + pageCount * PAGE_ENTRIES * 4;
+	const unsigned char *values = regions + regionCount * REGION_ENTRIES * 4;
+	const unsigned char *index = values + valueCount * 4;
+	const char *strings = (const char *) (index + bucketCount * 4);
+
+	_pages.ensureCapacity(pageCount);
+	for (int i = 0; i < pageCount; i++, pages += PAGE_ENTRIES * 4) {
+		AtlasPage *page = new (__FILE__, __LINE__) AtlasPage(String(stringAt(strings, stringsSize, readInt(pages))));
+		page->format = (Format) readInt(pages + 4);
+		page->minFilter = (TEXTURE_FILTER_ENUM) readInt(pages + 8);
+		page->magFilter = (TEXTURE_FILTER_ENUM) readInt(pages + 12);
+		page->uWrap = (TextureWrap) readInt(pages + 16);
+		page->vWrap = (TextureWrap) readInt(pages + 20);
+		page->width = readInt(pages + 24);
+		page->height = readInt(pages + 28);
+		page->pma = readInt(pages + 32) != 0;
+		addPage(page, dir, createTexture);
+	}
+
+	if (regionCount > 0) {
+		_regionBlock = SpineExtension::calloc<AtlasRegion>(regionCount, __FILE__, __LINE__);
+		_regionBlockSize = regionCount;
+	}
+	_regions.ensureCapacity(regionCount);
+	for (int i = 0; i < regionCount; i++, regions += REGION_ENTRIES * 4) {
+		AtlasRegion *region = new (_regionBlock + i) AtlasRegion();
+		region->name = stringAt(strings, stringsSize, readInt(regions));
+		int pageIndex = readInt(regions + 4);
+		AtlasPage *page = pageIndex >= 0 && pageIndex < pageCount ? _pages[pageIndex] : NULL;
+		region->page = page;
+		region->rendererObject = page ? page->texture : NULL;
+		region->index = readInt(regions + 8);
+		region->x = readInt(regions + 12);
+		region->y = readInt(regions + 16);
+		region->width = readInt(regions + 20);
+		region->height = readInt(regions + 24);
+		region->offsetX = (float) readInt(regions + 28);
+		region->offsetY = (float) readInt(regions + 32);
+		region->originalWidth = readInt(regions + 36);
+		region->originalHeight = readInt(regions + 40);
+		region->degrees = readInt(regions + 44);
+
+		int value = readInt(regions + 48), nameCount = readInt(regions + 52);
+		for (int ii = 0; ii < nameCount && value >= 0 && value + 2 <= valueCount; ii++) {
+			region->names.add(String(stringAt(strings, stringsSize, readInt(values + value * 4))));
+			int count = readInt(values + value * 4 + 4), iii = 0;
+			value += 2;
+			for (; iii < count && value < valueCount; iii++, value++)
+				region->values.add(readInt(values + value * 4));
+			region->valueCounts.add(iii);
+		}
+
+		if (page) {
+			region->u = (float) region->x / page->width;
+			region->v = (float) region->y / page->height;
+			if (region->degrees == 90) {
+				region->u2 = (float) (region->x + region->height) / page->width;
+				region->v2 = (float) (region->y + region->width) / page->height;
+			} else {
+				region->u2 = (float) (region->x + region->width) / page->width;
+				region->v2 = (float) (region->y + region->height) / page->height;
+			}
+		}
+		_regions.add(region);
+	}
+
+	// Use the prebuilt index unless it is malformed.
+	if (regionCount == 0 || bucketCount < regionCount * 2 || (bucketCount & (bucketCount - 1)) != 0) {
+		buildIndex();
+		return;
+	}
+	_index.setSize(bucketCount, -1);
+	int empty = 0;
+	for (int i = 0; i < bucketCount; i++, index += 4) {
+		int regionIndex = readInt(index);
+		if (regionIndex < -1 || regionIndex >= regionCount) {
+			buildIndex();
+			return;
+		}
+		if (regionIndex == -1) empty++;
+		_index[i] = regionIndex;
+	}
+	if (empty == 0) {
+		buildIndex();
+		return;
+	}
+	_indexedRegions = regionCount;
+}
+
+void Atlas::writeBinary(Vector<char> &output) {
+	if (_indexedRegions != _regions.size()) buildIndex();
+
+	Vector<char> strings;
+	Vector<int> pages;
+	for (size_t i = 0, n = _pages.size(); i < n; i++) {
+		AtlasPage *page = _pages[i];
+		pages.add(writeString(strings, page->name));
+		pages.add(page->format);
+		pages.add(page->minFilter);
+		pages.add(page->magFilter);
+		pages.add(page->uWrap);
+		pages.add(page->vWrap);
+		pages.add(page->width);
+		pages.add(page->height);
+		pages.add(page->pma ? 1 : 0);
+	}
+
+	Vector<int> regions, values;
+	for (size_t i = 0, n = _regions.size(); i < n; i++) {
+		AtlasRegion *region = _regions[i];
+		regions.add(writeString(strings, region->name));
+		regions.add(region->page ? _pages.indexOf(region->page) : -1);
+		regions.add(region->index);
+		regions.add(region->x);
+		regions.add(region->y);
+		regions.add(region->width);
+		regions.add(region->height);
+		regions.add((int) region->offsetX);
+		regions.add((int) region->offsetY);
+		regions.add(region->originalWidth);
+		regions.add(region->originalHeight);
+		regions.add(region->degrees);
+		regions.add((int) values.size());
+		regions.add((int) region->names.size());
+		// Regions created without value counts share the values equally between their names.
+		size_t nameCount = region->names.size();
+		bool counted = region->valueCounts.size() == nameCount;
+		size_t valuesPerName = nameCount > 0 ? region->values.size() / nameCount : 0;
+		for (size_t ii = 0, value = 0; ii < nameCount; ii++) {
+			size_t count = counted ? (size_t) region->valueCounts[ii] : valuesPerName;
+			if (value + count > region->values.size()) count = region->values.size() - value;
+			values.add(writeString(strings, region->names[ii]));
+			values.add((int) count);
+			for (size_t iii = 0; iii < count; iii++, value++)
+				values.add((int) region->values[value]);
+		}
+	}
+
+	output.clear();
+	output.ensureCapacity((HEADER_ENTRIES + pages.size() + regions.size() + values.size() + _index.size()) * 4 +
+						  strings.size());
+	writeInt(output, BINARY_MAGIC);
+	writeInt(output, BINARY_VERSION);
+	writeInt(output, (int) _pages.size());
+	writeInt(output, (int) _regions.size());
+	writeInt(output, (int) values.size());
+	writeInt(output, (int) _index.size());
+	writeInt(output, (int) strings.size());
+	for (size_t i = 0, n = pages.size(); i < n; i++)
+		writeInt(output, pages[i]);
+	for (size_t i = 0, n = regions.size(); i < n; i++)
+		writeInt(output, regions[i]);
+	for (size_t i = 0, n = values.size(); i < n; i++)
+		writeInt(output, values[i]);
+	for (size_t i = 0, n = _index.size(); i < n; i++)
+		writeInt(output, _index[i]);
+	for (size_t i = 0, n = strings.size(); i < n; i++)
+		output.add(strings[i]);
 }
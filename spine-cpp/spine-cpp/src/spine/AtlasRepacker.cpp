@@ -0,0 +1,252 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated September 24, 2021. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2021, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <spine/AtlasRepacker.h>
+
+#include <spine/ContainerUtil.h>
+#include <spine/MeshAttachment.h>
+#include <spine/RegionAttachment.h>
+#include <spine/Skin.h>
+#include <spine/TextureLoader.h>
+
+using namespace spine;
+
+static int getPackedWidth(AtlasRegion *region) {
+	return region->degrees == 90 ? region->height : region->width;
+}
+
+static int getPackedHeight(AtlasRegion *region) {
+	return region->degrees == 90 ? region->width : region->height;
+}
+
+static void addRegions(Vector<AtlasRegion *> &sources, TextureRegion *region, Sequence *sequence) {
+	if (sequence) {
+		Vector<TextureRegion *> &regions = sequence->getRegions();
+		for (size_t i = 0; i < regions.size(); i++) {
+			AtlasRegion *atlasRegion = static_cast<AtlasRegion *>(regions[i]);
+			if (atlasRegion && !sources.contains(atlasRegion)) sources.add(atlasRegion);
+		}
+	} else if (region) {
+		AtlasRegion *atlasRegion = static_cast<AtlasRegion *>(region);
+		if (!sources.contains(atlasRegion)) sources.add(atlasRegion);
+	}
+}
+
+AtlasRepacker::AtlasRepacker(int padding, int maxSize) : _padding(padding), _maxSize(maxSize), _skin(NULL), _page(NULL) {
+}
+
+AtlasRepacker::~AtlasRepacker() {
+	clear();
+}
+
+bool AtlasRepacker::repack(Skin &skin, TextureLoader &textureLoader, const String &name) {
+	clear();
+
+	// Find the regions used by the skin. Regions of attachments created by AtlasAttachmentLoader are AtlasRegions.
+	Vector<AtlasRegion *> sources;
+	Skin::AttachmentMap::Entries entries = skin.getAttachments();
+	while (entries.hasNext()) {
+		Attachment *attachment = entries.next()._attachment;
+		if (attachment->getRTTI().isExactly(RegionAttachment::rtti)) {
+			RegionAttachment *region = static_cast<RegionAttachment *>(attachment);
+			addRegions(sources, region->getRegion(), region->getSequence());
+		} else if (attachment->getRTTI().isExactly(MeshAttachment::rtti)) {
+			MeshAttachment *mesh = static_cast<MeshAttachment *>(attachment);
+			addRegions(sources, mesh->getRegion(), mesh->getSequence());
+		}
+	}
+	if (sources.size() == 0) return false;
+
+	Vector<const unsigned char *> sourcePixels;
+	for (size_t i = 0; i < sources.size(); i++) {
+		AtlasPage *page = sources[i]->page;
+		if (page->pma != sources[0]->page->pma) return false;
+		const unsigned char *pixels = textureLoader.getPixels(*page);
+		if (!pixels) return false;
+		sourcePixels.add(pixels);
+	}
+
+	// Sort by height, tallest first, for shelf packing.
+	for (size_t i = 1; i < sources.size(); i++) {
+		AtlasRegion *region = sources[i];
+		const unsigned char *pixels = sourcePixels[i];
+		size_t ii = i;
+		for (; ii > 0 && getPackedHeight(sources[ii - 1]) < getPackedHeight(region); ii--) {
+			sources[ii] = sources[ii - 1];
+			sourcePixels[ii] = sourcePixels[ii - 1];
+		}
+		sources[ii] = region;
+		sourcePixels[ii] = pixels;
+	}
+
+	// Start with the smallest power of two page which can hold the area of the regions, growing until they fit.
+	int area = 0;
+	for (size_t i = 0; i < sources.size(); i++)
+		area += (getPackedWidth(sources[i]) + _padding) * (getPackedHeight(sources[i]) + _padding);
+	int width = 1, height = 1;
+	while (width * height < area) {
+		if (width <= height) width <<= 1;
+		else height <<= 1;
+	}
+	Vector<int> positions;
+	while (!pack(sources, positions, width, height)) {
+		if (width <= height) width <<= 1;
+		else height <<= 1;
+		if (width > _maxSize || height > _maxSize) return false;
+	}
+
+	_page = new (__FILE__, __LINE__) AtlasPage(name);
+	AtlasPage *sourcePage = sources[0]->page;
+	_page->format = Format_RGBA8888;
+	_page->minFilter = sourcePage->minFilter;
+	_page->magFilter = sourcePage->magFilter;
+	_page->width = width;
+	_page->height = height;
+	_page->pma = sourcePage->pma;
+
+	_pixels.setSize(width * height * 4, 0);
+	_regions.ensureCapacity(sources.size());
+	for (size_t i = 0; i < sources.size(); i++) {
+		AtlasRegion *source = sources[i];
+		int x = positions[i << 1], y = positions[(i << 1) + 1];
+		int packedWidth = getPackedWidth(source), packedHeight = getPackedHeight(source);
+		const unsigned char *from = sourcePixels[i] + (source->y * source->page->width + source->x) * 4;
+		unsigned char *to = _pixels.buffer() + (y * width + x) * 4;
+		for (int row = 0; row < packedHeight; row++)
+			memcpy(to + row * width * 4, from + row * source->page->width * 4, packedWidth * 4);
+
+		AtlasRegion *region = new (__FILE__, __LINE__) AtlasRegion();
+		region->page = _page;
+		region->rendererObject = source->rendererObject == source ? region : NULL;
+		region->name = source->name;
+		region->index = source->index;
+		region->x = x;
+		region->y = y;
+		region->width = source->width;
+		region->height = source->height;
+		region->degrees = source->degrees;
+		region->offsetX = source->offsetX;
+		region->offsetY = source->offsetY;
+		region->originalWidth = source->originalWidth;
+		region->originalHeight = source->originalHeight;
+		region->splits.addAll(source->splits);
+		region->pads.addAll(source->pads);
+		region->names.addAll(source->names);
+		region->values.addAll(source->values);
+		region->u = (float) x / width;
+		region->v = (float) y / height;
+		region->u2 = (float) (x + packedWidth) / width;
+		region->v2 = (float) (y + packedHeight) / height;
+		_regions.add(region);
+	}
+
+	_skin = new (__FILE__, __LINE__) Skin(name);
+	_skin->getBones().addAll(skin.getBones());
+	_skin->getConstraints().addAll(skin.getConstraints());
+	Skin::AttachmentMap::Entries attachments = skin.getAttachments();
+	while (attachments.hasNext()) {
+		Skin::AttachmentMap::Entry &entry = attachments.next();
+		_skin->setAttachment(entry._slotIndex, entry._name, copyAttachment(entry._attachment, sources));
+	}
+	return true;
+}
+
+bool AtlasRepacker::pack(Vector<AtlasRegion *> &sources, Vector<int> &positions, int width, int height) {
+	positions.setSize(sources.size() << 1, 0);
+	int x = 0, y = 0, rowHeight = 0;
+	for (size_t i = 0; i < sources.size(); i++) {
+		int packedWidth = getPackedWidth(sources[i]), packedHeight = getPackedHeight(sources[i]);
+		if (x + packedWidth > width) {
+			x = 0;
+			y += rowHeight + _padding;
+			rowHeight = 0;
+		}
+		if (x + packedWidth > width || y + packedHeight > height) return false;
+		positions[i << 1] = x;
+		positions[(i << 1) + 1] = y;
+		x += packedWidth + _padding;
+		if (packedHeight > rowHeight) rowHeight = packedHeight;
+	}
+	return true;
+}
+
+Attachment *AtlasRepacker::copyAttachment(Attachment *attachment, Vector<AtlasRegion *> &sources) {
+	Sequence *sequence;
+	if (attachment->getRTTI().isExactly(RegionAttachment::rtti)) {
+		RegionAttachment *region = static_cast<RegionAttachment *>(attachment->copy());
+		sequence = region->getSequence();
+		if (!sequence && region->getRegion()) {
+			region->setRegion(_regions[sources.indexOf(static_cast<AtlasRegion *>(region->getRegion()))]);
+			region->updateRegion();
+		}
+		attachment = region;
+	} else if (attachment->getRTTI().isExactly(MeshAttachment::rtti)) {
+		MeshAttachment *mesh = static_cast<MeshAttachment *>(attachment->copy());
+		sequence = mesh->getSequence();
+		if (!sequence && mesh->getRegion()) {
+			mesh->setRegion(_regions[sources.indexOf(static_cast<AtlasRegion *>(mesh->getRegion()))]);
+			mesh->updateRegion();
+		}
+		attachment = mesh;
+	} else
+		return attachment;
+
+	if (sequence) {
+		Vector<TextureRegion *> &regions = sequence->getRegions();
+		for (size_t i = 0; i < regions.size(); i++) {
+			if (regions[i]) regions[i] = _regions[sources.indexOf(static_cast<AtlasRegion *>(regions[i]))];
+		}
+	}
+	return attachment;
+}
+
+Skin *AtlasRepacker::getSkin() {
+	return _skin;
+}
+
+AtlasPage *AtlasRepacker::getPage() {
+	return _page;
+}
+
+Vector<AtlasRegion *> &AtlasRepacker::getRegions() {
+	return _regions;
+}
+
+Vector<unsigned char> &AtlasRepacker::getPixels() {
+	return _pixels;
+}
+
+void AtlasRepacker::clear() {
+	delete _skin;
+	_skin = NULL;
+	ContainerUtil::cleanUpVectorOfPointers(_regions);
+	delete _page;
+	_page = NULL;
+	_pixels.clear();
+}
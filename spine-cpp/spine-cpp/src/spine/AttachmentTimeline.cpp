@@ -98,3 +98,10 @@ void AttachmentTimeline::setFrame(int frame, float time, const String &attachmen
 Vector<String> &AttachmentTimeline::getAttachmentNames() {
 	return _attachmentNames;
 }
+
+size_t AttachmentTimeline::getMemoryUsage() {
+	size_t usage = Timeline::getMemoryUsage() + _attachmentNames.getCapacity() * sizeof(String);
+	for (size_t i = 0; i < _attachmentNames.size(); i++)
+		if (!_attachmentNames[i].isEmpty()) usage += _attachmentNames[i].length() + 1;
+	return usage;
+}
@@ -0,0 +1,258 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated September 24, 2021. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2021, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <spine/BakedTimeline.h>
+
+#include <spine/Animation.h>
+#include <spine/AnimationState.h>
+#include <spine/Bone.h>
+#include <spine/BoneData.h>
+#include <spine/Event.h>
+#include <spine/Skeleton.h>
+#include <spine/SkeletonData.h>
+
+using namespace spine;
+
+RTTI_IMPL(BakedTimeline, Timeline)
+
+static const int BoneProperties = Property_Rotate | Property_X | Property_Y | Property_ScaleX | Property_ScaleY |
+								  Property_ShearX | Property_ShearY;
+
+float *BakedTimeline::getBoneValue(Bone &bone, int property) {
+	switch (property) {
+		case Property_Rotate:
+			return &bone._rotation;
+		case Property_X:
+			return &bone._x;
+		case Property_Y:
+			return &bone._y;
+		case Property_ScaleX:
+			return &bone._scaleX;
+		case Property_ScaleY:
+			return &bone._scaleY;
+		case Property_ShearX:
+			return &bone._shearX;
+		default:
+			return &bone._shearY;
+	}
+}
+
+float BakedTimeline::getSetupValue(BoneData &data, int property) {
+	switch (property) {
+		case Property_Rotate:
+			return data._rotation;
+		case Property_X:
+			return data._x;
+		case Property_Y:
+			return data._y;
+		case Property_ScaleX:
+			return data._scaleX;
+		case Property_ScaleY:
+			return data._scaleY;
+		case Property_ShearX:
+			return data._shearX;
+		default:
+			return data._shearY;
+	}
+}
+
+size_t BakedTimeline::getSampleCount(float duration, float fps) {
+	if (fps <= 0) return 1;
+	// A sample for each whole frame, and one at the duration when it is between frames.
+	float position = duration * fps;
+	size_t frames = (size_t) position;
+	return frames < position ? frames + 2 : frames + 1;
+}
+
+BakedTimeline::BakedTimeline(SkeletonData &skeletonData, Animation &animation, float fps)
+	: Timeline(getSampleCount(animation.getDuration(), fps), 1), _fps(fps) {
+	assert(fps > 0);
+	Vector<Timeline *> &timelines = animation.getTimelines();
+	Vector<PropertyId> ids;
+	for (size_t i = 0, n = timelines.size(); i < n; i++) {
+		if (!isBoneTimeline(*timelines[i])) continue;
+		Vector<PropertyId> &timelineIds = timelines[i]->getPropertyIds();
+		for (size_t ii = 0; ii < timelineIds.size(); ii++) {
+			if (ids.contains(timelineIds[ii])) continue;
+			ids.add(timelineIds[ii]);
+			_properties.add((int) (timelineIds[ii] >> 32));
+			_boneIndices.add((int) (timelineIds[ii] & 0xffffffff));
+		}
+	}
+	setPropertyIds(ids.buffer(), ids.size());
+
+	// Sample the absolute local values, then quantize each channel to its range.
+	size_t frameCount = getFrameCount(), channelCount = _properties.size();
+	Vector<float> values;
+	values.setSize(frameCount * channelCount, 0);
+	Skeleton skeleton(&skeletonData);
+	for (size_t i = 0, n = skeleton._bones.size(); i < n; i++)
+		skeleton._bones[i]->_active = true;
+	for (size_t frame = 0; frame < frameCount; frame++) {
+		float time = frame < frameCount - 1 ? frame / fps : animation.getDuration();
+		_frames[frame] = time;
+		skeleton.setBonesToSetupPose();
+		for (size_t i = 0, n = timelines.size(); i < n; i++) {
+			if (isBoneTimeline(*timelines[i]))
+				timelines[i]->apply(skeleton, time, time, NULL, 1, MixBlend_Setup, MixDirection_In);
+		}
+		for (size_t c = 0; c < channelCount; c++)
+			values[frame * channelCount + c] = *getBoneValue(*skeleton._bones[_boneIndices[c]], _properties[c]);
+	}
+
+	_offsets.setSize(channelCount, 0);
+	_scales.setSize(channelCount, 0);
+	_samples.setSize(frameCount * channelCount, 0);
+	for (size_t c = 0; c < channelCount; c++) {
+		float min = values[c], max = values[c];
+		for (size_t frame = 1; frame < frameCount; frame++) {
+			float value = values[frame * channelCount + c];
+			min = MathUtil::min(min, value);
+			max = MathUtil::max(max, value);
+		}
+		_offsets[c] = min;
+		_scales[c] = (max - min) / 65535;
+		if (_scales[c] == 0) continue;
+		for (size_t frame = 0; frame < frameCount; frame++) {
+			size_t i = frame * channelCount + c;
+			_samples[i] = (unsigned short) ((values[i] - min) / _scales[c] + 0.5f);
+		}
+	}
+}
+
+BakedTimeline::~BakedTimeline() {
+}
+
+void BakedTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
+						  MixBlend blend, MixDirection direction) {
+	SP_UNUSED(lastTime);
+	SP_UNUSED(pEvents);
+
+	size_t channelCount = _properties.size(), frame;
+	float t;
+	getFrame(time, frame, t);
+	unsigned short *before = _samples.buffer() + frame * channelCount;
+	unsigned short *after = frame + 1 < getFrameCount() ? before + channelCount : before;
+
+	for (size_t c = 0; c < channelCount; c++) {
+		Bone *bone = skeleton._bones[_boneIndices[c]];
+		if (!bone->_active) continue;
+		float value = _offsets[c] + (before[c] + (after[c] - before[c]) * t) * _scales[c];
+		applyValue(*getBoneValue(*bone, _properties[c]), getSetupValue(bone->_data, _properties[c]), _properties[c], value,
+				   alpha, blend, direction, NULL, false);
+	}
+}
+
+void BakedTimeline::mixChannel(Skeleton &skeleton, size_t channel, float time, float alpha, MixBlend blend,
+							   MixDirection direction, float *timelinesRotation, bool firstFrame) {
+	Bone *bone = skeleton._bones[_boneIndices[channel]];
+	if (!bone->_active) return;
+	size_t channelCount = _properties.size(), frame;
+	float t;
+	getFrame(time, frame, t);
+	unsigned short *before = _samples.buffer() + frame * channelCount + channel;
+	unsigned short *after = frame + 1 < getFrameCount() ? before + channelCount : before;
+	float value = _offsets[channel] + (*before + (*after - *before) * t) * _scales[channel];
+	applyValue(*getBoneValue(*bone, _properties[channel]), getSetupValue(bone->_data, _properties[channel]),
+			   _properties[channel], value, alpha, blend, direction, timelinesRotation, firstFrame);
+}
+
+void BakedTimeline::getFrame(float time, size_t &frame, float &t) {
+	size_t last = getFrameCount() - 1;
+	float position = MathUtil::clamp(time * _fps, 0, (float) last);
+	frame = (size_t) position;
+	if (frame + 1 < last) {
+		t = position - frame;
+		return;
+	}
+	if (last == 0) {
+		frame = 0;
+		t = 0;
+		return;
+	}
+	// The last sample is at the duration, which can be less than a whole frame after the sample before it.
+	frame = last - 1;
+	float time1 = _frames[frame], duration = _frames[last] - time1;
+	t = duration > 0 ? MathUtil::clamp((time - time1) / duration, 0, 1) : 1;
+}
+
+void BakedTimeline::applyValue(float &target, float setup, int property, float value, float alpha, MixBlend blend,
+							   MixDirection direction, float *timelinesRotation, bool firstFrame) {
+	if (blend == MixBlend_Add) {
+		target += (value - setup) * alpha;
+		return;
+	}
+	if (alpha == 1) {
+		target = value;
+		return;
+	}
+	float base = blend == MixBlend_Setup ? setup : target;
+	switch (property) {
+		case Property_Rotate:
+			if (timelinesRotation)
+				target = AnimationState::mixRotation(base, value, alpha, timelinesRotation, firstFrame);
+			else
+				target = base + (value - base) * alpha;
+			break;
+		case Property_ScaleX:
+		case Property_ScaleY:
+			// Mix the scale magnitude, keeping the sign of the pose mixed from, like ScaleTimeline.
+			if (direction == MixDirection_Out)
+				target = base + (MathUtil::abs(value) * MathUtil::sign(base) - base) * alpha;
+			else {
+				base = MathUtil::abs(base) * MathUtil::sign(value);
+				target = base + (value - base) * alpha;
+			}
+			break;
+		default:
+			target = base + (value - base) * alpha;
+	}
+}
+
+float BakedTimeline::getFps() {
+	return _fps;
+}
+
+size_t BakedTimeline::getChannelCount() {
+	return _properties.size();
+}
+
+size_t BakedTimeline::getMemoryUsage() {
+	return Timeline::getMemoryUsage() + (_boneIndices.getCapacity() + _properties.getCapacity()) * sizeof(int) +
+		   (_offsets.getCapacity() + _scales.getCapacity()) * sizeof(float) +
+		   _samples.getCapacity() * sizeof(unsigned short);
+}
+
+bool BakedTimeline::isBoneTimeline(Timeline &timeline) {
+	Vector<PropertyId> &ids = timeline.getPropertyIds();
+	for (size_t i = 0; i < ids.size(); i++) {
+		if (((ids[i] >> 32) & BoneProperties) == 0) return false;
+	}
+	return ids.size() > 0 && !timeline.getRTTI().isExactly(BakedTimeline::rtti);
+}
@@ -70,13 +70,93 @@ Bone::Bone(BoneData &data, Skeleton &skeleton, Bone *parent) : Updatable(),
 															   _c(0),
 															   _d(1),
 															   _worldY(0),
+															   _rigidA(1),
+															   _rigidB(0),
+															   _rigidC(0),
+															   _rigidD(1),
+															   _lastX(0),
+															   _lastY(0),
+															   _lastRotation(0),
+															   _lastScaleX(0),
+															   _lastScaleY(0),
+															   _lastShearX(0),
+															   _lastShearY(0),
+															   _localRotation(0),
+															   _localScaleX(0),
+															   _localScaleY(0),
+															   _localShearX(0),
+															   _localShearY(0),
+															   _la(0),
+															   _lb(0),
+															   _lc(0),
+															   _ld(0),
+															   _updateFrame(0),
 															   _sorted(false),
-															   _active(false) {
+															   _active(false),
+															   _rigid(false),
+															   _modified(true),
+															   _localFastTrig(MathUtil::isFastTrig()) {
 	setToSetupPose();
 }
 
 void Bone::update() {
-	updateWorldTransform(_ax, _ay, _arotation, _ascaleX, _ascaleY, _ashearX, _ashearY);
+	if (_skeleton._incremental) {
+		// Skip bones whose world transform would be computed from the same values as last time.
+		if (!_skeleton._updateAll && !_modified && (!_parent || _parent->_updateFrame != _skeleton._updateFrame) &&
+			_ax == _lastX && _ay == _lastY && _arotation == _lastRotation && _ascaleX == _lastScaleX &&
+			_ascaleY == _lastScaleY && _ashearX == _lastShearX && _ashearY == _lastShearY)
+			return;
+		_lastX = _ax;
+		_lastY = _ay;
+		_lastRotation = _arotation;
+		_lastScaleX = _ascaleX;
+		_lastScaleY = _ascaleY;
+		_lastShearX = _ashearX;
+		_lastShearY = _ashearY;
+		_updateFrame = _skeleton._updateFrame;
+	}
+	_skeleton._updatedBones++;
+	if (_rigid)
+		updateRigidWorldTransform();
+	else
+		updateWorldTransform(_ax, _ay, _arotation, _ascaleX, _ascaleY, _ashearX, _ashearY);
+	_modified = false;
+}
+
+void Bone::setModified() {
+	_modified = true;
+	_updateFrame = _skeleton._updateFrame;
+}
+
+void Bone::updateLocalMatrix(float rotation, float scaleX, float scaleY, float shearX, float shearY) {
+	bool fastTrig = MathUtil::isFastTrig();
+	if (rotation == _localRotation && scaleX == _localScaleX && scaleY == _localScaleY && shearX == _localShearX &&
+		shearY == _localShearY && fastTrig == _localFastTrig)
+		return;
+	_localRotation = rotation;
+	_localScaleX = scaleX;
+	_localScaleY = scaleY;
+	_localShearX = shearX;
+	_localShearY = shearY;
+	_localFastTrig = fastTrig;
+	float rotationY = rotation + 90 + shearY;
+	_la = MathUtil::cosDeg(rotation + shearX) * scaleX;
+	_lb = MathUtil::cosDeg(rotationY) * scaleY;
+	_lc = MathUtil::sinDeg(rotation + shearX) * scaleX;
+	_ld = MathUtil::sinDeg(rotationY) * scaleY;
+}
+
+void Bone::updateRigidWorldTransform() {
+	Bone *parent = _parent;
+	assert(parent);
+	float pa = parent->_a, pb = parent->_b, pc = parent->_c, pd = parent->_d;
+	float x = _data.getX(), y = _data.getY();
+	_worldX = pa * x + pb * y + parent->_worldX;
+	_worldY = pc * x + pd * y + parent->_worldY;
+	_a = pa * _rigidA + pb * _rigidC;
+	_b = pa * _rigidB + pb * _rigidD;
+	_c = pc * _rigidA + pd * _rigidC;
+	_d = pc * _rigidB + pd * _rigidD;
 }
 
 void Bone::updateWorldTransform() {
@@ -95,15 +175,16 @@ void Bone::updateWorldTransform(float x, float y, float rotation, float scaleX,
 	_ascaleY = scaleY;
 	_ashearX = shearX;
 	_ashearY = shearY;
+	setModified();
 
 	if (!parent) { /* Root bone. */
-		float rotationY = rotation + 90 + shearY;
 		float sx = _skeleton.getScaleX();
 		float sy = _skeleton.getScaleY();
-		_a = MathUtil::cosDeg(rotation + shearX) * scaleX * sx;
-		_b = MathUtil::cosDeg(rotationY) * scaleY * sx;
-		_c = MathUtil::sinDeg(rotation + shearX) * scaleX * sy;
-		_d = MathUtil::sinDeg(rotationY) * scaleY * sy;
+		updateLocalMatrix(rotation, scaleX, scaleY, shearX, shearY);
+		_a = _la * sx;
+		_b = _lb * sx;
+		_c = _lc * sy;
+		_d = _ld * sy;
 		_worldX = x * sx + _skeleton.getX();
 		_worldY = y * sy + _skeleton.getY();
 		return;
@@ -119,23 +200,19 @@ void Bone::updateWorldTransform(float x, float y, float rotation, float scaleX,
 
 	switch (_data.getTransformMode()) {
 		case TransformMode_Normal: {
-			float rotationY = rotation + 90 + shearY;
-			float la = MathUtil::cosDeg(rotation + shearX) * scaleX;
-			float lb = MathUtil::cosDeg(rotationY) * scaleY;
-			float lc = MathUtil::sinDeg(rotation + shearX) * scaleX;
-			float ld = MathUtil::sinDeg(rotationY) * scaleY;
-			_a = pa * la + pb * lc;
-			_b = pa * lb + pb * ld;
-			_c = pc * la + pd * lc;
-			_d = pc * lb + pd * ld;
+			updateLocalMatrix(rotation, scaleX, scaleY, shearX, shearY);
+			_a = pa * _la + pb * _lc;
+			_b = pa * _lb + pb * _ld;
+			_c = pc * _la + pd * _lc;
+			_d = pc * _lb + pd * _ld;
 			return;
 		}
 		case TransformMode_OnlyTranslation: {
-			float rotationY = rotation + 90 + shearY;
-			_a = MathUtil::cosDeg(rotation + shearX) * scaleX;
-			_b = MathUtil::cosDeg(rotationY) * scaleY;
-			_c = MathUtil::sinDeg(rotation + shearX) * scaleX;
-			_d = MathUtil::sinDeg(rotationY) * scaleY;
+			updateLocalMatrix(rotation, scaleX, scaleY, shearX, shearY);
+			_a = _la;
+			_b = _lb;
+			_c = _lc;
+			_d = _ld;
 			break;
 		}
 		case TransformMode_NoRotationOrReflection: {
@@ -259,6 +336,7 @@ void Bone::rotateWorld(float degrees) {
 	_b = cos * b - sin * d;
 	_c = sin * a + cos * c;
 	_d = sin * b + cos * d;
+	_modified = true;
 }
 
 float Bone::getWorldToLocalRotationX() {
@@ -427,6 +505,7 @@ float Bone::getA() {
 
 void Bone::setA(float inValue) {
 	_a = inValue;
+	_modified = true;
 }
 
 float Bone::getB() {
@@ -435,6 +514,7 @@ float Bone::getB() {
 
 void Bone::setB(float inValue) {
 	_b = inValue;
+	_modified = true;
 }
 
 float Bone::getC() {
@@ -443,6 +523,7 @@ float Bone::getC() {
 
 void Bone::setC(float inValue) {
 	_c = inValue;
+	_modified = true;
 }
 
 float Bone::getD() {
@@ -451,6 +532,7 @@ float Bone::getD() {
 
 void Bone::setD(float inValue) {
 	_d = inValue;
+	_modified = true;
 }
 
 float Bone::getWorldX() {
@@ -459,6 +541,7 @@ float Bone::getWorldX() {
 
 void Bone::setWorldX(float inValue) {
 	_worldX = inValue;
+	_modified = true;
 }
 
 float Bone::getWorldY() {
@@ -467,6 +550,7 @@ float Bone::getWorldY() {
 
 void Bone::setWorldY(float inValue) {
 	_worldY = inValue;
+	_modified = true;
 }
 
 float Bone::getWorldRotationX() {
@@ -486,6 +570,8 @@ float Bone::getWorldScaleY() {
 }
 
 void Bone::updateAppliedTransform() {
+	// Called after constraints change the world transform directly.
+	setModified();
 	Bone *parent = _parent;
 	if (!parent) {
 		_ax = _worldX - _skeleton.getX();
@@ -574,3 +660,7 @@ bool Bone::isActive() {
 void Bone::setActive(bool inValue) {
 	_active = inValue;
 }
+
+bool Bone::isRigid() {
+	return _rigid;
+}
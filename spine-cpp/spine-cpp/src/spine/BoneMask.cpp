@@ -0,0 +1,199 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated September 24, 2021. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2021, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <spine/BoneMask.h>
+
+#include <spine/Animation.h>
+#include <spine/BoneData.h>
+#include <spine/IkConstraintData.h>
+#include <spine/PathAttachment.h>
+#include <spine/PathConstraintData.h>
+#include <spine/Property.h>
+#include <spine/SkeletonData.h>
+#include <spine/Skin.h>
+#include <spine/SlotData.h>
+#include <spine/Timeline.h>
+#include <spine/TransformConstraintData.h>
+
+using namespace spine;
+
+BoneMask::BoneMask(SkeletonData &skeletonData, Vector<BoneData *> &bones) {
+	Vector<BoneData *> &allBones = skeletonData.getBones();
+	Vector<SlotData *> &slots = skeletonData.getSlots();
+	Vector<IkConstraintData *> &ikConstraints = skeletonData.getIkConstraints();
+	Vector<TransformConstraintData *> &transformConstraints = skeletonData.getTransformConstraints();
+	Vector<PathConstraintData *> &pathConstraints = skeletonData.getPathConstraints();
+	_boneFlags.setSize(allBones.size(), false);
+	_slotFlags.setSize(slots.size(), false);
+	_ikConstraintFlags.setSize(ikConstraints.size(), false);
+	_transformConstraintFlags.setSize(transformConstraints.size(), false);
+	_pathConstraintFlags.setSize(pathConstraints.size(), false);
+
+	for (size_t i = 0; i < bones.size(); i++)
+		addBone(bones[i]);
+
+	// A constraint is needed when it constrains a bone in the mask. Its target and constrained bones are then needed too,
+	// which may in turn need more constraints, so repeat until nothing is added.
+	Vector<Attachment *> attachments;
+	bool changed = true;
+	while (changed) {
+		changed = false;
+		for (size_t i = 0, n = ikConstraints.size(); i < n; i++) {
+			if (!containsAny(ikConstraints[i]->getBones())) continue;
+			_ikConstraintFlags[i] = true;
+			changed |= addBone(ikConstraints[i]->getTarget());
+			changed |= addBones(ikConstraints[i]->getBones());
+		}
+		for (size_t i = 0, n = transformConstraints.size(); i < n; i++) {
+			if (!containsAny(transformConstraints[i]->getBones())) continue;
+			_transformConstraintFlags[i] = true;
+			changed |= addBone(transformConstraints[i]->getTarget());
+			changed |= addBones(transformConstraints[i]->getBones());
+		}
+		for (size_t i = 0, n = pathConstraints.size(); i < n; i++) {
+			if (!containsAny(pathConstraints[i]->getBones())) continue;
+			_pathConstraintFlags[i] = true;
+			SlotData *target = pathConstraints[i]->getTarget();
+			changed |= addBone(&target->getBoneData());
+			changed |= addBones(pathConstraints[i]->getBones());
+
+			// The path may be weighted to other bones, see Skeleton::sortPathConstraintAttachment().
+			Vector<Skin *> &skins = skeletonData.getSkins();
+			for (size_t s = 0; s < skins.size(); s++) {
+				attachments.clear();
+				skins[s]->findAttachmentsForSlot(target->getIndex(), attachments);
+				for (size_t a = 0; a < attachments.size(); a++) {
+					if (!attachments[a]->getRTTI().instanceOf(PathAttachment::rtti)) continue;
+					Vector<int> &pathBones = static_cast<PathAttachment *>(attachments[a])->getBones();
+					for (size_t b = 0, nb = pathBones.size(); b < nb;) {
+						size_t nn = pathBones[b++];
+						nn += b;
+						while (b < nn)
+							changed |= addBone(allBones[pathBones[b++]]);
+					}
+				}
+			}
+		}
+	}
+
+	for (size_t i = 0, n = allBones.size(); i < n; i++)
+		if (_boneFlags[i]) _bones.add(allBones[i]);
+	for (size_t i = 0, n = slots.size(); i < n; i++)
+		_slotFlags[i] = _boneFlags[slots[i]->getBoneData().getIndex()];
+	for (size_t i = 0, n = ikConstraints.size(); i < n; i++)
+		if (_ikConstraintFlags[i]) _constraints.add(ikConstraints[i]);
+	for (size_t i = 0, n = transformConstraints.size(); i < n; i++)
+		if (_transformConstraintFlags[i]) _constraints.add(transformConstraints[i]);
+	for (size_t i = 0, n = pathConstraints.size(); i < n; i++)
+		if (_pathConstraintFlags[i]) _constraints.add(pathConstraints[i]);
+}
+
+BoneMask::~BoneMask() {
+}
+
+Vector<BoneData *> &BoneMask::getBones() {
+	return _bones;
+}
+
+Vector<ConstraintData *> &BoneMask::getConstraints() {
+	return _constraints;
+}
+
+bool BoneMask::containsBone(BoneData &bone) {
+	return _boneFlags[bone.getIndex()];
+}
+
+void BoneMask::getMaskedTimelines(Animation &animation, Vector<bool> &masked) {
+	Vector<Timeline *> &timelines = animation.getTimelines();
+	masked.setSize(timelines.size(), true);
+	for (size_t i = 0, n = timelines.size(); i < n; i++) {
+		bool timelineMasked = true;
+		Vector<PropertyId> &ids = timelines[i]->getPropertyIds();
+		for (size_t ii = 0; ii < ids.size() && timelineMasked; ii++) {
+			size_t index = (size_t) (ids[ii] & 0xffffffff);
+			switch ((int) (ids[ii] >> 32)) {
+				case Property_Rotate:
+				case Property_X:
+				case Property_Y:
+				case Property_ScaleX:
+				case Property_ScaleY:
+				case Property_ShearX:
+				case Property_ShearY:
+					timelineMasked = !_boneFlags[index];
+					break;
+				case Property_Rgb:
+				case Property_Alpha:
+				case Property_Rgb2:
+				case Property_Attachment:
+					timelineMasked = !_slotFlags[index];
+					break;
+				case Property_Deform:
+				case Property_Sequence:
+					timelineMasked = !_slotFlags[index >> 16];
+					break;
+				case Property_IkConstraint:
+					timelineMasked = !_ikConstraintFlags[index];
+					break;
+				case Property_TransformConstraint:
+					timelineMasked = !_transformConstraintFlags[index];
+					break;
+				case Property_PathConstraintPosition:
+				case Property_PathConstraintSpacing:
+				case Property_PathConstraintMix:
+					timelineMasked = !_pathConstraintFlags[index];
+					break;
+				default:
+					timelineMasked = false;
+			}
+		}
+		masked[i] = timelineMasked;
+	}
+}
+
+bool BoneMask::containsAny(Vector<BoneData *> &bones) {
+	for (size_t i = 0, n = bones.size(); i < n; i++)
+		if (_boneFlags[bones[i]->getIndex()]) return true;
+	return false;
+}
+
+bool BoneMask::addBones(Vector<BoneData *> &bones) {
+	bool added = false;
+	for (size_t i = 0, n = bones.size(); i < n; i++)
+		added |= addBone(bones[i]);
+	return added;
+}
+
+bool BoneMask::addBone(BoneData *bone) {
+	bool added = false;
+	for (; bone && !_boneFlags[bone->getIndex()]; bone = bone->getParent()) {
+		_boneFlags[bone->getIndex()] = true;
+		added = true;
+	}
+	return added;
+}
@@ -0,0 +1,208 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated September 24, 2021. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2021, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifdef SPINE_BULK_LOADER
+
+#include <spine/BulkLoader.h>
+
+#include <spine/Atlas.h>
+#include <spine/SkeletonBinary.h>
+#include <spine/SkeletonData.h>
+#include <spine/SkeletonJson.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+using namespace spine;
+
+namespace spine {
+	class BulkLoaderThread : public SpineObject {
+	public:
+		explicit BulkLoaderThread(BulkLoader *loader) : thread(&BulkLoader::run, loader) {}
+
+		std::thread thread;
+	};
+
+	class BulkLoaderWorkers : public SpineObject {
+	public:
+		Vector<BulkLoaderThread *> threads;
+		std::mutex mutex;
+		std::condition_variable queuedCondition;
+		std::condition_variable completedCondition;
+	};
+}
+
+BulkLoadResult::BulkLoadResult() : index(0), scale(1), atlas(NULL), skeletonData(NULL) {
+}
+
+BulkLoader::BulkLoader(TextureLoader *textureLoader, int threadCount) : _textureLoader(textureLoader),
+																		_workers(NULL),
+																		_nextQueued(0),
+																		_nextCompleted(0),
+																		_added(0),
+																		_pending(0),
+																		_stop(false) {
+	// Create the default extension now, before workers use it.
+	SpineExtension::getInstance();
+	if (threadCount <= 0) threadCount = (int) std::thread::hardware_concurrency();
+	if (threadCount <= 0) threadCount = 1;
+	_workers = new (__FILE__, __LINE__) BulkLoaderWorkers();
+	for (int i = 0; i < threadCount; i++)
+		_workers->threads.add(new (__FILE__, __LINE__) BulkLoaderThread(this));
+}
+
+BulkLoader::~BulkLoader() {
+	{
+		std::lock_guard<std::mutex> lock(_workers->mutex);
+		_stop = true;
+	}
+	_workers->queuedCondition.notify_all();
+	for (size_t i = 0; i < _workers->threads.size(); i++) {
+		_workers->threads[i]->thread.join();
+		delete _workers->threads[i];
+	}
+	delete _workers;
+
+	for (size_t i = _nextCompleted; i < _completed.size(); i++) {
+		BulkLoadResult *result = _completed[i];
+		delete result->skeletonData;
+		delete result->atlas;
+		delete result;
+	}
+}
+
+int BulkLoader::add(const String &skeletonPath, const String &atlasPath, float scale) {
+	BulkLoadResult *result = new (__FILE__, __LINE__) BulkLoadResult();
+	result->skeletonPath = skeletonPath;
+	result->atlasPath = atlasPath;
+	result->scale = scale;
+	{
+		std::lock_guard<std::mutex> lock(_workers->mutex);
+		result->index = _added++;
+		_pending++;
+		_queued.add(result);
+	}
+	_workers->queuedCondition.notify_one();
+	return result->index;
+}
+
+bool BulkLoader::poll(BulkLoadResult &result) {
+	BulkLoadResult *completed;
+	{
+		std::lock_guard<std::mutex> lock(_workers->mutex);
+		if (_nextCompleted == _completed.size()) return false;
+		completed = _completed[_nextCompleted++];
+		if (_nextCompleted == _completed.size()) {
+			_completed.clear();
+			_nextCompleted = 0;
+		}
+	}
+	if (completed->atlas) completed->atlas->createTextures();
+	result.index = completed->index;
+	result.skeletonPath = completed->skeletonPath;
+	result.atlasPath = completed->atlasPath;
+	result.scale = completed->scale;
+	result.atlas = completed->atlas;
+	result.skeletonData = completed->skeletonData;
+	result.error = completed->error;
+	delete completed;
+	return true;
+}
+
+void BulkLoader::wait() {
+	std::unique_lock<std::mutex> lock(_workers->mutex);
+	while (_pending > 0)
+		_workers->completedCondition.wait(lock);
+}
+
+int BulkLoader::getPendingCount() {
+	std::lock_guard<std::mutex> lock(_workers->mutex);
+	return _pending;
+}
+
+void BulkLoader::run() {
+	while (true) {
+		BulkLoadResult *result;
+		{
+			std::unique_lock<std::mutex> lock(_workers->mutex);
+			while (!_stop && _nextQueued == _queued.size())
+				_workers->queuedCondition.wait(lock);
+			// Queued pairs are still loaded after stopping.
+			if (_nextQueued == _queued.size()) return;
+			result = _queued[_nextQueued++];
+			if (_nextQueued == _queued.size()) {
+				_queued.clear();
+				_nextQueued = 0;
+			}
+		}
+
+		load(*result);
+
+		{
+			std::lock_guard<std::mutex> lock(_workers->mutex);
+			_completed.add(result);
+			_pending--;
+		}
+		_workers->completedCondition.notify_all();
+	}
+}
+
+void BulkLoader::load(BulkLoadResult &result) {
+	Atlas *atlas = new (__FILE__, __LINE__) Atlas(result.atlasPath, _textureLoader, false);
+	if (atlas->getPages().size() == 0) {
+		result.error = String("Unable to read atlas file: ").append(result.atlasPath);
+		delete atlas;
+		return;
+	}
+
+	// Each pair uses its own reader, so the readers' state is never shared between threads.
+	SkeletonData *skeletonData;
+	const String &path = result.skeletonPath;
+	size_t length = path.length();
+	if (length > 5 && strcmp(path.buffer() + length - 5, ".skel") == 0) {
+		SkeletonBinary binary(atlas);
+		binary.setScale(result.scale);
+		skeletonData = binary.readSkeletonDataFile(path);
+		if (!skeletonData) result.error = binary.getError();
+	} else {
+		SkeletonJson json(atlas);
+		json.setScale(result.scale);
+		skeletonData = json.readSkeletonDataFile(path);
+		if (!skeletonData) result.error = json.getError();
+	}
+	if (!skeletonData) {
+		delete atlas;
+		return;
+	}
+	result.atlas = atlas;
+	result.skeletonData = skeletonData;
+}
+
+#endif
@@ -0,0 +1,111 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated September 24, 2021. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2021, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <spine/ChromeTraceProfiler.h>
+
+#include <spine/Debug.h>
+
+#include <thread>
+
+using namespace spine;
+
+ChromeTraceProfiler::ChromeTraceProfiler(DebugExtension *debugExtension) : _debugExtension(debugExtension),
+																		   _start(std::chrono::steady_clock::now()) {
+}
+
+void ChromeTraceProfiler::add(const char *name, char phase, double value) {
+	Event event;
+	event.name = name;
+	event.phase = phase;
+	event.thread = std::hash<std::thread::id>()(std::this_thread::get_id()) % 1000000;
+	event.time = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - _start).count();
+	event.value = value;
+	std::lock_guard<std::mutex> lock(_mutex);
+	_events.push_back(event);
+}
+
+void ChromeTraceProfiler::beginZone(const char *name) {
+	add(name, 'B', _debugExtension ? (double) (_debugExtension->getAllocations() + _debugExtension->getReallocations()) : 0);
+}
+
+void ChromeTraceProfiler::endZone(const char *name) {
+	add(name, 'E', _debugExtension ? (double) (_debugExtension->getAllocations() + _debugExtension->getReallocations()) : 0);
+}
+
+void ChromeTraceProfiler::counter(const char *name, double value) {
+	add(name, 'C', value);
+}
+
+void ChromeTraceProfiler::write(String &json) {
+	std::lock_guard<std::mutex> lock(_mutex);
+	// Matches zone ends with their begins on the same thread to compute the allocations made in each zone.
+	std::vector<const Event *> open;
+	char buffer[512];
+	json.append("{\"traceEvents\":[\n");
+	for (size_t i = 0, n = _events.size(); i < n; i++) {
+		const Event &event = _events[i];
+		const char *separator = i < n - 1 ? ",\n" : "\n";
+		if (event.phase == 'C') {
+			snprintf(buffer, sizeof(buffer),
+					 "{\"name\":\"%s\",\"ph\":\"C\",\"ts\":%.3f,\"pid\":0,\"tid\":%zu,\"args\":{\"value\":%g}}%s",
+					 event.name, event.time, event.thread, event.value, separator);
+		} else if (event.phase == 'B') {
+			open.push_back(&event);
+			snprintf(buffer, sizeof(buffer), "{\"name\":\"%s\",\"ph\":\"B\",\"ts\":%.3f,\"pid\":0,\"tid\":%zu}%s",
+					 event.name, event.time, event.thread, separator);
+		} else {
+			double allocations = 0;
+			for (size_t ii = open.size(); ii > 0; ii--) {
+				if (open[ii - 1]->thread != event.thread) continue;
+				allocations = event.value - open[ii - 1]->value;
+				open.erase(open.begin() + (ii - 1));
+				break;
+			}
+			if (_debugExtension)
+				snprintf(buffer, sizeof(buffer),
+						 "{\"name\":\"%s\",\"ph\":\"E\",\"ts\":%.3f,\"pid\":0,\"tid\":%zu,\"args\":{\"allocations\":%g}}%s",
+						 event.name, event.time, event.thread, allocations, separator);
+			else
+				snprintf(buffer, sizeof(buffer), "{\"name\":\"%s\",\"ph\":\"E\",\"ts\":%.3f,\"pid\":0,\"tid\":%zu}%s",
+						 event.name, event.time, event.thread, separator);
+		}
+		json.append(buffer);
+	}
+	json.append("]}\n");
+}
+
+size_t ChromeTraceProfiler::getEventCount() {
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _events.size();
+}
+
+void ChromeTraceProfiler::clear() {
+	std::lock_guard<std::mutex> lock(_mutex);
+	_events.clear();
+}
@@ -0,0 +1,89 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated September 24, 2021. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2021, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <spine/CompactVertices.h>
+
+#include <spine/MathUtil.h>
+
+using namespace spine;
+
+CompactVertices::CompactVertices(Vector<int> &bones, Vector<float> &vertices) : _scale(1) {
+	int maxIndex = 0;
+	for (size_t i = 0; i < bones.size(); i++)
+		maxIndex = MathUtil::max(maxIndex, bones[i]);
+	if (maxIndex < 256) {
+		_bones8.ensureCapacity(bones.size());
+		for (size_t i = 0; i < bones.size(); i++)
+			_bones8.add((unsigned char) bones[i]);
+	} else {
+		_bones16.ensureCapacity(bones.size());
+		for (size_t i = 0; i < bones.size(); i++)
+			_bones16.add((unsigned short) bones[i]);
+	}
+
+	float maxCoordinate = 0;
+	for (size_t i = 0; i < vertices.size(); i += 3) {
+		maxCoordinate = MathUtil::max(maxCoordinate, MathUtil::abs(vertices[i]));
+		maxCoordinate = MathUtil::max(maxCoordinate, MathUtil::abs(vertices[i + 1]));
+	}
+	if (maxCoordinate > 0) _scale = maxCoordinate / 32767;
+	size_t influences = vertices.size() / 3;
+	_positions.ensureCapacity(influences << 1);
+	_weights.ensureCapacity(influences);
+	for (size_t i = 0; i < vertices.size(); i += 3) {
+		float x = vertices[i] / _scale, y = vertices[i + 1] / _scale;
+		_positions.add((short) (x < 0 ? x - 0.5f : x + 0.5f));
+		_positions.add((short) (y < 0 ? y - 0.5f : y + 0.5f));
+		_weights.add((unsigned short) (MathUtil::clamp(vertices[i + 2], 0, 1) * 65535 + 0.5f));
+	}
+}
+
+void CompactVertices::decode(Vector<int> &bones, Vector<float> &vertices) {
+	bones.clear();
+	for (size_t i = 0; i < _bones8.size(); i++)
+		bones.add(_bones8[i]);
+	for (size_t i = 0; i < _bones16.size(); i++)
+		bones.add(_bones16[i]);
+	vertices.clear();
+	vertices.ensureCapacity(_weights.size() * 3);
+	for (size_t i = 0; i < _weights.size(); i++) {
+		vertices.add(_positions[i << 1] * _scale);
+		vertices.add(_positions[(i << 1) + 1] * _scale);
+		vertices.add(_weights[i] / 65535.0f);
+	}
+}
+
+size_t CompactVertices::getInfluenceCount() {
+	return _weights.size();
+}
+
+size_t CompactVertices::getMemoryUsage() {
+	return _bones8.size() + _bones16.size() * sizeof(unsigned short) + _positions.size() * sizeof(short) +
+		   _weights.size() * sizeof(unsigned short);
+}
@@ -31,12 +31,15 @@
 
 #include <spine/MathUtil.h>
 
+#include <float.h>
+
 using namespace spine;
 
 RTTI_IMPL(CurveTimeline, Timeline)
 
 CurveTimeline::CurveTimeline(size_t frameCount, size_t frameEntries, size_t bezierCount) : Timeline(frameCount,
-																									frameEntries) {
+																									frameEntries),
+																						   _quantized(false), _timeOffset(0), _timeScale(0) {
 	_curves.setSize(frameCount + bezierCount * BEZIER_SIZE, 0);
 	_curves[frameCount - 1] = STEPPED;
 }
@@ -54,6 +57,7 @@ void CurveTimeline::setStepped(size_t frame) {
 
 void CurveTimeline::setBezier(size_t bezier, size_t frame, float value, float time1, float value1, float cx1, float cy1,
 							  float cx2, float cy2, float time2, float value2) {
+	assert(!_quantized);
 	size_t i = getFrameCount() + bezier * BEZIER_SIZE;
 	if (value == 0) _curves[frame] = BEZIER + i;
 	float tmpx = (time1 - cx1 * 2 + cx2) * 0.03, tmpy = (value1 - cy1 * 2 + cy2) * 0.03;
@@ -74,26 +78,199 @@ void CurveTimeline::setBezier(size_t bezier, size_t frame, float value, float ti
 }
 
 float CurveTimeline::getBezierValue(float time, size_t frameIndex, size_t valueOffset, size_t i) {
-	if (_curves[i] > time) {
-		float x = _frames[frameIndex], y = _frames[frameIndex + valueOffset];
-		return y + (time - x) / (_curves[i] - x) * (_curves[i + 1] - y);
+	float time1 = _frames[frameIndex], time2 = _frames[frameIndex + getFrameEntries()];
+	float x = getBezierTime(i, time1, time2);
+	if (x > time) {
+		float y = _frames[frameIndex + valueOffset];
+		return y + (time - time1) / (x - time1) * (getBezierSample(i + 1, valueOffset - 1) - y);
 	}
 	size_t n = i + BEZIER_SIZE;
 	for (i += 2; i < n; i += 2) {
-		if (_curves[i] >= time) {
-			float x = _curves[i - 2], y = _curves[i - 1];
-			return y + (time - x) / (_curves[i] - x) * (_curves[i + 1] - y);
+		float nextX = getBezierTime(i, time1, time2);
+		if (nextX >= time) {
+			float y = getBezierSample(i - 1, valueOffset - 1);
+			return y + (time - x) / (nextX - x) * (getBezierSample(i + 1, valueOffset - 1) - y);
 		}
+		x = nextX;
 	}
-	frameIndex += getFrameEntries();
-	float x = _curves[n - 2], y = _curves[n - 1];
-	return y + (time - x) / (_frames[frameIndex] - x) * (_frames[frameIndex + valueOffset] - y);
+	float y = getBezierSample(n - 1, valueOffset - 1);
+	return y + (time - x) / (time2 - x) * (_frames[frameIndex + getFrameEntries() + valueOffset] - y);
 }
 
 Vector<float> &CurveTimeline::getCurves() {
 	return _curves;
 }
 
+size_t CurveTimeline::reduce(float tolerance) {
+	assert(!_quantized);
+	size_t frameCount = getFrameCount();
+	if (frameCount < 3) return 0;
+
+	Vector<size_t> kept;
+	kept.add(0);
+	size_t start = 0;
+	for (size_t frame = 1; frame < frameCount - 1; frame++) {
+		// The frame can be removed if the curve from start to frame + 1 is within the tolerance of a straight line.
+		bool removable = true;
+		for (size_t i = start; removable && i <= frame; i++) {
+			if (getCurveError(start, i, frame + 1) > tolerance) removable = false;
+			else if (i > start && getInterpolationError(start, i, frame + 1) > tolerance) removable = false;
+		}
+		if (!removable) {
+			kept.add(frame);
+			start = frame;
+		}
+	}
+	kept.add(frameCount - 1);
+
+	size_t removed = frameCount - kept.size();
+	if (removed > 0) keepFrames(kept);
+	return removed;
+}
+
+float CurveTimeline::getInterpolationError(size_t start, size_t frame, size_t end) {
+	size_t entries = getFrameEntries();
+	float *before = _frames.buffer() + start * entries, *after = _frames.buffer() + end * entries;
+	float *current = _frames.buffer() + frame * entries;
+	float percent = (current[0] - before[0]) / (after[0] - before[0]);
+	float error = 0;
+	for (size_t i = 1; i < entries; i++)
+		error = MathUtil::max(error, MathUtil::abs(before[i] + (after[i] - before[i]) * percent - current[i]));
+	return error;
+}
+
+float CurveTimeline::getCurveError(size_t start, size_t segment, size_t end) {
+	int type = (int) _curves[segment];
+	if (type == LINEAR) return 0;
+
+	size_t entries = getFrameEntries();
+	float *before = _frames.buffer() + start * entries, *after = _frames.buffer() + end * entries;
+	float duration = after[0] - before[0];
+	float error = 0;
+	if (type == STEPPED) {
+		// The segment's values are held until the next frame.
+		float *current = _frames.buffer() + segment * entries;
+		float percent = (current[entries] - before[0]) / duration;
+		for (size_t i = 1; i < entries; i++)
+			error = MathUtil::max(error, MathUtil::abs(before[i] + (after[i] - before[i]) * percent - current[i]));
+		return error;
+	}
+	for (size_t i = 1; i < entries; i++) {
+		for (size_t ii = type - BEZIER + (i - 1) * BEZIER_SIZE, n = ii + BEZIER_SIZE; ii < n; ii += 2) {
+			float percent = (_curves[ii] - before[0]) / duration;
+			error = MathUtil::max(error, MathUtil::abs(before[i] + (after[i] - before[i]) * percent - _curves[ii + 1]));
+		}
+	}
+	return error;
+}
+
+void CurveTimeline::keepFrames(Vector<size_t> &frames) {
+	size_t entries = getFrameEntries(), count = frames.size();
+	size_t bezierSize = (entries > 1 ? entries - 1 : 1) * BEZIER_SIZE;
+
+	// Segments between kept frames that had frames removed become linear, the others keep their curve.
+	Vector<float> curves;
+	curves.setSize(count, LINEAR);
+	for (size_t i = 0; i < count; i++) {
+		size_t frame = frames[i];
+		int type = (int) _curves[frame];
+		if (i < count - 1 && frames[i + 1] != frame + 1) continue;
+		if (type >= BEZIER) {
+			curves[i] = (float) (BEZIER + curves.size());
+			for (size_t ii = type - BEZIER, n = ii + bezierSize; ii < n; ii++)
+				curves.add(_curves[ii]);
+		} else
+			curves[i] = (float) type;
+	}
+
+	for (size_t i = 0; i < count; i++) {
+		size_t from = frames[i] * entries, to = i * entries;
+		for (size_t ii = 0; ii < entries; ii++)
+			_frames[to + ii] = _frames[from + ii];
+	}
+	_frames.setSize(count * entries, 0);
+	_frames.shrinkToFit();
+	_curves.clearAndAddAll(curves);
+	_curves.shrinkToFit();
+}
+
+void CurveTimeline::quantize() {
+	if (_quantized) return;
+	size_t frameCount = getFrameCount(), entries = getFrameEntries();
+	if (_curves.size() == frameCount) {
+		_quantized = true;
+		return;
+	}
+
+	// Each curve value has its own range, so eg the x and y of a translation are quantized independently. A frame's beziers,
+	// one for each of its curve values, are stored after those of the previous frame.
+	size_t channels = entries > 1 ? entries - 1 : 1;
+	Vector<float> min, max;
+	min.setSize(channels, FLT_MAX);
+	max.setSize(channels, -FLT_MAX);
+	// Control points may be outside their segment, so the sample times are too.
+	float minTime = 0, maxTime = 1;
+	Vector<size_t> bezierEnds;
+	bezierEnds.setSize(frameCount, 0);
+	for (size_t frame = 0, next = 0; frame < frameCount - 1; frame = next) {
+		size_t end = _curves.size();
+		for (next = frame + 1; next < frameCount; next++) {
+			if ((int) _curves[next] >= BEZIER) {
+				end = (int) _curves[next] - BEZIER;
+				break;
+			}
+		}
+		bezierEnds[frame] = end;
+		int type = (int) _curves[frame];
+		if (type < BEZIER) continue;
+		float time1 = _frames[frame * entries], duration = _frames[(frame + 1) * entries] - time1;
+		for (size_t i = type - BEZIER; i < end; i += 2) {
+			minTime = MathUtil::min(minTime, (_curves[i] - time1) / duration);
+			maxTime = MathUtil::max(maxTime, (_curves[i] - time1) / duration);
+			size_t channel = (i - (type - BEZIER)) / BEZIER_SIZE;
+			min[channel] = MathUtil::min(min[channel], _curves[i + 1]);
+			max[channel] = MathUtil::max(max[channel], _curves[i + 1]);
+		}
+	}
+	_timeOffset = minTime;
+	_timeScale = (maxTime - minTime) / 65535;
+	_valueRanges.setSize(channels << 1, 0);
+	for (size_t channel = 0; channel < channels; channel++) {
+		if (min[channel] > max[channel]) continue;
+		_valueRanges[channel << 1] = min[channel];
+		_valueRanges[(channel << 1) + 1] = (max[channel] - min[channel]) / 65535;
+	}
+
+	// Times are stored as a fraction of the segment, so the frame of each bezier is needed.
+	_packedCurves.setSize(_curves.size() - frameCount, 0);
+	for (size_t frame = 0; frame < frameCount - 1; frame++) {
+		int type = (int) _curves[frame];
+		if (type < BEZIER) continue;
+		size_t end = bezierEnds[frame];
+		assert(end > (size_t) (type - BEZIER));
+		float time1 = _frames[frame * entries], duration = _frames[(frame + 1) * entries] - time1;
+		for (size_t i = type - BEZIER; i < end; i += 2) {
+			size_t channel = (i - (type - BEZIER)) / BEZIER_SIZE;
+			float offset = _valueRanges[channel << 1], scale = _valueRanges[(channel << 1) + 1];
+			float time = (_curves[i] - time1) / duration;
+			_packedCurves[i - frameCount] = (unsigned short) ((time - minTime) / _timeScale + 0.5f);
+			if (scale > 0) _packedCurves[i + 1 - frameCount] = (unsigned short) ((_curves[i + 1] - offset) / scale + 0.5f);
+		}
+	}
+	_curves.setSize(frameCount, 0);
+	_curves.shrinkToFit();
+	_quantized = true;
+}
+
+bool CurveTimeline::isQuantized() {
+	return _quantized;
+}
+
+size_t CurveTimeline::getMemoryUsage() {
+	return Timeline::getMemoryUsage() + _curves.getCapacity() * sizeof(float) +
+		   _packedCurves.getCapacity() * sizeof(unsigned short) + _valueRanges.getCapacity() * sizeof(float);
+}
+
 RTTI_IMPL(CurveTimeline1, CurveTimeline)
 
 CurveTimeline1::CurveTimeline1(size_t frameCount, size_t bezierCount) : CurveTimeline(frameCount,
@@ -132,6 +309,36 @@ float CurveTimeline1::getCurveValue(float time) {
 	return getBezierValue(time, i, CurveTimeline1::VALUE, curveType - CurveTimeline1::BEZIER);
 }
 
+void CurveTimeline1::getCurveValues(float *times, float *values, size_t count) {
+	float *frames = _frames.buffer(), *curves = _curves.buffer();
+	int last = (int) _frames.size() - 2;
+	for (size_t ii = 0; ii < count; ii++) {
+		float time = times[ii];
+		int i = last;
+		for (int f = 2; f <= last; f += 2) {
+			if (frames[f] > time) {
+				i = f - 2;
+				break;
+			}
+		}
+
+		int curveType = (int) curves[i >> 1];
+		switch (curveType) {
+			case CurveTimeline::LINEAR: {
+				float before = frames[i], value = frames[i + CurveTimeline1::VALUE];
+				values[ii] = value + (time - before) / (frames[i + CurveTimeline1::ENTRIES] - before) *
+											 (frames[i + CurveTimeline1::ENTRIES + CurveTimeline1::VALUE] - value);
+				break;
+			}
+			case CurveTimeline::STEPPED:
+				values[ii] = frames[i + CurveTimeline1::VALUE];
+				break;
+			default:
+				values[ii] = getBezierValue(time, i, CurveTimeline1::VALUE, curveType - CurveTimeline1::BEZIER);
+		}
+	}
+}
+
 RTTI_IMPL(CurveTimeline2, CurveTimeline)
 
 CurveTimeline2::CurveTimeline2(size_t frameCount, size_t bezierCount) : CurveTimeline(frameCount,
@@ -148,3 +355,41 @@ void CurveTimeline2::setFrame(size_t frame, float time, float value1, float valu
 	_frames[frame + CurveTimeline2::VALUE1] = value1;
 	_frames[frame + CurveTimeline2::VALUE2] = value2;
 }
+
+void CurveTimeline2::getCurveValues(float *times, float *values1, float *values2, size_t count) {
+	float *frames = _frames.buffer(), *curves = _curves.buffer();
+	size_t n = _frames.size();
+	for (size_t ii = 0; ii < count; ii++) {
+		float time = times[ii];
+		size_t i = n - CurveTimeline2::ENTRIES;
+		for (size_t f = CurveTimeline2::ENTRIES; f < n; f += CurveTimeline2::ENTRIES) {
+			if (frames[f] > time) {
+				i = f - CurveTimeline2::ENTRIES;
+				break;
+			}
+		}
+
+		int curveType = (int) curves[i / CurveTimeline2::ENTRIES];
+		switch (curveType) {
+			case CurveTimeline::LINEAR: {
+				float before = frames[i];
+				float x = frames[i + CurveTimeline2::VALUE1];
+				float y = frames[i + CurveTimeline2::VALUE2];
+				float t = (time - before) / (frames[i + CurveTimeline2::ENTRIES] - before);
+				values1[ii] = x + (frames[i + CurveTimeline2::ENTRIES + CurveTimeline2::VALUE1] - x) * t;
+				values2[ii] = y + (frames[i + CurveTimeline2::ENTRIES + CurveTimeline2::VALUE2] - y) * t;
+				break;
+			}
+			case CurveTimeline::STEPPED: {
+				values1[ii] = frames[i + CurveTimeline2::VALUE1];
+				values2[ii] = frames[i + CurveTimeline2::VALUE2];
+				break;
+			}
+			default: {
+				values1[ii] = getBezierValue(time, i, CurveTimeline2::VALUE1, curveType - CurveTimeline::BEZIER);
+				values2[ii] = getBezierValue(time, i, CurveTimeline2::VALUE2,
+											 curveType + CurveTimeline::BEZIER_SIZE - CurveTimeline::BEZIER);
+			}
+		}
+	}
+}
@@ -36,6 +36,7 @@
 
 #include <spine/Animation.h>
 #include <spine/Bone.h>
+#include <spine/MathUtil.h>
 #include <spine/Property.h>
 #include <spine/Slot.h>
 #include <spine/SlotData.h>
@@ -45,15 +46,12 @@ using namespace spine;
 RTTI_IMPL(DeformTimeline, CurveTimeline)
 
 DeformTimeline::DeformTimeline(size_t frameCount, size_t bezierCount, int slotIndex, VertexAttachment *attachment)
-	: CurveTimeline(frameCount, 1, bezierCount), _slotIndex(slotIndex), _attachment(attachment) {
+	: CurveTimeline(frameCount, 1, bezierCount), _slotIndex(slotIndex), _attachment(attachment), _vertexCount(0),
+	  _packedScale(0), _compressed(false) {
 	PropertyId ids[] = {((PropertyId) Property_Deform << 32) | ((slotIndex << 16 | attachment->_id) & 0xffffffff)};
 	setPropertyIds(ids, 1);
 
-	_vertices.ensureCapacity(frameCount);
-	for (size_t i = 0; i < frameCount; ++i) {
-		Vector<float> vec;
-		_vertices.add(vec);
-	}
+	_ranges.setSize(frameCount * RANGE_ENTRIES, 0);
 }
 
 void DeformTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vector<Event *> *pEvents, float alpha,
@@ -76,189 +74,104 @@ void DeformTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vecto
 		return;
 	}
 
-	Vector<float> &deformArray = slot._deform;
-	if (deformArray.size() == 0) {
+	Vector<float> &deform = slot._deform;
+	if (deform.size() == 0) {
 		blend = MixBlend_Setup;
 	}
 
-	Vector<Vector<float>> &vertices = _vertices;
-	size_t vertexCount = vertices[0].size();
+	size_t vertexCount = _vertexCount;
+	Vector<float> &setupVertices = attachment->getVertices();
+	bool weighted = attachment->isWeighted();
 
 	Vector<float> &frames = _frames;
-	if (time < _frames[0]) {
+	if (time < frames[0]) {
 		switch (blend) {
 			case MixBlend_Setup:
-				deformArray.clear();
+				deform.clear();
 				return;
-			case MixBlend_First: {
+			case MixBlend_First:
 				if (alpha == 1) {
-					deformArray.clear();
+					deform.clear();
 					return;
 				}
-				deformArray.setSize(vertexCount, 0);
-				Vector<float> &deform = deformArray;
-				if (attachment->getBones().size() == 0) {
-					// Unweighted vertex positions.
-					Vector<float> &setupVertices = attachment->getVertices();
-					for (size_t i = 0; i < vertexCount; i++)
-						deform[i] += (setupVertices[i] - deform[i]) * alpha;
-				} else {
-					// Weighted deform offsets.
-					alpha = 1 - alpha;
-					for (size_t i = 0; i < vertexCount; i++)
-						deform[i] *= alpha;
-				}
-			}
+				break;
 			case MixBlend_Replace:
-			case MixBlend_Add: {
-			}
+			case MixBlend_Add:
+				return;
 		}
-		return;
+	} else if (deform.size() != vertexCount) {
+		deform.setSize(vertexCount, 0);
+		if (!weighted) memcpy(deform.buffer(), setupVertices.buffer(), vertexCount * sizeof(float));
+		slot._deformStart = 0;
+		slot._deformEnd = 0;
 	}
 
-	deformArray.setSize(vertexCount, 0);
-	Vector<float> &deform = deformArray;
-
-	if (time >= frames[frames.size() - 1]) {// Time is after last frame.
-		Vector<float> &lastVertices = vertices[frames.size() - 1];
-		if (alpha == 1) {
-			if (blend == MixBlend_Add) {
-				VertexAttachment *vertexAttachment = static_cast<VertexAttachment *>(slotAttachment);
-				if (vertexAttachment->getBones().size() == 0) {
-					// Unweighted vertex positions, no alpha.
-					Vector<float> &setupVertices = vertexAttachment->getVertices();
-					for (size_t i = 0; i < vertexCount; i++)
-						deform[i] += lastVertices[i] - setupVertices[i];
-				} else {
-					// Weighted deform offsets, no alpha.
-					for (size_t i = 0; i < vertexCount; i++)
-						deform[i] += lastVertices[i];
-				}
-			} else {
-				// Vertex positions or deform offsets, no alpha.
-				memcpy(deform.buffer(), lastVertices.buffer(), vertexCount * sizeof(float));
-			}
+	// Values outside the slot's deform range match the setup pose, so only that range is mixed toward the setup pose. The
+	// keyframe offsets from the setup pose are then added for the ranges stored for the keyframes.
+	int start = slot._deformStart, end = MathUtil::min(slot._deformEnd, (int) deform.size());
+	if (blend == MixBlend_Setup || (alpha == 1 && blend != MixBlend_Add)) {
+		if (weighted) {
+			for (int i = start; i < end; i++)
+				deform[i] = 0;
 		} else {
-			switch (blend) {
-				case MixBlend_Setup: {
-					VertexAttachment *vertexAttachment = static_cast<VertexAttachment *>(slotAttachment);
-					if (vertexAttachment->getBones().size() == 0) {
-						// Unweighted vertex positions, with alpha.
-						Vector<float> &setupVertices = vertexAttachment->getVertices();
-						for (size_t i = 0; i < vertexCount; i++) {
-							float setup = setupVertices[i];
-							deform[i] = setup + (lastVertices[i] - setup) * alpha;
-						}
-					} else {
-						// Weighted deform offsets, with alpha.
-						for (size_t i = 0; i < vertexCount; i++)
-							deform[i] = lastVertices[i] * alpha;
-					}
-					break;
-				}
-				case MixBlend_First:
-				case MixBlend_Replace:
-					// Vertex positions or deform offsets, with alpha.
-					for (size_t i = 0; i < vertexCount; i++)
-						deform[i] += (lastVertices[i] - deform[i]) * alpha;
-					break;
-				case MixBlend_Add:
-					VertexAttachment *vertexAttachment = static_cast<VertexAttachment *>(slotAttachment);
-					if (vertexAttachment->getBones().size() == 0) {
-						// Unweighted vertex positions, no alpha.
-						Vector<float> &setupVertices = vertexAttachment->getVertices();
-						for (size_t i = 0; i < vertexCount; i++)
-							deform[i] += (lastVertices[i] - setupVertices[i]) * alpha;
-					} else {
-						// Weighted deform offsets, alpha.
-						for (size_t i = 0; i < vertexCount; i++)
-							deform[i] += lastVertices[i] * alpha;
-					}
-			}
+			for (int i = start; i < end; i++)
+				deform[i] = setupVertices[i];
+		}
+		slot._deformStart = 0;
+		slot._deformEnd = 0;
+	} else if (blend != MixBlend_Add) {
+		if (weighted) {
+			for (int i = start; i < end; i++)
+				deform[i] -= deform[i] * alpha;
+		} else {
+			for (int i = start; i < end; i++)
+				deform[i] += (setupVertices[i] - deform[i]) * alpha;
 		}
+	}
+	if (time < frames[0]) return;
+
+	if (time >= frames[frames.size() - 1]) {// Time is after last frame.
+		addOffsets(slot, frames.size() - 1, alpha);
 		return;
 	}
 
 	// Interpolate between the previous frame and the current frame.
 	int frame = Animation::search(frames, time);
 	float percent = getCurvePercent(time, frame);
-	Vector<float> &prevVertices = vertices[frame];
-	Vector<float> &nextVertices = vertices[frame + 1];
-
-	if (alpha == 1) {
-		if (blend == MixBlend_Add) {
-			VertexAttachment *vertexAttachment = static_cast<VertexAttachment *>(slotAttachment);
-			if (vertexAttachment->getBones().size() == 0) {
-				// Unweighted vertex positions, no alpha.
-				Vector<float> &setupVertices = vertexAttachment->getVertices();
-				for (size_t i = 0; i < vertexCount; i++) {
-					float prev = prevVertices[i];
-					deform[i] += prev + (nextVertices[i] - prev) * percent - setupVertices[i];
-				}
-			} else {
-				// Weighted deform offsets, no alpha.
-				for (size_t i = 0; i < vertexCount; i++) {
-					float prev = prevVertices[i];
-					deform[i] += prev + (nextVertices[i] - prev) * percent;
-				}
-			}
-		} else {
-			// Vertex positions or deform offsets, no alpha.
-			for (size_t i = 0; i < vertexCount; i++) {
-				float prev = prevVertices[i];
-				deform[i] = prev + (nextVertices[i] - prev) * percent;
-			}
-		}
+	addOffsets(slot, frame, (1 - percent) * alpha);
+	addOffsets(slot, frame + 1, percent * alpha);
+}
+
+void DeformTimeline::addOffsets(Slot &slot, size_t frame, float alpha) {
+	int *range = _ranges.buffer() + frame * RANGE_ENTRIES;
+	int start = range[RANGE_START], end = range[RANGE_END];
+	if (alpha == 0 || start == end) return;
+
+	if (slot._deformStart >= slot._deformEnd) {
+		slot._deformStart = start;
+		slot._deformEnd = end;
 	} else {
-		switch (blend) {
-			case MixBlend_Setup: {
-				VertexAttachment *vertexAttachment = static_cast<VertexAttachment *>(slotAttachment);
-				if (vertexAttachment->getBones().size() == 0) {
-					// Unweighted vertex positions, with alpha.
-					Vector<float> &setupVertices = vertexAttachment->getVertices();
-					for (size_t i = 0; i < vertexCount; i++) {
-						float prev = prevVertices[i], setup = setupVertices[i];
-						deform[i] = setup + (prev + (nextVertices[i] - prev) * percent - setup) * alpha;
-					}
-				} else {
-					// Weighted deform offsets, with alpha.
-					for (size_t i = 0; i < vertexCount; i++) {
-						float prev = prevVertices[i];
-						deform[i] = (prev + (nextVertices[i] - prev) * percent) * alpha;
-					}
-				}
-				break;
-			}
-			case MixBlend_First:
-			case MixBlend_Replace:
-				// Vertex positions or deform offsets, with alpha.
-				for (size_t i = 0; i < vertexCount; i++) {
-					float prev = prevVertices[i];
-					deform[i] += (prev + (nextVertices[i] - prev) * percent - deform[i]) * alpha;
-				}
-				break;
-			case MixBlend_Add:
-				VertexAttachment *vertexAttachment = static_cast<VertexAttachment *>(slotAttachment);
-				if (vertexAttachment->getBones().size() == 0) {
-					// Unweighted vertex positions, with alpha.
-					Vector<float> &setupVertices = vertexAttachment->getVertices();
-					for (size_t i = 0; i < vertexCount; i++) {
-						float prev = prevVertices[i];
-						deform[i] += (prev + (nextVertices[i] - prev) * percent - setupVertices[i]) * alpha;
-					}
-				} else {
-					// Weighted deform offsets, with alpha.
-					for (size_t i = 0; i < vertexCount; i++) {
-						float prev = prevVertices[i];
-						deform[i] += (prev + (nextVertices[i] - prev) * percent) * alpha;
-					}
-				}
-		}
+		slot._deformStart = MathUtil::min(slot._deformStart, start);
+		slot._deformEnd = MathUtil::max(slot._deformEnd, end);
+	}
+
+	float *deform = slot._deform.buffer() + start;
+	int count = end - start;
+	if (_compressed) {
+		short *offsets = _packedOffsets.buffer() + range[RANGE_OFFSET];
+		float scale = _packedScale * alpha;
+		for (int i = 0; i < count; i++)
+			deform[i] += offsets[i] * scale;
+	} else {
+		float *offsets = _offsets.buffer() + range[RANGE_OFFSET];
+		for (int i = 0; i < count; i++)
+			deform[i] += offsets[i] * alpha;
 	}
 }
 
 void DeformTimeline::setBezier(size_t bezier, size_t frame, float value, float time1, float value1, float cx1, float cy1,
 							   float cx2, float cy2, float time2, float value2) {
+	assert(!_quantized);
 	SP_UNUSED(value1);
 	SP_UNUSED(value2);
 	size_t i = getFrameCount() + bezier * DeformTimeline::BEZIER_SIZE;
@@ -294,31 +207,81 @@ float DeformTimeline::getCurvePercent(float time, int frame) {
 		}
 	}
 	i -= DeformTimeline::BEZIER;
-	if (_curves[i] > time) {
-		float x = _frames[frame];
-		return _curves[i + 1] * (time - x) / (_curves[i] - x);
-	}
+	float time1 = _frames[frame], time2 = _frames[frame + getFrameEntries()];
+	float x = getBezierTime(i, time1, time2);
+	if (x > time) return getBezierSample(i + 1, 0) * (time - time1) / (x - time1);
 	int n = i + DeformTimeline::BEZIER_SIZE;
 	for (i += 2; i < n; i += 2) {
-		if (_curves[i] >= time) {
-			float x = _curves[i - 2], y = _curves[i - 1];
-			return y + (time - x) / (_curves[i] - x) * (_curves[i + 1] - y);
+		float nextX = getBezierTime(i, time1, time2);
+		if (nextX >= time) {
+			float y = getBezierSample(i - 1, 0);
+			return y + (time - x) / (nextX - x) * (getBezierSample(i + 1, 0) - y);
 		}
+		x = nextX;
 	}
-	float x = _curves[n - 2], y = _curves[n - 1];
-	return y + (1 - y) * (time - x) / (_frames[frame + getFrameEntries()] - x);
+	float y = getBezierSample(n - 1, 0);
+	return y + (1 - y) * (time - x) / (time2 - x);
 }
 
 void DeformTimeline::setFrame(int frame, float time, Vector<float> &vertices) {
 	_frames[frame] = time;
-	_vertices[frame].clear();
-	_vertices[frame].addAll(vertices);
+	_vertexCount = vertices.size();
+
+	// Store only the range of offsets from the setup pose which are not zero.
+	bool weighted = _attachment->isWeighted();
+	Vector<float> &setupVertices = _attachment->getVertices();
+	int start = 0, end = (int) vertices.size();
+	if (weighted) {
+		while (start < end && vertices[start] == 0) start++;
+		while (end > start && vertices[end - 1] == 0) end--;
+	} else {
+		while (start < end && vertices[start] == setupVertices[start]) start++;
+		while (end > start && vertices[end - 1] == setupVertices[end - 1]) end--;
+	}
+
+	int *range = _ranges.buffer() + frame * RANGE_ENTRIES;
+	range[RANGE_START] = start;
+	range[RANGE_END] = end;
+	range[RANGE_OFFSET] = (int) _offsets.size();
+	_offsets.ensureCapacity(_offsets.size() + end - start);
+	for (int i = start; i < end; i++)
+		_offsets.add(weighted ? vertices[i] : vertices[i] - setupVertices[i]);
+}
+
+void DeformTimeline::getFrameVertices(size_t frame, Vector<float> &vertices) {
+	vertices.clear();
+	if (_attachment->isWeighted())
+		vertices.setSize(_vertexCount, 0);
+	else
+		vertices.addAll(_attachment->getVertices());
+	int *range = _ranges.buffer() + frame * RANGE_ENTRIES;
+	for (int i = range[RANGE_START], n = range[RANGE_END]; i < n; i++)
+		vertices[i] += getOffset(frame, i);
+}
+
+int DeformTimeline::getFrameStart(size_t frame) {
+	return _ranges[frame * RANGE_ENTRIES + RANGE_START];
+}
+
+int DeformTimeline::getFrameEnd(size_t frame) {
+	return _ranges[frame * RANGE_ENTRIES + RANGE_END];
 }
 
-Vector<Vector<float>> &DeformTimeline::getVertices() {
+Vector<Vector<float> > &DeformTimeline::getVertices() {
+	size_t frameCount = getFrameCount();
+	_vertices.setSize(frameCount, Vector<float>());
+	for (size_t i = 0; i < frameCount; i++)
+		getFrameVertices(i, _vertices[i]);
 	return _vertices;
 }
 
+float DeformTimeline::getOffset(size_t frame, size_t i) {
+	int *range = _ranges.buffer() + frame * RANGE_ENTRIES;
+	if ((int) i < range[RANGE_START] || (int) i >= range[RANGE_END]) return 0;
+	size_t index = range[RANGE_OFFSET] + i - range[RANGE_START];
+	return _compressed ? _packedOffsets[index] * _packedScale : _offsets[index];
+}
+
 VertexAttachment *DeformTimeline::getAttachment() {
 	return _attachment;
 }
@@ -326,3 +289,109 @@ VertexAttachment *DeformTimeline::getAttachment() {
 void DeformTimeline::setAttachment(VertexAttachment *inValue) {
 	_attachment = inValue;
 }
+
+void DeformTimeline::compress(float tolerance) {
+	if (_compressed) return;
+	tolerance *= 0.5f;
+	reduce(tolerance);
+
+	float maxOffset = 0;
+	for (size_t i = 0; i < _offsets.size(); i++)
+		maxOffset = MathUtil::max(maxOffset, MathUtil::abs(_offsets[i]));
+	_packedScale = maxOffset / 32767;
+
+	for (size_t frame = 0, frameCount = getFrameCount(); frame < frameCount; frame++) {
+		int *range = _ranges.buffer() + frame * RANGE_ENTRIES;
+		int first = range[RANGE_START], start = first, end = range[RANGE_END];
+		float *offsets = _offsets.buffer() + range[RANGE_OFFSET];
+		while (start < end && MathUtil::abs(offsets[start - first]) <= tolerance) start++;
+		while (end > start && MathUtil::abs(offsets[end - 1 - first]) <= tolerance) end--;
+		range[RANGE_START] = start;
+		range[RANGE_END] = end;
+		range[RANGE_OFFSET] = (int) _packedOffsets.size();
+		for (int i = start; i < end; i++) {
+			float offset = offsets[i - first] / _packedScale;
+			_packedOffsets.add((short) (offset < 0 ? offset - 0.5f : offset + 0.5f));
+		}
+	}
+	_packedOffsets.shrinkToFit();
+	_offsets.clear();
+	_offsets.shrinkToFit();
+	_compressed = true;
+	quantize();
+}
+
+bool DeformTimeline::isCompressed() {
+	return _compressed;
+}
+
+size_t DeformTimeline::getMemoryUsage() {
+	return CurveTimeline::getMemoryUsage() + _ranges.getCapacity() * sizeof(int) + _offsets.getCapacity() * sizeof(float) +
+		   _packedOffsets.getCapacity() * sizeof(short);
+}
+
+float DeformTimeline::getInterpolationError(size_t start, size_t frame, size_t end) {
+	float before = _frames[start];
+	float percent = (_frames[frame] - before) / (_frames[end] - before);
+	float error = 0;
+	for (size_t i = 0; i < _vertexCount; i++) {
+		float value = getOffset(start, i);
+		error = MathUtil::max(error, MathUtil::abs(value + (getOffset(end, i) - value) * percent - getOffset(frame, i)));
+	}
+	return error;
+}
+
+float DeformTimeline::getCurveError(size_t start, size_t segment, size_t end) {
+	int type = (int) _curves[segment];
+	if (type == LINEAR) return 0;
+
+	// The curve is sampled as times and percentages between the segment's frames.
+	float samples[BEZIER_SIZE];
+	size_t sampleCount = BEZIER_SIZE;
+	if (type == STEPPED) {
+		samples[0] = _frames[segment + 1];
+		samples[1] = 0;
+		sampleCount = 2;
+	} else {
+		for (size_t i = 0; i < BEZIER_SIZE; i++)
+			samples[i] = _curves[type - BEZIER + i];
+	}
+
+	float before = _frames[start], duration = _frames[end] - before;
+	float error = 0;
+	for (size_t i = 0; i < _vertexCount; i++) {
+		float value = getOffset(start, i), endValue = getOffset(end, i);
+		float from = getOffset(segment, i), to = getOffset(segment + 1, i);
+		for (size_t ii = 0; ii < sampleCount; ii += 2) {
+			float line = value + (endValue - value) * (samples[ii] - before) / duration;
+			error = MathUtil::max(error, MathUtil::abs(from + (to - from) * samples[ii + 1] - line));
+		}
+	}
+	return error;
+}
+
+void DeformTimeline::keepFrames(Vector<size_t> &frames) {
+	Vector<int> ranges;
+	ranges.setSize(frames.size() * RANGE_ENTRIES, 0);
+	Vector<float> offsets;
+	Vector<short> packedOffsets;
+	for (size_t i = 0; i < frames.size(); i++) {
+		int *from = _ranges.buffer() + frames[i] * RANGE_ENTRIES, *to = ranges.buffer() + i * RANGE_ENTRIES;
+		to[RANGE_START] = from[RANGE_START];
+		to[RANGE_END] = from[RANGE_END];
+		to[RANGE_OFFSET] = (int) (_compressed ? packedOffsets.size() : offsets.size());
+		for (int ii = from[RANGE_OFFSET], n = ii + from[RANGE_END] - from[RANGE_START]; ii < n; ii++) {
+			if (_compressed)
+				packedOffsets.add(_packedOffsets[ii]);
+			else
+				offsets.add(_offsets[ii]);
+		}
+	}
+	_ranges.clearAndAddAll(ranges);
+	_ranges.shrinkToFit();
+	_offsets.clearAndAddAll(offsets);
+	_offsets.shrinkToFit();
+	_packedOffsets.clearAndAddAll(packedOffsets);
+	_packedOffsets.shrinkToFit();
+	CurveTimeline::keepFrames(frames);
+}
@@ -100,3 +100,10 @@ void DrawOrderTimeline::setFrame(size_t frame, float time, Vector<int> &drawOrde
 Vector<Vector<int>> &DrawOrderTimeline::getDrawOrders() {
 	return _drawOrders;
 }
+
+size_t DrawOrderTimeline::getMemoryUsage() {
+	size_t usage = Timeline::getMemoryUsage() + _drawOrders.getCapacity() * sizeof(Vector<int>);
+	for (size_t i = 0; i < _drawOrders.size(); i++)
+		usage += _drawOrders[i].getCapacity() * sizeof(int);
+	return usage;
+}
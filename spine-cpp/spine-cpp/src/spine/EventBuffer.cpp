@@ -0,0 +1,98 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated September 24, 2021. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2021, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <spine/EventBuffer.h>
+
+#include <spine/Event.h>
+#include <spine/EventData.h>
+
+using namespace spine;
+
+EventRecord::EventRecord() : state(NULL), type(EventType_Start), trackIndex(0), entryId(0), event(NULL), time(0), data(NULL),
+							 intValue(0), floatValue(0), volume(0), balance(0) {
+}
+
+EventRecord::EventRecord(AnimationState *animationState, EventType eventType, TrackEntry *entry, Event *trackEvent)
+	: state(animationState), type(eventType), trackIndex(entry->getTrackIndex()), entryId(entry->getId()),
+	  event(trackEvent), time(trackEvent ? trackEvent->getTime() : entry->getTrackTime()),
+	  data(trackEvent ? &trackEvent->getData() : NULL), intValue(trackEvent ? trackEvent->getIntValue() : 0),
+	  floatValue(trackEvent ? trackEvent->getFloatValue() : 0), volume(trackEvent ? trackEvent->getVolume() : 0),
+	  balance(trackEvent ? trackEvent->getBalance() : 0) {
+}
+
+EventBuffer::EventBuffer(size_t capacity) : _records(NULL), _capacity(capacity), _head(0), _tail(0), _dropped(0) {
+	assert(capacity > 0);
+	_records = SpineExtension::calloc<EventRecord>(capacity, __FILE__, __LINE__);
+}
+
+EventBuffer::~EventBuffer() {
+	SpineExtension::free(_records, __FILE__, __LINE__);
+}
+
+bool EventBuffer::add(const EventRecord &record) {
+	// Only the producer writes the tail and only the consumer writes the head.
+	size_t tail = _tail.load(std::memory_order_relaxed);
+	if (tail - _head.load(std::memory_order_acquire) == _capacity) {
+		_dropped.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+	_records[tail % _capacity] = record;
+	_tail.store(tail + 1, std::memory_order_release);
+	return true;
+}
+
+bool EventBuffer::poll(EventRecord &record) {
+	size_t head = _head.load(std::memory_order_relaxed);
+	if (head == _tail.load(std::memory_order_acquire)) return false;
+	record = _records[head % _capacity];
+	_head.store(head + 1, std::memory_order_release);
+	return true;
+}
+
+size_t EventBuffer::size() {
+	// The head is loaded first so the tail loaded after it can't be behind it. The head may advance and the tail may be
+	// loaded after further records were added, so the difference is clamped to the capacity.
+	size_t head = _head.load(std::memory_order_acquire);
+	size_t size = _tail.load(std::memory_order_acquire) - head;
+	return size > _capacity ? _capacity : size;
+}
+
+size_t EventBuffer::getCapacity() {
+	return _capacity;
+}
+
+size_t EventBuffer::getDroppedCount() {
+	return _dropped.load(std::memory_order_relaxed);
+}
+
+void EventBuffer::clear() {
+	_head.store(0, std::memory_order_relaxed);
+	_tail.store(0, std::memory_order_relaxed);
+	_dropped.store(0, std::memory_order_relaxed);
+}
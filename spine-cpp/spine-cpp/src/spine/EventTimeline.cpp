@@ -97,3 +97,7 @@ void EventTimeline::setFrame(size_t frame, Event *event) {
 }
 
 Vector<Event *> &EventTimeline::getEvents() { return _events; }
+
+size_t EventTimeline::getMemoryUsage() {
+	return Timeline::getMemoryUsage() + _events.getCapacity() * sizeof(Event *) + _events.size() * sizeof(Event);
+}
@@ -32,6 +32,9 @@
 
 #include <assert.h>
 
+#include <mutex>
+#include <new>
+
 using namespace spine;
 
 SpineExtension *SpineExtension::_instance = NULL;
@@ -55,6 +58,24 @@ SpineExtension::~SpineExtension() {
 SpineExtension::SpineExtension() {
 }
 
+void *SpineExtension::_createMutex() {
+	std::mutex *mutex = SpineExtension::alloc<std::mutex>(1, __FILE__, __LINE__);
+	return new (mutex) std::mutex();
+}
+
+void SpineExtension::_lockMutex(void *mutex) {
+	((std::mutex *) mutex)->lock();
+}
+
+void SpineExtension::_unlockMutex(void *mutex) {
+	((std::mutex *) mutex)->unlock();
+}
+
+void SpineExtension::_disposeMutex(void *mutex) {
+	((std::mutex *) mutex)->~mutex();
+	SpineExtension::free(mutex, __FILE__, __LINE__);
+}
+
 DefaultSpineExtension::~DefaultSpineExtension() {
 }
 
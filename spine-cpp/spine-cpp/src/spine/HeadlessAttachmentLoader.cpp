@@ -0,0 +1,90 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated September 24, 2021. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2021, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <spine/HeadlessAttachmentLoader.h>
+#include <spine/BoundingBoxAttachment.h>
+#include <spine/ClippingAttachment.h>
+#include <spine/MeshAttachment.h>
+#include <spine/PathAttachment.h>
+#include <spine/PointAttachment.h>
+#include <spine/RegionAttachment.h>
+#include <spine/Skin.h>
+
+namespace spine {
+	RTTI_IMPL(HeadlessAttachmentLoader, AttachmentLoader)
+
+	HeadlessAttachmentLoader::HeadlessAttachmentLoader() : AttachmentLoader() {
+	}
+
+	RegionAttachment *HeadlessAttachmentLoader::newRegionAttachment(Skin &skin, const String &name, const String &path, Sequence *sequence) {
+		SP_UNUSED(skin);
+		SP_UNUSED(path);
+		SP_UNUSED(sequence);
+		return new (__FILE__, __LINE__) RegionAttachment(name);
+	}
+
+	MeshAttachment *HeadlessAttachmentLoader::newMeshAttachment(Skin &skin, const String &name, const String &path, Sequence *sequence) {
+		SP_UNUSED(skin);
+		SP_UNUSED(path);
+		SP_UNUSED(sequence);
+		return new (__FILE__, __LINE__) MeshAttachment(name);
+	}
+
+	BoundingBoxAttachment *HeadlessAttachmentLoader::newBoundingBoxAttachment(Skin &skin, const String &name) {
+		SP_UNUSED(skin);
+		return new (__FILE__, __LINE__) BoundingBoxAttachment(name);
+	}
+
+	PathAttachment *HeadlessAttachmentLoader::newPathAttachment(Skin &skin, const String &name) {
+		SP_UNUSED(skin);
+		return new (__FILE__, __LINE__) PathAttachment(name);
+	}
+
+	PointAttachment *HeadlessAttachmentLoader::newPointAttachment(Skin &skin, const String &name) {
+		SP_UNUSED(skin);
+		return new (__FILE__, __LINE__) PointAttachment(name);
+	}
+
+	ClippingAttachment *HeadlessAttachmentLoader::newClippingAttachment(Skin &skin, const String &name) {
+		SP_UNUSED(skin);
+		return new (__FILE__, __LINE__) ClippingAttachment(name);
+	}
+
+	void HeadlessAttachmentLoader::configureAttachment(Attachment *attachment) {
+		if (!attachment->getRTTI().isExactly(RegionAttachment::rtti)) return;
+		// Computes the vertex offsets as if the attachment's image was not whitespace stripped.
+		RegionAttachment *regionAttachment = static_cast<RegionAttachment *>(attachment);
+		TextureRegion region;
+		region.u2 = region.v2 = 1;
+		region.width = region.height = region.originalWidth = region.originalHeight = 1;
+		regionAttachment->setRegion(&region);
+		regionAttachment->updateRegion();
+		regionAttachment->setRegion(NULL);
+	}
+}// namespace spine
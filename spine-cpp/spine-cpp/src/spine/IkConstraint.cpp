@@ -34,6 +34,7 @@
 #include <spine/Skeleton.h>
 
 #include <spine/BoneData.h>
+#include <spine/SpineProfiler.h>
 
 using namespace spine;
 
@@ -280,6 +281,7 @@ IkConstraint::IkConstraint(IkConstraintData &data, Skeleton &skeleton) : Updatab
 }
 
 void IkConstraint::update() {
+	SP_PROFILE_ZONE("IkConstraint::update");
 	if (_mix == 0) return;
 	switch (_bones.size()) {
 		case 1: {
@@ -51,7 +51,8 @@ const int Json::JSON_STRING = 4;
 const int Json::JSON_ARRAY = 5;
 const int Json::JSON_OBJECT = 6;
 
-const char *Json::_error = NULL;
+/* Per thread, so skeletons can be parsed concurrently. */
+static thread_local const char *_error = NULL;
 
 Json *Json::getItem(Json *object, const char *string) {
 	Json *c = object->_child;
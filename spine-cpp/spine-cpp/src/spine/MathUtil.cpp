@@ -43,6 +43,46 @@ const float MathUtil::Pi_2 = 3.1415926535897932385f * 2;
 const float MathUtil::Deg_Rad = (3.1415926535897932385f / 180.0f);
 const float MathUtil::Rad_Deg = (180.0f / 3.1415926535897932385f);
 
+static const int SIN_BITS = 14;
+static const int SIN_COUNT = 1 << SIN_BITS;
+static const int SIN_MASK = SIN_COUNT - 1;
+static const float RAD_TO_INDEX = SIN_COUNT / (3.1415926535897932385f * 2);
+static const float DEG_TO_INDEX = SIN_COUNT / 360.0f;
+
+// Only filled when fast trig is first enabled, so applications that don't use it don't pay for it at startup.
+static float _sinTable[SIN_COUNT];
+static bool _sinTableBuilt = false;
+
+static void buildSinTable() {
+	if (_sinTableBuilt) return;
+	for (int i = 0; i < SIN_COUNT; i++)
+		_sinTable[i] = (float) ::sin(i * 3.14159265358979323846 * 2 / SIN_COUNT);
+	_sinTableBuilt = true;
+}
+
+#ifdef SPINE_FAST_TRIG
+static bool _fastTrig = true;
+
+static struct SinTableInitializer {
+	SinTableInitializer() {
+		buildSinTable();
+	}
+} _sinTableInitializer;
+#else
+static bool _fastTrig = false;
+#endif
+
+// Rounds to the nearest table entry, so the largest error is half a step.
+static inline float tableSin(float index) {
+	return _sinTable[(int) (index + (index >= 0 ? 0.5f : -0.5f)) & SIN_MASK];
+}
+
+// Polynomial approximation of atan for -1 <= z <= 1, largest error of 0.00001 radians before rounding.
+static inline float fastAtan(float z) {
+	float z2 = z * z;
+	return z * (0.9998660f + z2 * (-0.3302995f + z2 * (0.1801410f + z2 * (-0.0851330f + z2 * 0.0208351f))));
+}
+
 float MathUtil::abs(float v) {
 	return ((v) < 0 ? -(v) : (v));
 }
@@ -60,20 +100,30 @@ float MathUtil::fmod(float a, float b) {
 	return (float) ::fmod(a, b);
 }
 
-/// Returns atan2 in radians, faster but less accurate than Math.Atan2. Average error of 0.00231 radians (0.1323
-/// degrees), largest error of 0.00488 radians (0.2796 degrees).
 float MathUtil::atan2(float y, float x) {
-	return (float) ::atan2(y, x);
+	if (!_fastTrig) return (float) ::atan2(y, x);
+	if (x == 0) {
+		if (y > 0) return Pi / 2;
+		if (y == 0) return 0;
+		return -Pi / 2;
+	}
+	if (abs(y) <= abs(x)) {
+		float atan = fastAtan(y / x);
+		if (x < 0) return atan + (y < 0 ? -Pi : Pi);
+		return atan;
+	}
+	float atan = Pi / 2 - fastAtan(x / y);
+	return y < 0 ? atan - Pi : atan;
 }
 
-/// Returns the cosine in radians from a lookup table.
 float MathUtil::cos(float radians) {
-	return (float) ::cos(radians);
+	if (!_fastTrig) return (float) ::cos(radians);
+	return tableSin(radians * RAD_TO_INDEX + SIN_COUNT / 4);
 }
 
-/// Returns the sine in radians from a lookup table.
 float MathUtil::sin(float radians) {
-	return (float) ::sin(radians);
+	if (!_fastTrig) return (float) ::sin(radians);
+	return tableSin(radians * RAD_TO_INDEX);
 }
 
 float MathUtil::sqrt(float v) {
@@ -84,14 +134,23 @@ float MathUtil::acos(float v) {
 	return (float) ::acos(v);
 }
 
-/// Returns the sine in radians from a lookup table.
 float MathUtil::sinDeg(float degrees) {
-	return (float) ::sin(degrees * MathUtil::Deg_Rad);
+	if (!_fastTrig) return (float) ::sin(degrees * MathUtil::Deg_Rad);
+	return tableSin(degrees * DEG_TO_INDEX);
 }
 
-/// Returns the cosine in radians from a lookup table.
 float MathUtil::cosDeg(float degrees) {
-	return (float) ::cos(degrees * MathUtil::Deg_Rad);
+	if (!_fastTrig) return (float) ::cos(degrees * MathUtil::Deg_Rad);
+	return tableSin(degrees * DEG_TO_INDEX + SIN_COUNT / 4);
+}
+
+void MathUtil::setFastTrig(bool inValue) {
+	if (inValue) buildSinTable();
+	_fastTrig = inValue;
+}
+
+bool MathUtil::isFastTrig() {
+	return _fastTrig;
 }
 
 /* Need to pass 0 as an argument, so VC++ doesn't error with C2124 */
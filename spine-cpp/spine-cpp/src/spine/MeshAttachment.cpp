@@ -29,6 +29,9 @@
 
 #include <spine/MeshAttachment.h>
 
+#include <spine/CompactVertices.h>
+#include <spine/MathUtil.h>
+
 using namespace spine;
 
 RTTI_IMPL(MeshAttachment, VertexAttachment)
@@ -48,15 +51,16 @@ MeshAttachment::~MeshAttachment() {
 }
 
 void MeshAttachment::updateRegion() {
-	if (_uvs.size() != _regionUVs.size()) {
-		_uvs.setSize(_regionUVs.size(), 0);
+	size_t regionUVsCount = _regionUVs.size() + _compactRegionUVs.size();
+	if (_uvs.size() != regionUVsCount) {
+		_uvs.setSize(regionUVsCount, 0);
 	}
 
 	if (_region == nullptr) {
 		return;
 	}
 
-	int i = 0, n = (int) _regionUVs.size();
+	int i = 0, n = (int) regionUVsCount;
 	float u = _region->u, v = _region->v;
 	float width = 0, height = 0;
 	switch (_region->degrees) {
@@ -68,8 +72,8 @@ void MeshAttachment::updateRegion() {
 			width = _region->originalHeight / textureWidth;
 			height = _region->originalWidth / textureHeight;
 			for (i = 0; i < n; i += 2) {
-				_uvs[i] = u + _regionUVs[i + 1] * width;
-				_uvs[i + 1] = v + (1 - _regionUVs[i]) * height;
+				_uvs[i] = u + getRegionUV(i + 1) * width;
+				_uvs[i + 1] = v + (1 - getRegionUV(i)) * height;
 			}
 			return;
 		}
@@ -81,8 +85,8 @@ void MeshAttachment::updateRegion() {
 			width = _region->originalWidth / textureWidth;
 			height = _region->originalHeight / textureHeight;
 			for (i = 0; i < n; i += 2) {
-				_uvs[i] = u + (1 - _regionUVs[i]) * width;
-				_uvs[i + 1] = v + (1 - _regionUVs[i + 1]) * height;
+				_uvs[i] = u + (1 - getRegionUV(i)) * width;
+				_uvs[i + 1] = v + (1 - getRegionUV(i + 1)) * height;
 			}
 			return;
 		}
@@ -94,8 +98,8 @@ void MeshAttachment::updateRegion() {
 			width = _region->originalHeight / textureWidth;
 			height = _region->originalWidth / textureHeight;
 			for (i = 0; i < n; i += 2) {
-				_uvs[i] = u + (1 - _regionUVs[i + 1]) * width;
-				_uvs[i + 1] = v + _regionUVs[i] * height;
+				_uvs[i] = u + (1 - getRegionUV(i + 1)) * width;
+				_uvs[i + 1] = v + getRegionUV(i) * height;
 			}
 			return;
 		}
@@ -107,13 +111,18 @@ void MeshAttachment::updateRegion() {
 			width = _region->originalWidth / textureWidth;
 			height = _region->originalHeight / textureHeight;
 			for (i = 0; i < n; i += 2) {
-				_uvs[i] = u + _regionUVs[i] * width;
-				_uvs[i + 1] = v + _regionUVs[i + 1] * height;
+				_uvs[i] = u + getRegionUV(i) * width;
+				_uvs[i + 1] = v + getRegionUV(i + 1) * height;
 			}
 		}
 	}
 }
 
+float MeshAttachment::getRegionUV(int index) {
+	if (_compactRegionUVs.size() > 0) return _compactRegionUVs[index] / 65535.0f;
+	return _regionUVs[index];
+}
+
 int MeshAttachment::getHullLength() {
 	return _hullLength;
 }
@@ -167,8 +176,11 @@ void MeshAttachment::setParentMesh(MeshAttachment *inValue) {
 	if (inValue != NULL) {
 		_bones.clearAndAddAll(inValue->_bones);
 		_vertices.clearAndAddAll(inValue->_vertices);
+		if (_compactVertices) delete _compactVertices;
+		_compactVertices = inValue->_compactVertices ? new (__FILE__, __LINE__) CompactVertices(*inValue->_compactVertices) : NULL;
 		_worldVerticesLength = inValue->_worldVerticesLength;
 		_regionUVs.clearAndAddAll(inValue->_regionUVs);
+		_compactRegionUVs.clearAndAddAll(inValue->_compactRegionUVs);
 		_triangles.clearAndAddAll(inValue->_triangles);
 		_hullLength = inValue->_hullLength;
 		_edges.clearAndAddAll(inValue->_edges);
@@ -212,6 +224,7 @@ Attachment *MeshAttachment::copy() {
 
 	copyTo(copy);
 	copy->_regionUVs.clearAndAddAll(_regionUVs);
+	copy->_compactRegionUVs.clearAndAddAll(_compactRegionUVs);
 	copy->_uvs.clearAndAddAll(_uvs);
 	copy->_triangles.clearAndAddAll(_triangles);
 	copy->_hullLength = _hullLength;
@@ -239,3 +252,13 @@ void MeshAttachment::computeWorldVertices(Slot &slot, size_t start, size_t count
 	if (_sequence) _sequence->apply(&slot, this);
 	VertexAttachment::computeWorldVertices(slot, start, count, worldVertices, offset, stride);
 }
+
+void MeshAttachment::compact() {
+	VertexAttachment::compact();
+	if (_regionUVs.size() == 0) return;
+	_compactRegionUVs.ensureCapacity(_regionUVs.size());
+	for (size_t i = 0; i < _regionUVs.size(); i++)
+		_compactRegionUVs.add((unsigned short) (MathUtil::clamp(_regionUVs[i], 0, 1) * 65535 + 0.5f));
+	_regionUVs.clear();
+	_regionUVs.shrinkToFit();
+}
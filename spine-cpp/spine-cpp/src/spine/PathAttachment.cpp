@@ -61,6 +61,9 @@ Color &PathAttachment::getColor() {
 	return _color;
 }
 
+void PathAttachment::compact() {
+}
+
 Attachment *PathAttachment::copy() {
 	PathAttachment *copy = new (__FILE__, __LINE__) PathAttachment(getName());
 	copyTo(copy);
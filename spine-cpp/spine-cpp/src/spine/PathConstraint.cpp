@@ -37,6 +37,7 @@
 
 #include <spine/BoneData.h>
 #include <spine/SlotData.h>
+#include <spine/SpineProfiler.h>
 
 using namespace spine;
 
@@ -67,6 +68,7 @@ PathConstraint::PathConstraint(PathConstraintData &data, Skeleton &skeleton) : U
 }
 
 void PathConstraint::update() {
+	SP_PROFILE_ZONE("PathConstraint::update");
 	Attachment *baseAttachment = _target->getAttachment();
 	if (baseAttachment == NULL || !baseAttachment->getRTTI().instanceOf(PathAttachment::rtti)) {
 		return;
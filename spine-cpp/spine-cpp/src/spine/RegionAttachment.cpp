@@ -31,6 +31,7 @@
 
 #include <spine/Bone.h>
 #include <spine/Slot.h>
+#include <spine/SpineProfiler.h>
 
 #include <assert.h>
 
@@ -133,6 +134,7 @@ void RegionAttachment::computeWorldVertices(Slot &slot, Vector<float> &worldVert
 }
 
 void RegionAttachment::computeWorldVertices(Slot &slot, float *worldVertices, size_t offset, size_t stride) {
+	SP_PROFILE_ZONE("RegionAttachment::computeWorldVertices");
 	if (_sequence) _sequence->apply(&slot, this);
 
 	Bone &bone = slot.getBone();
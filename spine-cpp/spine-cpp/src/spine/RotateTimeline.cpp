@@ -82,3 +82,40 @@ void RotateTimeline::apply(Skeleton &skeleton, float lastTime, float time, Vecto
 			bone->_rotation += r * alpha;
 	}
 }
+
+void RotateTimeline::applyBatch(Skeleton **skeletons, float *lastTimes, float *times, size_t count,
+								Vector<Event *> **pEvents, float alpha, MixBlend blend, MixDirection direction) {
+	SP_UNUSED(pEvents);
+	assert(count <= BatchSize);
+
+	// Gather the bones which are keyed at their time, evaluate their curves, then blend.
+	Bone *bones[BatchSize];
+	float values[BatchSize];
+	size_t n = 0;
+	for (size_t i = 0; i < count; i++) {
+		Bone *bone = skeletons[i]->_bones[_boneIndex];
+		if (!bone->_active) continue;
+		if (times[i] < _frames[0])
+			apply(*skeletons[i], lastTimes[i], times[i], NULL, alpha, blend, direction);
+		else {
+			bones[n] = bone;
+			values[n++] = times[i];
+		}
+	}
+	getCurveValues(values, values, n);
+
+	switch (blend) {
+		case MixBlend_Setup:
+			for (size_t i = 0; i < n; i++)
+				bones[i]->_rotation = bones[i]->_data._rotation + values[i] * alpha;
+			break;
+		case MixBlend_First:
+		case MixBlend_Replace:
+			for (size_t i = 0; i < n; i++)
+				bones[i]->_rotation += (values[i] + (bones[i]->_data._rotation - bones[i]->_rotation)) * alpha;
+			break;
+		case MixBlend_Add:
+			for (size_t i = 0; i < n; i++)
+				bones[i]->_rotation += values[i] * alpha;
+	}
+}
@@ -36,10 +36,13 @@
 #include <spine/SkeletonData.h>
 #include <spine/Skin.h>
 #include <spine/Slot.h>
+#include <spine/SpineProfiler.h>
 #include <spine/TransformConstraint.h>
 
 #include <spine/BoneData.h>
+#include <spine/BoneMask.h>
 #include <spine/IkConstraintData.h>
+#include <spine/LodLevel.h>
 #include <spine/MeshAttachment.h>
 #include <spine/PathAttachment.h>
 #include <spine/PathConstraintData.h>
@@ -59,7 +62,17 @@ Skeleton::Skeleton(SkeletonData *skeletonData) : _data(skeletonData),
 												 _scaleX(1),
 												 _scaleY(1),
 												 _x(0),
-												 _y(0) {
+												 _y(0),
+												 _lodLevel(0),
+												 _boneMask(NULL),
+												 _incremental(false),
+												 _updateAll(true),
+												 _updateFrame(0),
+												 _updatedBones(0),
+												 _updateX(0),
+												 _updateY(0),
+												 _updateScaleX(1),
+												 _updateScaleY(1) {
 	_bones.ensureCapacity(_data->getBones().size());
 	for (size_t i = 0; i < _data->getBones().size(); ++i) {
 		BoneData *data = _data->getBones()[i];
@@ -128,6 +141,7 @@ Skeleton::~Skeleton() {
 
 void Skeleton::updateCache() {
 	_updateCache.clear();
+	_updateAll = true;
 
 	for (size_t i = 0, n = _bones.size(); i < n; ++i) {
 		Bone *bone = _bones[i];
@@ -147,6 +161,17 @@ void Skeleton::updateCache() {
 		}
 	}
 
+	if (_boneMask) {
+		for (size_t i = 0, n = _bones.size(); i < n; ++i) {
+			Bone *bone = _bones[i];
+			if (_boneMask->_boneFlags[i]) continue;
+			bone->_sorted = true;
+			bone->_active = false;
+		}
+	}
+
+	updateLodBones();
+
 	size_t ikCount = _ikConstraints.size();
 	size_t transformCount = _transformConstraints.size();
 	size_t pathCount = _pathConstraints.size();
@@ -190,6 +215,101 @@ continue_outer:
 	}
 }
 
+// Update cache indices store the kind of updatable in the low bits.
+static const int UPDATE_BONE = 0, UPDATE_IK = 1, UPDATE_TRANSFORM = 2, UPDATE_PATH = 3;
+
+void Skeleton::getUpdateCache(Vector<int> &indices) {
+	indices.clear();
+	indices.ensureCapacity(_updateCache.size());
+	for (size_t i = 0, n = _updateCache.size(); i < n; ++i) {
+		Updatable *updatable = _updateCache[i];
+		const RTTI &rtti = updatable->getRTTI();
+		if (rtti.isExactly(Bone::rtti))
+			indices.add((static_cast<Bone *>(updatable)->_data.getIndex() << 2) | UPDATE_BONE);
+		else if (rtti.isExactly(IkConstraint::rtti))
+			indices.add((_ikConstraints.indexOf(static_cast<IkConstraint *>(updatable)) << 2) | UPDATE_IK);
+		else if (rtti.isExactly(TransformConstraint::rtti))
+			indices.add((_transformConstraints.indexOf(static_cast<TransformConstraint *>(updatable)) << 2) | UPDATE_TRANSFORM);
+		else
+			indices.add((_pathConstraints.indexOf(static_cast<PathConstraint *>(updatable)) << 2) | UPDATE_PATH);
+	}
+}
+
+void Skeleton::setUpdateCache(Vector<int> &indices) {
+	// Only bones and constraints in the update cache are active.
+	for (size_t i = 0, n = _bones.size(); i < n; ++i) {
+		_bones[i]->_sorted = true;
+		_bones[i]->_active = false;
+	}
+	for (size_t i = 0, n = _ikConstraints.size(); i < n; ++i)
+		_ikConstraints[i]->_active = false;
+	for (size_t i = 0, n = _transformConstraints.size(); i < n; ++i)
+		_transformConstraints[i]->_active = false;
+	for (size_t i = 0, n = _pathConstraints.size(); i < n; ++i)
+		_pathConstraints[i]->_active = false;
+	updateLodBones();
+
+	_updateCache.clear();
+	_updateAll = true;
+	_updateCache.ensureCapacity(indices.size());
+	for (size_t i = 0, n = indices.size(); i < n; ++i) {
+		int index = indices[i] >> 2;
+		Updatable *updatable;
+		switch (indices[i] & 3) {
+			case UPDATE_BONE:
+				updatable = _bones[index];
+				break;
+			case UPDATE_IK:
+				updatable = _ikConstraints[index];
+				break;
+			case UPDATE_TRANSFORM:
+				updatable = _transformConstraints[index];
+				break;
+			default:
+				updatable = _pathConstraints[index];
+		}
+		updatable->setActive(true);
+		_updateCache.add(updatable);
+	}
+}
+
+void Skeleton::updateLodBones() {
+	LodLevel *level = _lodLevel == 0 ? NULL : _data->_lodLevels[_lodLevel - 1];
+	for (size_t i = 0, n = _bones.size(); i < n; ++i) {
+		Bone *bone = _bones[i];
+		bone->_rigid = false;
+		if (!level || !bone->_parent) continue;
+
+		// Bones are ordered parent first, so the parent's rigid state is already known.
+		if (bone->_parent->_rigid || level->_bones.contains(&bone->_data)) {
+			bone->_rigid = true;
+		} else if (level->_maxBoneDepth >= 0) {
+			int depth = 0;
+			for (Bone *parent = bone->_parent; parent; parent = parent->_parent)
+				depth++;
+			bone->_rigid = depth > level->_maxBoneDepth;
+		}
+		if (!bone->_rigid) continue;
+
+		// Rigid bones keep their setup pose local transform relative to the parent.
+		BoneData &data = bone->_data;
+		float rotationX = data.getRotation() + data.getShearX(), rotationY = data.getRotation() + 90 + data.getShearY();
+		bone->_rigidA = MathUtil::cosDeg(rotationX) * data.getScaleX();
+		bone->_rigidB = MathUtil::cosDeg(rotationY) * data.getScaleY();
+		bone->_rigidC = MathUtil::sinDeg(rotationX) * data.getScaleX();
+		bone->_rigidD = MathUtil::sinDeg(rotationY) * data.getScaleY();
+	}
+}
+
+bool Skeleton::isExcluded(ConstraintData &constraintData, Vector<Bone *> &constrained) {
+	if (_boneMask && !_boneMask->_constraints.contains(&constraintData)) return true;
+	if (_lodLevel == 0) return false;
+	if (_data->_lodLevels[_lodLevel - 1]->_constraints.contains(&constraintData)) return true;
+	for (size_t i = 0, n = constrained.size(); i < n; i++)
+		if (constrained[i]->_rigid) return true;
+	return false;
+}
+
 void Skeleton::printUpdateCache() {
 	for (size_t i = 0; i < _updateCache.size(); i++) {
 		Updatable *updatable = _updateCache[i];
@@ -205,7 +325,23 @@ void Skeleton::printUpdateCache() {
 	}
 }
 
+void Skeleton::beginUpdate() {
+	_updatedBones = 0;
+	if (!_incremental) return;
+	_updateFrame++;
+	float scaleY = getScaleY();
+	if (_x != _updateX || _y != _updateY || _scaleX != _updateScaleX || scaleY != _updateScaleY) {
+		_updateAll = true;
+		_updateX = _x;
+		_updateY = _y;
+		_updateScaleX = _scaleX;
+		_updateScaleY = scaleY;
+	}
+}
+
 void Skeleton::updateWorldTransform() {
+	SP_PROFILE_ZONE("Skeleton::updateWorldTransform");
+	beginUpdate();
 	for (size_t i = 0, n = _bones.size(); i < n; i++) {
 		Bone *bone = _bones[i];
 		bone->_ax = bone->_x;
@@ -220,11 +356,17 @@ void Skeleton::updateWorldTransform() {
 	for (size_t i = 0, n = _updateCache.size(); i < n; ++i) {
 		_updateCache[i]->update();
 	}
+	_updateAll = false;
+	SP_PROFILE_COUNTER("Skeleton updated bones", _updatedBones);
 }
 
 void Skeleton::updateWorldTransform(Bone *parent) {
+	SP_PROFILE_ZONE("Skeleton::updateWorldTransform");
+	beginUpdate();
+
 	// Apply the parent bone transform to the root bone. The root bone always inherits scale, rotation and reflection.
 	Bone &rootBone = *getRootBone();
+	rootBone.setModified();
 	float pa = parent->_a, pb = parent->_b, pc = parent->_c, pd = parent->_d;
 	rootBone._worldX = pa * _x + pb * _y + parent->_worldX;
 	rootBone._worldY = pc * _x + pd * _y + parent->_worldY;
@@ -245,6 +387,8 @@ void Skeleton::updateWorldTransform(Bone *parent) {
 		Updatable *updatable = _updateCache[i];
 		if (updatable != rb) updatable->update();
 	}
+	_updateAll = false;
+	SP_PROFILE_COUNTER("Skeleton updated bones", _updatedBones);
 }
 
 void Skeleton::setToSetupPose() {
@@ -320,6 +464,11 @@ void Skeleton::setSkin(const String &skinName) {
 
 void Skeleton::setSkin(Skin *newSkin) {
 	if (_skin == newSkin) return;
+	attachSkin(newSkin);
+	updateCache();
+}
+
+void Skeleton::attachSkin(Skin *newSkin) {
 	if (newSkin != NULL) {
 		if (_skin != NULL) {
 			Skeleton &thisRef = *this;
@@ -340,7 +489,6 @@ void Skeleton::setSkin(Skin *newSkin) {
 	}
 
 	_skin = newSkin;
-	updateCache();
 }
 
 Attachment *Skeleton::getAttachment(const String &slotName, const String &attachmentName) {
@@ -551,9 +699,44 @@ void Skeleton::setScaleY(float inValue) {
 	_scaleY = inValue;
 }
 
+size_t Skeleton::getLodLevel() {
+	return _lodLevel;
+}
+
+void Skeleton::setLodLevel(size_t inValue) {
+	assert(inValue <= _data->_lodLevels.size());
+	if (_lodLevel == inValue) return;
+	_lodLevel = inValue;
+	updateCache();
+}
+
+void Skeleton::setBoneMask(BoneMask *inValue) {
+	if (_boneMask == inValue) return;
+	_boneMask = inValue;
+	updateCache();
+}
+
+BoneMask *Skeleton::getBoneMask() {
+	return _boneMask;
+}
+
+void Skeleton::setIncremental(bool inValue) {
+	_incremental = inValue;
+	_updateAll = true;
+}
+
+bool Skeleton::isIncremental() {
+	return _incremental;
+}
+
+int Skeleton::getUpdatedBoneCount() {
+	return _updatedBones;
+}
+
 void Skeleton::sortIkConstraint(IkConstraint *constraint) {
 	constraint->_active = constraint->_target->_active && (!constraint->_data.isSkinRequired() ||
-														   (_skin && _skin->_constraints.contains(&constraint->_data)));
+														   (_skin && _skin->_constraints.contains(&constraint->_data))) &&
+						  !isExcluded(constraint->_data, constraint->_bones);
 	if (!constraint->_active) return;
 
 	Bone *target = constraint->getTarget();
@@ -580,7 +763,8 @@ void Skeleton::sortIkConstraint(IkConstraint *constraint) {
 void Skeleton::sortPathConstraint(PathConstraint *constraint) {
 	constraint->_active = constraint->_target->_bone._active && (!constraint->_data.isSkinRequired() || (_skin &&
 																										 _skin->_constraints.contains(
-																												 &constraint->_data)));
+																												 &constraint->_data))) &&
+						  !isExcluded(constraint->_data, constraint->_bones);
 	if (!constraint->_active) return;
 
 	Slot *slot = constraint->getTarget();
@@ -612,7 +796,8 @@ void Skeleton::sortPathConstraint(PathConstraint *constraint) {
 
 void Skeleton::sortTransformConstraint(TransformConstraint *constraint) {
 	constraint->_active = constraint->_target->_active && (!constraint->_data.isSkinRequired() ||
-														   (_skin && _skin->_constraints.contains(&constraint->_data)));
+														   (_skin && _skin->_constraints.contains(&constraint->_data))) &&
+						  !isExcluded(constraint->_data, constraint->_bones);
 	if (!constraint->_active) return;
 
 	sortBone(constraint->getTarget());
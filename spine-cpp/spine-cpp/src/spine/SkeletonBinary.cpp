@@ -37,6 +37,7 @@
 #include <spine/LinkedMesh.h>
 #include <spine/SkeletonData.h>
 #include <spine/Skin.h>
+#include <spine/SpineProfiler.h>
 #include <spine/VertexAttachment.h>
 
 #include <spine/AttachmentTimeline.h>
@@ -45,6 +46,7 @@
 #include <spine/BoundingBoxAttachment.h>
 #include <spine/ClippingAttachment.h>
 #include <spine/ColorTimeline.h>
+#include <spine/CompactVertices.h>
 #include <spine/ContainerUtil.h>
 #include <spine/DeformTimeline.h>
 #include <spine/DrawOrderTimeline.h>
@@ -75,17 +77,26 @@ using namespace spine;
 
 SkeletonBinary::SkeletonBinary(Atlas *atlasArray) : _attachmentLoader(
 															new (__FILE__, __LINE__) AtlasAttachmentLoader(atlasArray)),
-													_error(), _scale(1), _ownsLoader(true) {
+													_error(), _scale(1), _ownsLoader(true), _lazyAnimations(false),
+													_headless(false), _headlessVertices(true), _compactAttachments(false) {
 }
 
 SkeletonBinary::SkeletonBinary(AttachmentLoader *attachmentLoader, bool ownsLoader) : _attachmentLoader(
 																							  attachmentLoader),
 																					  _error(),
 																					  _scale(1),
-																					  _ownsLoader(ownsLoader) {
+																					  _ownsLoader(ownsLoader),
+																					  _lazyAnimations(false),
+																					  _headless(false),
+																					  _headlessVertices(true),
+																					  _compactAttachments(false) {
 	assert(_attachmentLoader != NULL);
 }
 
+SkeletonBinary::SkeletonBinary(float scale) : _attachmentLoader(NULL), _error(), _scale(scale), _ownsLoader(false),
+											  _lazyAnimations(false), _headless(false), _headlessVertices(true), _compactAttachments(false) {
+}
+
 SkeletonBinary::~SkeletonBinary() {
 	ContainerUtil::cleanUpVectorOfPointers(_linkedMeshes);
 	_linkedMeshes.clear();
@@ -94,6 +105,7 @@ SkeletonBinary::~SkeletonBinary() {
 }
 
 SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, const int length) {
+	SP_PROFILE_ZONE("SkeletonBinary::readSkeletonData");
 	bool nonessential;
 	SkeletonData *skeletonData;
 
@@ -332,9 +344,25 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 	/* Animations. */
 	int animationsCount = readVarint(input, true);
 	skeletonData->_animations.setSize(animationsCount, 0);
+	const unsigned char *animationsStart = input->cursor;
+	if (_lazyAnimations) {
+		skeletonData->_animationOffsets.setSize(animationsCount, 0);
+		skeletonData->_animationDecoded.setSize(animationsCount, false);
+	}
 	for (int i = 0; i < animationsCount; ++i) {
 		String name(readString(input), true);
-		Animation *animation = readAnimation(name, input, skeletonData);
+		Animation *animation = NULL;
+		if (_lazyAnimations) {
+			// Only record where the animation starts, it is decoded by SkeletonData when it is first used.
+			skeletonData->_animationOffsets[i] = (int) (input->cursor - animationsStart);
+			float duration = 0;
+			if (skipAnimation(input, skeletonData, duration)) {
+				Vector<Timeline *> timelines;
+				animation = new (__FILE__, __LINE__) Animation(name, timelines, duration);
+			}
+		} else {
+			animation = readAnimation(name, input, skeletonData);
+		}
 		if (!animation) {
 			delete input;
 			delete skeletonData;
@@ -342,6 +370,16 @@ SkeletonData *SkeletonBinary::readSkeletonData(const unsigned char *binary, cons
 		}
 		skeletonData->_animations[i] = animation;
 	}
+	if (_lazyAnimations && animationsCount > 0) {
+		int animationDataLength = (int) (input->cursor - animationsStart);
+		skeletonData->_animationData = SpineExtension::alloc<unsigned char>(animationDataLength, __FILE__, __LINE__);
+		memcpy(skeletonData->_animationData, animationsStart, animationDataLength);
+		skeletonData->_animationDataLength = animationDataLength;
+		skeletonData->_animationScale = _scale;
+		skeletonData->_animationLock = SpineExtension::createMutex();
+	}
+	if (_headless) skeletonData->stripRenderData(_headlessVertices);
+	if (_compactAttachments) skeletonData->compactAttachments();
 
 	delete input;
 	return skeletonData;
@@ -1256,9 +1294,10 @@ Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, S
 				switch (timelineType) {
 					case ATTACHMENT_DEFORM: {
 						VertexAttachment *attachment = static_cast<VertexAttachment *>(baseAttachment);
-						bool weighted = attachment->_bones.size() > 0;
+						bool weighted = attachment->isWeighted();
 						Vector<float> &vertices = attachment->_vertices;
 						int deformLength = weighted ? (int) vertices.size() / 3 * 2 : (int) vertices.size();
+						if (attachment->_compactVertices) deformLength = (int) attachment->_compactVertices->getInfluenceCount() * 2;
 
 						int bezierCount = readVarint(input, true);
 						DeformTimeline *timeline = new (__FILE__, __LINE__) DeformTimeline(frameCount, bezierCount, slotIndex,
@@ -1399,3 +1438,171 @@ Animation *SkeletonBinary::readAnimation(const String &name, DataInput *input, S
 	}
 	return new (__FILE__, __LINE__) Animation(String(name), timelines, duration);
 }
+
+void SkeletonBinary::skipFrames(DataInput *input, int frameCount, int valueSize, int curveCount, int extraSize,
+								float &duration) {
+	for (int frame = 0; frame < frameCount; frame++) {
+		duration = MathUtil::max(duration, readFloat(input));
+		input->cursor += valueSize;
+		// The curve of the previous frame follows the values.
+		if (frame > 0 && readSByte(input) == CURVE_BEZIER) input->cursor += curveCount * 16;
+		input->cursor += extraSize;
+	}
+}
+
+bool SkeletonBinary::skipAnimation(DataInput *input, SkeletonData *skeletonData, float &duration) {
+	readVarint(input, true);
+	// Slot timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		int slotIndex = readVarint(input, true);
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ++ii) {
+			unsigned char timelineType = readByte(input);
+			int frameCount = readVarint(input, true);
+			if (timelineType == SLOT_ATTACHMENT) {
+				for (int frame = 0; frame < frameCount; ++frame) {
+					duration = MathUtil::max(duration, readFloat(input));
+					readVarint(input, true);
+				}
+				continue;
+			}
+			int channels;
+			switch (timelineType) {
+				case SLOT_RGBA:
+					channels = 4;
+					break;
+				case SLOT_RGB:
+					channels = 3;
+					break;
+				case SLOT_RGBA2:
+					channels = 7;
+					break;
+				case SLOT_RGB2:
+					channels = 6;
+					break;
+				case SLOT_ALPHA:
+					channels = 1;
+					break;
+				default:
+					setError("Invalid timeline type for a slot: ", skeletonData->_slots[slotIndex]->_name.buffer());
+					return false;
+			}
+			readVarint(input, true);
+			skipFrames(input, frameCount, channels, channels, 0, duration);
+		}
+	}
+
+	// Bone timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		int boneIndex = readVarint(input, true);
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ++ii) {
+			unsigned char timelineType = readByte(input);
+			int frameCount = readVarint(input, true);
+			readVarint(input, true);
+			int values;
+			switch (timelineType) {
+				case BONE_ROTATE:
+				case BONE_TRANSLATEX:
+				case BONE_TRANSLATEY:
+				case BONE_SCALEX:
+				case BONE_SCALEY:
+				case BONE_SHEARX:
+				case BONE_SHEARY:
+					values = 1;
+					break;
+				case BONE_TRANSLATE:
+				case BONE_SCALE:
+				case BONE_SHEAR:
+					values = 2;
+					break;
+				default:
+					setError("Invalid timeline type for a bone: ", skeletonData->_bones[boneIndex]->_name.buffer());
+					return false;
+			}
+			skipFrames(input, frameCount, values * 4, values, 0, duration);
+		}
+	}
+
+	// IK timelines: mix and softness, then bend direction, compress and stretch.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		readVarint(input, true);
+		int frameCount = readVarint(input, true);
+		readVarint(input, true);
+		skipFrames(input, frameCount, 8, 2, 3, duration);
+	}
+
+	// Transform constraint timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		readVarint(input, true);
+		int frameCount = readVarint(input, true);
+		readVarint(input, true);
+		skipFrames(input, frameCount, 24, 6, 0, duration);
+	}
+
+	// Path constraint timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		readVarint(input, true);
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ii++) {
+			int values = readSByte(input) == PATH_MIX ? 3 : 1;
+			int frameCount = readVarint(input, true);
+			readVarint(input, true);
+			skipFrames(input, frameCount, values * 4, values, 0, duration);
+		}
+	}
+
+	// Deform timelines.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		Skin *skin = skeletonData->_skins[readVarint(input, true)];
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ++ii) {
+			int slotIndex = readVarint(input, true);
+			for (int iii = 0, nnn = readVarint(input, true); iii < nnn; iii++) {
+				const char *attachmentName = readStringRef(input, skeletonData);
+				if (!skin->getAttachment(slotIndex, String(attachmentName))) {
+					setError("Attachment not found: ", attachmentName);
+					return false;
+				}
+				unsigned int timelineType = readByte(input);
+				int frameCount = readVarint(input, true);
+				if (timelineType == ATTACHMENT_DEFORM) {
+					readVarint(input, true);
+					for (int frame = 0; frame < frameCount; frame++) {
+						duration = MathUtil::max(duration, readFloat(input));
+						if (frame > 0 && readSByte(input) == CURVE_BEZIER) input->cursor += 16;
+						int end = readVarint(input, true);
+						if (end != 0) {
+							readVarint(input, true);
+							input->cursor += end * 4;
+						}
+					}
+				} else if (timelineType == ATTACHMENT_SEQUENCE) {
+					for (int frame = 0; frame < frameCount; frame++) {
+						duration = MathUtil::max(duration, readFloat(input));
+						input->cursor += 8;
+					}
+				}
+			}
+		}
+	}
+
+	// Draw order timeline.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		duration = MathUtil::max(duration, readFloat(input));
+		for (int ii = 0, nn = readVarint(input, true); ii < nn; ++ii) {
+			readVarint(input, true);
+			readVarint(input, true);
+		}
+	}
+
+	// Event timeline.
+	for (int i = 0, n = readVarint(input, true); i < n; ++i) {
+		duration = MathUtil::max(duration, readFloat(input));
+		EventData *eventData = skeletonData->_events[readVarint(input, true)];
+		readVarint(input, false);
+		readFloat(input);
+		if (readBoolean(input)) {
+			int length = readVarint(input, true);
+			if (length > 0) input->cursor += length - 1;
+		}
+		if (!eventData->_audioPath.isEmpty()) input->cursor += 8;
+	}
+	return true;
+}
@@ -31,6 +31,7 @@
 
 #include <spine/ClippingAttachment.h>
 #include <spine/Slot.h>
+#include <spine/SpineProfiler.h>
 
 using namespace spine;
 
@@ -89,6 +90,7 @@ void SkeletonClipping::clipTriangles(Vector<float> &vertices, Vector<unsigned sh
 
 void SkeletonClipping::clipTriangles(float *vertices, unsigned short *triangles,
 									 size_t trianglesLength, float *uvs, size_t stride) {
+	SP_PROFILE_ZONE("SkeletonClipping::clipTriangles");
 	Vector<float> &clipOutput = _clipOutput;
 	Vector<float> &clippedVertices = _clippedVertices;
 	Vector<unsigned short> &clippedTriangles = _clippedTriangles;
@@ -31,17 +31,42 @@
 
 #include <spine/Animation.h>
 #include <spine/BoneData.h>
+#include <spine/ColorTimeline.h>
+#include <spine/CompactVertices.h>
+#include <spine/DeformTimeline.h>
 #include <spine/EventData.h>
 #include <spine/IkConstraintData.h>
+#include <spine/LodLevel.h>
+#include <spine/MeshAttachment.h>
 #include <spine/PathConstraintData.h>
+#include <spine/SequenceTimeline.h>
+#include <spine/SkeletonBinary.h>
 #include <spine/Skin.h>
 #include <spine/SlotData.h>
+#include <spine/SpineProfiler.h>
 #include <spine/TransformConstraintData.h>
 
 #include <spine/ContainerUtil.h>
 
 using namespace spine;
 
+namespace spine {
+	// Locks the mutex of lazily read animations while in scope, if the skeleton data has one.
+	class AnimationLockGuard : public SpineObject {
+	public:
+		explicit AnimationLockGuard(void *mutex) : _mutex(mutex) {
+			if (_mutex) SpineExtension::lockMutex(_mutex);
+		}
+
+		~AnimationLockGuard() {
+			if (_mutex) SpineExtension::unlockMutex(_mutex);
+		}
+
+	private:
+		void *_mutex;
+	};
+}
+
 SkeletonData::SkeletonData() : _name(),
 							   _defaultSkin(NULL),
 							   _x(0),
@@ -50,6 +75,12 @@ SkeletonData::SkeletonData() : _name(),
 							   _height(0),
 							   _version(),
 							   _hash(),
+							   _animationData(NULL),
+							   _animationDataLength(0),
+							   _animationScale(1),
+							   _animationLock(NULL),
+							   _renderDataStripped(false),
+							   _verticesStripped(false),
 							   _fps(0),
 							   _imagesPath() {
 }
@@ -66,9 +97,12 @@ SkeletonData::~SkeletonData() {
 	ContainerUtil::cleanUpVectorOfPointers(_ikConstraints);
 	ContainerUtil::cleanUpVectorOfPointers(_transformConstraints);
 	ContainerUtil::cleanUpVectorOfPointers(_pathConstraints);
+	ContainerUtil::cleanUpVectorOfPointers(_lodLevels);
 	for (size_t i = 0; i < _strings.size(); i++) {
 		SpineExtension::free(_strings[i], __FILE__, __LINE__);
 	}
+	if (_animationData) SpineExtension::free(_animationData, __FILE__, __LINE__);
+	if (_animationLock) SpineExtension::disposeMutex(_animationLock);
 }
 
 BoneData *SkeletonData::findBone(const String &boneName) {
@@ -88,7 +122,143 @@ spine::EventData *SkeletonData::findEvent(const String &eventDataName) {
 }
 
 Animation *SkeletonData::findAnimation(const String &animationName) {
-	return ContainerUtil::findWithName(_animations, animationName);
+	Animation *animation = ContainerUtil::findWithName(_animations, animationName);
+	if (animation && _animationData) decodeAnimation(animation);
+	return animation;
+}
+
+void SkeletonData::decodeAnimation(Animation *animation) {
+	if (!_animationData) return;
+	int index = _animations.indexOf(animation);
+	if (index == -1) return;
+	AnimationLockGuard lock(_animationLock);
+	decodeAnimation((size_t) index);
+}
+
+void SkeletonData::decodeAnimations() {
+	if (!_animationData) return;
+	AnimationLockGuard lock(_animationLock);
+	for (size_t i = 0, n = _animations.size(); i < n; i++)
+		decodeAnimation(i);
+}
+
+void SkeletonData::decodeAnimation(size_t index) {
+	if (_animationDecoded[index]) return;
+	SP_PROFILE_ZONE("SkeletonData::decodeAnimation");
+	SkeletonBinary binary(_animationScale);
+	SkeletonBinary::DataInput input;
+	input.cursor = _animationData + _animationOffsets[index];
+	input.end = _animationData + _animationDataLength;
+	Animation *animation = _animations[index];
+	Animation *decoded = binary.readAnimation(animation->getName(), &input, this);
+	if (!decoded) return;
+	animation->setTimelines(decoded->_timelines);
+	decoded->_timelines.clear();
+	delete decoded;
+	if (_renderDataStripped) stripTimelines(animation);
+	_animationDecoded[index] = true;
+}
+
+void SkeletonData::evictAnimation(Animation *animation) {
+	if (!_animationData) return;
+	int index = _animations.indexOf(animation);
+	if (index == -1) return;
+	AnimationLockGuard lock(_animationLock);
+	if (!_animationDecoded[index]) return;
+	Vector<Timeline *> timelines;
+	animation->setTimelines(timelines);
+	_animationDecoded[index] = false;
+}
+
+void SkeletonData::evictAnimations() {
+	for (size_t i = 0, n = _animations.size(); i < n; i++)
+		evictAnimation(_animations[i]);
+}
+
+bool SkeletonData::isAnimationDecoded(Animation *animation) {
+	if (!_animationData) return true;
+	int index = _animations.indexOf(animation);
+	if (index == -1) return true;
+	AnimationLockGuard lock(_animationLock);
+	return _animationDecoded[index];
+}
+
+void SkeletonData::stripRenderData(bool vertices) {
+	if (!vertices && _animationData) {
+		// Deform timelines can't be decoded once mesh vertices are freed, so the animations stop being lazy.
+		decodeAnimations();
+		SpineExtension::free(_animationData, __FILE__, __LINE__);
+		_animationData = NULL;
+		_animationDataLength = 0;
+		_animationOffsets.clear();
+		_animationDecoded.clear();
+	}
+	_renderDataStripped = true;
+	_verticesStripped = _verticesStripped || !vertices;
+
+	for (size_t i = 0; i < _skins.size(); i++) {
+		Skin::AttachmentMap::Entries entries = _skins[i]->getAttachments();
+		while (entries.hasNext()) {
+			Attachment *attachment = entries.next()._attachment;
+			if (!attachment->getRTTI().isExactly(MeshAttachment::rtti)) continue;
+			MeshAttachment *mesh = static_cast<MeshAttachment *>(attachment);
+			mesh->getUVs().clear();
+			mesh->getUVs().shrinkToFit();
+			mesh->getRegionUVs().clear();
+			mesh->getRegionUVs().shrinkToFit();
+			mesh->_compactRegionUVs.clear();
+			mesh->_compactRegionUVs.shrinkToFit();
+			mesh->getTriangles().clear();
+			mesh->getTriangles().shrinkToFit();
+			mesh->getEdges().clear();
+			mesh->getEdges().shrinkToFit();
+			if (_verticesStripped) {
+				mesh->getBones().clear();
+				mesh->getBones().shrinkToFit();
+				mesh->getVertices().clear();
+				mesh->getVertices().shrinkToFit();
+				if (mesh->_compactVertices) delete mesh->_compactVertices;
+				mesh->_compactVertices = NULL;
+				mesh->setWorldVerticesLength(0);
+			}
+		}
+	}
+
+	AnimationLockGuard lock(_animationLock);
+	for (size_t i = 0; i < _animations.size(); i++)
+		if (!_animationData || _animationDecoded[i]) stripTimelines(_animations[i]);
+}
+
+void SkeletonData::compactAttachments() {
+	for (size_t i = 0; i < _skins.size(); i++) {
+		Skin::AttachmentMap::Entries entries = _skins[i]->getAttachments();
+		while (entries.hasNext()) {
+			Attachment *attachment = entries.next()._attachment;
+			if (attachment->getRTTI().isExactly(MeshAttachment::rtti))
+				static_cast<MeshAttachment *>(attachment)->compact();
+		}
+	}
+}
+
+void SkeletonData::stripTimelines(Animation *animation) {
+	Vector<Timeline *> kept;
+	for (size_t i = 0, n = animation->_timelines.size(); i < n; i++) {
+		Timeline *timeline = animation->_timelines[i];
+		const RTTI &rtti = timeline->getRTTI();
+		bool strip = rtti.isExactly(RGBATimeline::rtti) || rtti.isExactly(RGBTimeline::rtti) || rtti.isExactly(AlphaTimeline::rtti) ||
+					 rtti.isExactly(RGBA2Timeline::rtti) || rtti.isExactly(RGB2Timeline::rtti) ||
+					 rtti.isExactly(SequenceTimeline::rtti);
+		// Deform timelines of paths and bounding boxes are kept, they affect the pose and bounds.
+		if (_verticesStripped && rtti.isExactly(DeformTimeline::rtti))
+			strip = static_cast<DeformTimeline *>(timeline)->getAttachment()->getRTTI().isExactly(MeshAttachment::rtti);
+		if (strip)
+			delete timeline;
+		else
+			kept.add(timeline);
+	}
+	if (kept.size() == animation->_timelines.size()) return;
+	animation->_timelines.clear();
+	animation->setTimelines(kept);
 }
 
 IkConstraintData *SkeletonData::findIkConstraint(const String &constraintName) {
@@ -151,6 +321,10 @@ Vector<PathConstraintData *> &SkeletonData::getPathConstraints() {
 	return _pathConstraints;
 }
 
+Vector<LodLevel *> &SkeletonData::getLodLevels() {
+	return _lodLevels;
+}
+
 float SkeletonData::getX() {
 	return _x;
 }
@@ -35,6 +35,7 @@
 #include <spine/Json.h>
 #include <spine/LinkedMesh.h>
 #include <spine/SkeletonData.h>
+#include <spine/SpineProfiler.h>
 #include <spine/VertexAttachment.h>
 
 #include <spine/AttachmentTimeline.h>
@@ -99,11 +100,15 @@ static void toColor(Color &color, const char *value, bool hasAlpha) {
 }
 
 SkeletonJson::SkeletonJson(Atlas *atlas) : _attachmentLoader(new (__FILE__, __LINE__) AtlasAttachmentLoader(atlas)),
-										   _scale(1), _ownsLoader(true) {}
+										   _scale(1), _ownsLoader(true), _headless(false), _headlessVertices(true),
+										   _compactAttachments(false) {}
 
 SkeletonJson::SkeletonJson(AttachmentLoader *attachmentLoader, bool ownsLoader) : _attachmentLoader(attachmentLoader),
 																				  _scale(1),
-																				  _ownsLoader(ownsLoader) {
+																				  _ownsLoader(ownsLoader),
+																				  _headless(false),
+																				  _headlessVertices(true),
+																				  _compactAttachments(false) {
 	assert(_attachmentLoader != NULL);
 }
 
@@ -130,6 +135,7 @@ SkeletonData *SkeletonJson::readSkeletonDataFile(const String &path) {
 }
 
 SkeletonData *SkeletonJson::readSkeletonData(const char *json) {
+	SP_PROFILE_ZONE("SkeletonJson::readSkeletonData");
 	int i, ii;
 	SkeletonData *skeletonData;
 	Json *root, *skeleton, *bones, *boneMap, *ik, *transform, *path, *slots, *skins, *animations, *events;
@@ -779,6 +785,8 @@ SkeletonData *SkeletonJson::readSkeletonData(const char *json) {
 	}
 
 	delete root;
+	if (_headless) skeletonData->stripRenderData(_headlessVertices);
+	if (_compactAttachments) skeletonData->compactAttachments();
 
 	return skeletonData;
 }
@@ -0,0 +1,469 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated September 24, 2021. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2021, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <spine/SkeletonSnapshot.h>
+
+#include <spine/AnimationState.h>
+#include <spine/Bone.h>
+#include <spine/IkConstraint.h>
+#include <spine/PathConstraint.h>
+#include <spine/Skeleton.h>
+#include <spine/SkeletonData.h>
+#include <spine/Slot.h>
+#include <spine/SlotData.h>
+#include <spine/TransformConstraint.h>
+
+using namespace spine;
+
+static const int MAGIC = 0x50414e53;
+
+const int SkeletonSnapshot::Version = 2;
+
+// Writes values at increasing offsets, or only counts their size if data is NULL.
+class SnapshotWriter {
+public:
+	explicit SnapshotWriter(char *data) : _data(data), _position(0) {
+	}
+
+	template<typename T>
+	void write(T value) {
+		if (_data) memcpy(_data + _position, &value, sizeof(T));
+		_position += sizeof(T);
+	}
+
+	template<typename T>
+	void write(Vector<T> &values) {
+		write((int) values.size());
+		if (_data && values.size() > 0) memcpy(_data + _position, values.buffer(), values.size() * sizeof(T));
+		_position += values.size() * sizeof(T);
+	}
+
+	void write(const Color &color) {
+		write(color.r);
+		write(color.g);
+		write(color.b);
+		write(color.a);
+	}
+
+	char *_data;
+	size_t _position;
+};
+
+class SnapshotReader {
+public:
+	explicit SnapshotReader(const char *data) : _data(data), _position(0) {
+	}
+
+	template<typename T>
+	T read() {
+		T value;
+		memcpy(&value, _data + _position, sizeof(T));
+		_position += sizeof(T);
+		return value;
+	}
+
+	template<typename T>
+	void read(Vector<T> &values) {
+		int count = read<int>();
+		values.clear();
+		if (count == 0) return;
+		values.setSize(count, T());
+		memcpy(values.buffer(), _data + _position, count * sizeof(T));
+		_position += count * sizeof(T);
+	}
+
+	void read(Color &color) {
+		color.r = read<float>();
+		color.g = read<float>();
+		color.b = read<float>();
+		color.a = read<float>();
+	}
+
+	const char *_data;
+	size_t _position;
+};
+
+SkeletonSnapshot::SkeletonSnapshot() {
+}
+
+void SkeletonSnapshot::save(Skeleton &skeleton, AnimationState *state) {
+	_entries.clear();
+	if (state) {
+		assert(state->_queue->_eventQueueEntries.size() == 0);
+		for (size_t i = 0; i < state->_tracks.size(); i++)
+			collectEntry(state->_tracks[i]);
+	}
+
+	size_t size = 0;
+	write(NULL, skeleton, state, size);
+	_buffer.setSize(size, 0);
+	write(_buffer.buffer(), skeleton, state, size);
+}
+
+void SkeletonSnapshot::collectEntry(TrackEntry *entry) {
+	if (!entry || _entries.contains(entry)) return;
+	_entries.add(entry);
+	collectEntry(entry->_next);
+	collectEntry(entry->_previous);
+	collectEntry(entry->_mixingFrom);
+	collectEntry(entry->_mixingTo);
+}
+
+int SkeletonSnapshot::entryIndex(TrackEntry *entry) {
+	return entry ? _entries.indexOf(entry) : -1;
+}
+
+void SkeletonSnapshot::write(char *data, Skeleton &skeleton, AnimationState *state, size_t &size) {
+	SnapshotWriter output(data);
+	output.write(MAGIC);
+	output.write(Version);
+	output.write(size);
+	output.write(skeleton._data);
+	output.write((int) skeleton._bones.size());
+	output.write((int) skeleton._slots.size());
+	output.write((int) skeleton._ikConstraints.size());
+	output.write((int) skeleton._transformConstraints.size());
+	output.write((int) skeleton._pathConstraints.size());
+	output.write((int) (state ? _entries.size() : -1));
+
+	output.write(skeleton._skin);
+	output.write(skeleton._lodLevel);
+	output.write(skeleton._color);
+	output.write(skeleton._x);
+	output.write(skeleton._y);
+	output.write(skeleton._scaleX);
+	output.write(skeleton._scaleY);
+	for (size_t i = 0, n = skeleton._drawOrder.size(); i < n; i++)
+		output.write(skeleton._drawOrder[i]->getData().getIndex());
+
+	for (size_t i = 0, n = skeleton._bones.size(); i < n; i++) {
+		Bone &bone = *skeleton._bones[i];
+		output.write(bone._x);
+		output.write(bone._y);
+		output.write(bone._rotation);
+		output.write(bone._scaleX);
+		output.write(bone._scaleY);
+		output.write(bone._shearX);
+		output.write(bone._shearY);
+		output.write(bone._ax);
+		output.write(bone._ay);
+		output.write(bone._arotation);
+		output.write(bone._ascaleX);
+		output.write(bone._ascaleY);
+		output.write(bone._ashearX);
+		output.write(bone._ashearY);
+		output.write(bone._a);
+		output.write(bone._b);
+		output.write(bone._c);
+		output.write(bone._d);
+		output.write(bone._worldX);
+		output.write(bone._worldY);
+	}
+
+	for (size_t i = 0, n = skeleton._slots.size(); i < n; i++) {
+		Slot &slot = *skeleton._slots[i];
+		output.write(slot._color);
+		output.write(slot._darkColor);
+		output.write(slot._hasDarkColor);
+		output.write(slot._attachment);
+		output.write(slot._attachmentState);
+		output.write(slot._sequenceIndex);
+		output.write(slot._deformStart);
+		output.write(slot._deformEnd);
+		output.write(slot._deform);
+	}
+
+	for (size_t i = 0, n = skeleton._ikConstraints.size(); i < n; i++) {
+		IkConstraint &constraint = *skeleton._ikConstraints[i];
+		output.write(constraint._bendDirection);
+		output.write(constraint._compress);
+		output.write(constraint._stretch);
+		output.write(constraint._mix);
+		output.write(constraint._softness);
+	}
+
+	for (size_t i = 0, n = skeleton._transformConstraints.size(); i < n; i++) {
+		TransformConstraint &constraint = *skeleton._transformConstraints[i];
+		output.write(constraint._mixRotate);
+		output.write(constraint._mixX);
+		output.write(constraint._mixY);
+		output.write(constraint._mixScaleX);
+		output.write(constraint._mixScaleY);
+		output.write(constraint._mixShearY);
+	}
+
+	for (size_t i = 0, n = skeleton._pathConstraints.size(); i < n; i++) {
+		PathConstraint &constraint = *skeleton._pathConstraints[i];
+		output.write(constraint._position);
+		output.write(constraint._spacing);
+		output.write(constraint._mixRotate);
+		output.write(constraint._mixX);
+		output.write(constraint._mixY);
+	}
+
+	if (state) {
+		output.write(state->_timeScale);
+		output.write(state->_unkeyedState);
+		output.write(state->_animationsChanged);
+		output.write(state->_culled);
+		output.write(state->_applyInterval);
+		output.write(state->_applyCounter);
+		output.write(state->_nextTrackEntryId);
+		output.write((int) state->_tracks.size());
+		for (size_t i = 0, n = state->_tracks.size(); i < n; i++)
+			output.write(entryIndex(state->_tracks[i]));
+
+		for (size_t i = 0, n = _entries.size(); i < n; i++) {
+			TrackEntry &entry = *_entries[i];
+			output.write(entry._animation);
+			output.write(entryIndex(entry._previous));
+			output.write(entryIndex(entry._next));
+			output.write(entryIndex(entry._mixingFrom));
+			output.write(entryIndex(entry._mixingTo));
+			output.write(entry._trackIndex);
+			output.write(entry._id);
+			output.write(entry._loop);
+			output.write(entry._holdPrevious);
+			output.write(entry._reverse);
+			output.write(entry._shortestRotation);
+			output.write(entry._eventThreshold);
+			output.write(entry._attachmentThreshold);
+			output.write(entry._drawOrderThreshold);
+			output.write(entry._animationStart);
+			output.write(entry._animationEnd);
+			output.write(entry._animationLast);
+			output.write(entry._nextAnimationLast);
+			output.write(entry._delay);
+			output.write(entry._trackTime);
+			output.write(entry._trackLast);
+			output.write(entry._nextTrackLast);
+			output.write(entry._trackEnd);
+			output.write(entry._timeScale);
+			output.write(entry._alpha);
+			output.write(entry._mixTime);
+			output.write(entry._mixDuration);
+			output.write(entry._interruptAlpha);
+			output.write(entry._totalAlpha);
+			output.write(entry._mixBlend);
+			output.write(entry._listener);
+			output.write(entry._listenerObject);
+			output.write(entry._timelineMode);
+			output.write(entry._timelinesRotation);
+			output.write((int) entry._timelineHoldMix.size());
+			for (size_t ii = 0, nn = entry._timelineHoldMix.size(); ii < nn; ii++)
+				output.write(entryIndex(entry._timelineHoldMix[ii]));
+		}
+	}
+	size = output._position;
+}
+
+bool SkeletonSnapshot::restore(Skeleton &skeleton, AnimationState *state) {
+	if (_buffer.size() == 0) return false;
+	SnapshotReader input(_buffer.buffer());
+	if (input.read<int>() != MAGIC || input.read<int>() != Version) return false;
+	if (input.read<size_t>() != _buffer.size()) return false;
+	if (input.read<SkeletonData *>() != skeleton._data) return false;
+	if (input.read<int>() != (int) skeleton._bones.size()) return false;
+	if (input.read<int>() != (int) skeleton._slots.size()) return false;
+	if (input.read<int>() != (int) skeleton._ikConstraints.size()) return false;
+	if (input.read<int>() != (int) skeleton._transformConstraints.size()) return false;
+	if (input.read<int>() != (int) skeleton._pathConstraints.size()) return false;
+	int entryCount = input.read<int>();
+	if ((entryCount >= 0) != (state != NULL)) return false;
+
+	Skin *skin = input.read<Skin *>();
+	size_t lodLevel = input.read<size_t>();
+	if (skin != skeleton._skin || lodLevel != skeleton._lodLevel) {
+		skeleton._skin = skin;
+		skeleton._lodLevel = lodLevel;
+		skeleton.updateCache();
+	}
+	input.read(skeleton._color);
+	skeleton._x = input.read<float>();
+	skeleton._y = input.read<float>();
+	skeleton._scaleX = input.read<float>();
+	skeleton._scaleY = input.read<float>();
+	for (size_t i = 0, n = skeleton._drawOrder.size(); i < n; i++)
+		skeleton._drawOrder[i] = skeleton._slots[input.read<int>()];
+	skeleton._updateAll = true;
+
+	for (size_t i = 0, n = skeleton._bones.size(); i < n; i++) {
+		Bone &bone = *skeleton._bones[i];
+		bone._x = input.read<float>();
+		bone._y = input.read<float>();
+		bone._rotation = input.read<float>();
+		bone._scaleX = input.read<float>();
+		bone._scaleY = input.read<float>();
+		bone._shearX = input.read<float>();
+		bone._shearY = input.read<float>();
+		bone._ax = input.read<float>();
+		bone._ay = input.read<float>();
+		bone._arotation = input.read<float>();
+		bone._ascaleX = input.read<float>();
+		bone._ascaleY = input.read<float>();
+		bone._ashearX = input.read<float>();
+		bone._ashearY = input.read<float>();
+		bone._a = input.read<float>();
+		bone._b = input.read<float>();
+		bone._c = input.read<float>();
+		bone._d = input.read<float>();
+		bone._worldX = input.read<float>();
+		bone._worldY = input.read<float>();
+	}
+
+	for (size_t i = 0, n = skeleton._slots.size(); i < n; i++) {
+		Slot &slot = *skeleton._slots[i];
+		input.read(slot._color);
+		input.read(slot._darkColor);
+		slot._hasDarkColor = input.read<bool>();
+		slot._attachment = input.read<Attachment *>();
+		slot._attachmentState = input.read<int>();
+		slot._sequenceIndex = input.read<int>();
+		slot._deformStart = input.read<int>();
+		slot._deformEnd = input.read<int>();
+		input.read(slot._deform);
+	}
+
+	for (size_t i = 0, n = skeleton._ikConstraints.size(); i < n; i++) {
+		IkConstraint &constraint = *skeleton._ikConstraints[i];
+		constraint._bendDirection = input.read<int>();
+		constraint._compress = input.read<bool>();
+		constraint._stretch = input.read<bool>();
+		constraint._mix = input.read<float>();
+		constraint._softness = input.read<float>();
+	}
+
+	for (size_t i = 0, n = skeleton._transformConstraints.size(); i < n; i++) {
+		TransformConstraint &constraint = *skeleton._transformConstraints[i];
+		constraint._mixRotate = input.read<float>();
+		constraint._mixX = input.read<float>();
+		constraint._mixY = input.read<float>();
+		constraint._mixScaleX = input.read<float>();
+		constraint._mixScaleY = input.read<float>();
+		constraint._mixShearY = input.read<float>();
+	}
+
+	for (size_t i = 0, n = skeleton._pathConstraints.size(); i < n; i++) {
+		PathConstraint &constraint = *skeleton._pathConstraints[i];
+		constraint._position = input.read<float>();
+		constraint._spacing = input.read<float>();
+		constraint._mixRotate = input.read<float>();
+		constraint._mixX = input.read<float>();
+		constraint._mixY = input.read<float>();
+	}
+
+	if (state) {
+		// Return the current entries to the pool and obtain the stored ones.
+		_entries.clear();
+		for (size_t i = 0; i < state->_tracks.size(); i++)
+			collectEntry(state->_tracks[i]);
+		for (size_t i = 0; i < _entries.size(); i++)
+			state->disposeTrackEntry(_entries[i]);
+		_entries.clear();
+		for (int i = 0; i < entryCount; i++)
+			_entries.add(state->_trackEntryPool.obtain());
+
+		state->_timeScale = input.read<float>();
+		state->_unkeyedState = input.read<int>();
+		state->_animationsChanged = input.read<bool>();
+		state->_culled = input.read<bool>();
+		state->_applyInterval = input.read<int>();
+		state->_applyCounter = input.read<int>();
+		state->_nextTrackEntryId = input.read<int>();
+		int trackCount = input.read<int>();
+		state->_tracks.clear();
+		for (int i = 0; i < trackCount; i++) {
+			int index = input.read<int>();
+			state->_tracks.add(index >= 0 ? _entries[index] : NULL);
+		}
+
+		for (int i = 0; i < entryCount; i++) {
+			TrackEntry &entry = *_entries[i];
+			entry._animation = input.read<Animation *>();
+			int index = input.read<int>();
+			entry._previous = index >= 0 ? _entries[index] : NULL;
+			index = input.read<int>();
+			entry._next = index >= 0 ? _entries[index] : NULL;
+			index = input.read<int>();
+			entry._mixingFrom = index >= 0 ? _entries[index] : NULL;
+			index = input.read<int>();
+			entry._mixingTo = index >= 0 ? _entries[index] : NULL;
+			entry._trackIndex = input.read<int>();
+			entry._id = input.read<int>();
+			entry._boneMask = NULL;
+			entry._loop = input.read<bool>();
+			entry._holdPrevious = input.read<bool>();
+			entry._reverse = input.read<bool>();
+			entry._shortestRotation = input.read<bool>();
+			entry._eventThreshold = input.read<float>();
+			entry._attachmentThreshold = input.read<float>();
+			entry._drawOrderThreshold = input.read<float>();
+			entry._animationStart = input.read<float>();
+			entry._animationEnd = input.read<float>();
+			entry._animationLast = input.read<float>();
+			entry._nextAnimationLast = input.read<float>();
+			entry._delay = input.read<float>();
+			entry._trackTime = input.read<float>();
+			entry._trackLast = input.read<float>();
+			entry._nextTrackLast = input.read<float>();
+			entry._trackEnd = input.read<float>();
+			entry._timeScale = input.read<float>();
+			entry._alpha = input.read<float>();
+			entry._mixTime = input.read<float>();
+			entry._mixDuration = input.read<float>();
+			entry._interruptAlpha = input.read<float>();
+			entry._totalAlpha = input.read<float>();
+			entry._mixBlend = input.read<MixBlend>();
+			entry._listener = input.read<AnimationStateListener>();
+			entry._listenerObject = input.read<AnimationStateListenerObject *>();
+			input.read(entry._timelineMode);
+			input.read(entry._timelinesRotation);
+			int holdMixCount = input.read<int>();
+			entry._timelineHoldMix.clear();
+			for (int ii = 0; ii < holdMixCount; ii++) {
+				index = input.read<int>();
+				entry._timelineHoldMix.add(index >= 0 ? _entries[index] : NULL);
+			}
+		}
+	}
+	return true;
+}
+
+const char *SkeletonSnapshot::getData() {
+	return _buffer.buffer();
+}
+
+size_t SkeletonSnapshot::getSize() {
+	return _buffer.size();
+}
+
+void SkeletonSnapshot::setData(const char *data, size_t size) {
+	_buffer.setSize(size, 0);
+	if (size > 0) memcpy(_buffer.buffer(), data, size);
+}
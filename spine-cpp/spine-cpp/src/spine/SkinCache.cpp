@@ -0,0 +1,129 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated September 24, 2021. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2021, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software
+ * or otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+ * THE SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <spine/SkinCache.h>
+
+#include <spine/ContainerUtil.h>
+#include <spine/MathUtil.h>
+#include <spine/Skeleton.h>
+#include <spine/Skin.h>
+
+using namespace spine;
+
+SkinCache::Entry::Entry(size_t hash, Vector<Skin *> &skins) : _hash(hash), _skin(NULL), _lodLevel(-1), _next(NULL) {
+	_skins.addAll(skins);
+
+	String name;
+	for (size_t i = 0; i < skins.size(); i++) {
+		if (i > 0) name.append("+");
+		name.append(skins[i]->getName());
+	}
+	_skin = new (__FILE__, __LINE__) Skin(name);
+	for (size_t i = 0; i < skins.size(); i++)
+		_skin->addSkin(skins[i]);
+}
+
+SkinCache::Entry::~Entry() {
+	delete _skin;
+}
+
+SkinCache::SkinCache() : _mask(0) {
+}
+
+SkinCache::~SkinCache() {
+	clear();
+}
+
+Skin *SkinCache::getSkin(Vector<Skin *> &skins) {
+	return getEntry(skins)._skin;
+}
+
+void SkinCache::setSkin(Skeleton &skeleton, Vector<Skin *> &skins) {
+	Entry &entry = getEntry(skins);
+	if (skeleton._skin == entry._skin) return;
+
+	skeleton.attachSkin(entry._skin);
+	if (skeleton._boneMask) {
+		// The stored update cache is for the full skeleton.
+		skeleton.updateCache();
+	} else if (entry._lodLevel == (int) skeleton._lodLevel) {
+		skeleton.setUpdateCache(entry._updateCache);
+	} else {
+		skeleton.updateCache();
+		skeleton.getUpdateCache(entry._updateCache);
+		entry._lodLevel = (int) skeleton._lodLevel;
+	}
+}
+
+size_t SkinCache::size() {
+	return _entries.size();
+}
+
+void SkinCache::clear() {
+	ContainerUtil::cleanUpVectorOfPointers(_entries);
+	_buckets.clear();
+	_mask = 0;
+}
+
+SkinCache::Entry &SkinCache::getEntry(Vector<Skin *> &skins) {
+	// The order of the skins matters, later skins replace attachments of earlier ones.
+	size_t hash = 2166136261u;
+	for (size_t i = 0; i < skins.size(); i++)
+		hash = (hash ^ (size_t) skins[i]) * 16777619u;
+	hash ^= hash >> 16;
+
+	if (_buckets.size() > 0) {
+		for (Entry *entry = _buckets[hash & _mask]; entry; entry = entry->_next)
+			if (entry->_hash == hash && entry->_skins == skins) return *entry;
+	}
+
+	Entry *entry = new (__FILE__, __LINE__) Entry(hash, skins);
+	_entries.add(entry);
+	if (_entries.size() > (_buckets.size() >> 1))
+		resize(MathUtil::max((size_t) 16, _buckets.size() << 1));
+	else {
+		Entry *&bucket = _buckets[hash & _mask];
+		entry->_next = bucket;
+		bucket = entry;
+	}
+	return *entry;
+}
+
+void SkinCache::resize(size_t bucketCount) {
+	_buckets.setSize(bucketCount, NULL);
+	for (size_t i = 0; i < bucketCount; i++)
+		_buckets[i] = NULL;
+	_mask = bucketCount - 1;
+	for (size_t i = 0, n = _entries.size(); i < n; i++) {
+		Entry *entry = _entries[i];
+		Entry *&bucket = _buckets[entry->_hash & _mask];
+		entry->_next = bucket;
+		bucket = entry;
+	}
+}
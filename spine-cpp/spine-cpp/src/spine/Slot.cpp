@@ -35,6 +35,8 @@
 #include <spine/SlotData.h>
 #include <spine/VertexAttachment.h>
 
+#include <limits.h>
+
 using namespace spine;
 
 Slot::Slot(SlotData &data, Bone &bone) : _data(data),
@@ -45,7 +47,9 @@ Slot::Slot(SlotData &data, Bone &bone) : _data(data),
 										 _hasDarkColor(data.hasDarkColor()),
 										 _attachment(NULL),
 										 _attachmentState(0),
-										 _sequenceIndex(0) {
+										 _sequenceIndex(0),
+										 _deformStart(0),
+										 _deformEnd(INT_MAX) {
 	setToSetupPose();
 }
 
@@ -102,6 +106,8 @@ void Slot::setAttachment(Attachment *inValue) {
 		static_cast<VertexAttachment *>(inValue)->getTimelineAttachment() !=
 				static_cast<VertexAttachment *>(_attachment)->getTimelineAttachment()) {
 		_deform.clear();
+		_deformStart = 0;
+		_deformEnd = INT_MAX;
 	}
 
 	_attachment = inValue;
@@ -120,6 +126,25 @@ Vector<float> &Slot::getDeform() {
 	return _deform;
 }
 
+Vector<float> &Slot::getDeformForWrite() {
+	_deformStart = 0;
+	_deformEnd = INT_MAX;
+	return _deform;
+}
+
+int Slot::getDeformStart() {
+	return _deformStart;
+}
+
+int Slot::getDeformEnd() {
+	return _deformEnd;
+}
+
+void Slot::setDeformRange(int start, int end) {
+	_deformStart = start;
+	_deformEnd = end;
+}
+
 int Slot::getSequenceIndex() {
 	return _sequenceIndex;
 }
@@ -35,4 +35,9 @@ namespace spine {
 
 	TextureLoader::~TextureLoader() {
 	}
+
+	const unsigned char *TextureLoader::getPixels(AtlasPage &page) {
+		SP_UNUSED(page);
+		return NULL;
+	}
 }// namespace spine
@@ -43,6 +43,13 @@ namespace spine {
 	Timeline::~Timeline() {
 	}
 
+	void Timeline::applyBatch(Skeleton **skeletons, float *lastTimes, float *times, size_t count,
+							  Vector<Event *> **pEvents, float alpha, MixBlend blend, MixDirection direction) {
+		assert(count <= BatchSize);
+		for (size_t i = 0; i < count; i++)
+			apply(*skeletons[i], lastTimes[i], times[i], pEvents ? pEvents[i] : NULL, alpha, blend, direction);
+	}
+
 	Vector<PropertyId> &Timeline::getPropertyIds() {
 		return _propertyIds;
 	}
@@ -71,4 +78,8 @@ namespace spine {
 		return _frames[_frames.size() - getFrameEntries()];
 	}
 
+	size_t Timeline::getMemoryUsage() {
+		return _frames.getCapacity() * sizeof(float) + _propertyIds.getCapacity() * sizeof(PropertyId);
+	}
+
 }// namespace spine
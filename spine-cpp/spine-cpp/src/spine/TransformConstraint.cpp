@@ -31,6 +31,7 @@
 
 #include <spine/Bone.h>
 #include <spine/Skeleton.h>
+#include <spine/SpineProfiler.h>
 #include <spine/TransformConstraintData.h>
 
 #include <spine/BoneData.h>
@@ -62,6 +63,7 @@ TransformConstraint::TransformConstraint(TransformConstraintData &data, Skeleton
 }
 
 void TransformConstraint::update() {
+	SP_PROFILE_ZONE("TransformConstraint::update");
 	if (_mixRotate == 0 && _mixX == 0 && _mixY == 0 && _mixScaleX == 0 && _mixScaleY == 0 && _mixShearY == 0) return;
 
 	if (_data.isLocal()) {
@@ -117,6 +117,49 @@ void TranslateTimeline::apply(Skeleton &skeleton, float lastTime, float time, Ve
 	}
 }
 
+void TranslateTimeline::applyBatch(Skeleton **skeletons, float *lastTimes, float *times, size_t count,
+								   Vector<Event *> **pEvents, float alpha, MixBlend blend, MixDirection direction) {
+	SP_UNUSED(pEvents);
+	assert(count <= BatchSize);
+
+	// Gather the bones which are keyed at their time, evaluate their curves, then blend.
+	Bone *bones[BatchSize];
+	float xs[BatchSize], ys[BatchSize];
+	size_t n = 0;
+	for (size_t i = 0; i < count; i++) {
+		Bone *bone = skeletons[i]->_bones[_boneIndex];
+		if (!bone->_active) continue;
+		if (times[i] < _frames[0])
+			apply(*skeletons[i], lastTimes[i], times[i], NULL, alpha, blend, direction);
+		else {
+			bones[n] = bone;
+			xs[n++] = times[i];
+		}
+	}
+	getCurveValues(xs, xs, ys, n);
+
+	switch (blend) {
+		case MixBlend_Setup:
+			for (size_t i = 0; i < n; i++) {
+				bones[i]->_x = bones[i]->_data._x + xs[i] * alpha;
+				bones[i]->_y = bones[i]->_data._y + ys[i] * alpha;
+			}
+			break;
+		case MixBlend_First:
+		case MixBlend_Replace:
+			for (size_t i = 0; i < n; i++) {
+				bones[i]->_x += (bones[i]->_data._x + xs[i] - bones[i]->_x) * alpha;
+				bones[i]->_y += (bones[i]->_data._y + ys[i] - bones[i]->_y) * alpha;
+			}
+			break;
+		case MixBlend_Add:
+			for (size_t i = 0; i < n; i++) {
+				bones[i]->_x += xs[i] * alpha;
+				bones[i]->_y += ys[i] * alpha;
+			}
+	}
+}
+
 RTTI_IMPL(TranslateXTimeline, CurveTimeline1)
 
 TranslateXTimeline::TranslateXTimeline(size_t frameCount, size_t bezierCount, int boneIndex) : CurveTimeline1(
@@ -32,17 +32,24 @@
 #include <spine/Slot.h>
 
 #include <spine/Bone.h>
+#include <spine/CompactVertices.h>
+#include <spine/MathUtil.h>
 #include <spine/Skeleton.h>
+#include <spine/SpineProfiler.h>
+
+#include <atomic>
 
 using namespace spine;
 
 RTTI_IMPL(VertexAttachment, Attachment)
 
 VertexAttachment::VertexAttachment(const String &name) : Attachment(name), _worldVerticesLength(0),
-														 _timelineAttachment(this), _id(getNextID()) {
+														 _timelineAttachment(this), _compactVertices(NULL),
+														 _id(getNextID()) {
 }
 
 VertexAttachment::~VertexAttachment() {
+	if (_compactVertices) delete _compactVertices;
 }
 
 void VertexAttachment::computeWorldVertices(Slot &slot, Vector<float> &worldVertices) {
@@ -58,13 +65,70 @@ void VertexAttachment::computeWorldVertices(Slot &slot, size_t start, size_t cou
 	computeWorldVertices(slot, start, count, worldVertices.buffer(), offset, stride);
 }
 
+template<typename T>
+void VertexAttachment::computeCompactWorldVertices(Slot &slot, Vector<T> &bones, size_t start, size_t count,
+												   float *worldVertices, size_t offset, size_t stride) {
+	// Same as the float vertices below, with the quantized values decoded inline.
+	const short *positions = _compactVertices->_positions.buffer();
+	const unsigned short *weights = _compactVertices->_weights.buffer();
+	float scale = _compactVertices->_scale, weightScale = 1.0f / 65535;
+	int v = 0, skip = 0;
+	for (size_t i = 0; i < start; i += 2) {
+		int n = (int) bones[v];
+		v += n + 1;
+		skip += n;
+	}
+
+	Vector<Bone *> &skeletonBones = slot._bone._skeleton.getBones();
+	Vector<float> &deformArray = slot._deform;
+	size_t deformStart = 0, deformEnd = 0;
+	if (deformArray.size() > 0) {
+		deformStart = (size_t) slot._deformStart;
+		deformEnd = MathUtil::min((size_t) slot._deformEnd, deformArray.size());
+	}
+	for (size_t w = offset, b = skip, f = skip << 1; w < count; w += stride) {
+		float wx = 0, wy = 0;
+		int n = (int) bones[v++];
+		n += v;
+		if (f >= deformEnd || f + ((n - v) << 1) <= deformStart) {
+			for (; v < n; v++, b++, f += 2) {
+				Bone &bone = *skeletonBones[bones[v]];
+				float vx = positions[b << 1] * scale;
+				float vy = positions[(b << 1) + 1] * scale;
+				float weight = weights[b] * weightScale;
+				wx += (vx * bone._a + vy * bone._b + bone._worldX) * weight;
+				wy += (vx * bone._c + vy * bone._d + bone._worldY) * weight;
+			}
+		} else {
+			for (; v < n; v++, b++, f += 2) {
+				Bone &bone = *skeletonBones[bones[v]];
+				float vx = positions[b << 1] * scale + deformArray[f];
+				float vy = positions[(b << 1) + 1] * scale + deformArray[f + 1];
+				float weight = weights[b] * weightScale;
+				wx += (vx * bone._a + vy * bone._b + bone._worldX) * weight;
+				wy += (vx * bone._c + vy * bone._d + bone._worldY) * weight;
+			}
+		}
+		worldVertices[w] = wx;
+		worldVertices[w + 1] = wy;
+	}
+}
+
 void VertexAttachment::computeWorldVertices(Slot &slot, size_t start, size_t count, float *worldVertices, size_t offset,
 											size_t stride) {
+	SP_PROFILE_ZONE("VertexAttachment::computeWorldVertices");
 	count = offset + (count >> 1) * stride;
 	Skeleton &skeleton = slot._bone._skeleton;
-	Vector<float> *deformArray = &slot.getDeform();
+	Vector<float> *deformArray = &slot._deform;
 	Vector<float> *vertices = &_vertices;
 	Vector<int> &bones = _bones;
+	if (_compactVertices) {
+		if (_compactVertices->_bones8.size() > 0)
+			computeCompactWorldVertices(slot, _compactVertices->_bones8, start, count, worldVertices, offset, stride);
+		else
+			computeCompactWorldVertices(slot, _compactVertices->_bones16, start, count, worldVertices, offset, stride);
+		return;
+	}
 	if (bones.size() == 0) {
 		if (deformArray->size() > 0) vertices = deformArray;
 
@@ -107,10 +171,26 @@ void VertexAttachment::computeWorldVertices(Slot &slot, size_t start, size_t cou
 			worldVertices[w + 1] = wy;
 		}
 	} else {
+		// Deform offsets outside the slot's deform range are zero.
+		size_t deformStart = (size_t) slot._deformStart, deformEnd = MathUtil::min((size_t) slot._deformEnd, deformArray->size());
 		for (size_t w = offset, b = skip * 3, f = skip << 1; w < count; w += stride) {
 			float wx = 0, wy = 0;
 			int n = (int) bones[v++];
 			n += v;
+			if (f >= deformEnd || f + ((n - v) << 1) <= deformStart) {
+				for (; v < n; v++, b += 3, f += 2) {
+					Bone *boneP = skeletonBones[bones[v]];
+					Bone &bone = *boneP;
+					float vx = (*vertices)[b];
+					float vy = (*vertices)[b + 1];
+					float weight = (*vertices)[b + 2];
+					wx += (vx * bone._a + vy * bone._b + bone._worldX) * weight;
+					wy += (vx * bone._c + vy * bone._d + bone._worldY) * weight;
+				}
+				worldVertices[w] = wx;
+				worldVertices[w + 1] = wy;
+				continue;
+			}
 			for (; v < n; v++, b += 3, f += 2) {
 				Bone *boneP = skeletonBones[bones[v]];
 				Bone &bone = *boneP;
@@ -155,13 +235,32 @@ void VertexAttachment::setTimelineAttachment(Attachment *attachment) {
 }
 
 int VertexAttachment::getNextID() {
-	static int nextID = 0;
+	static std::atomic<int> nextID(0);
 	return nextID++;
 }
 
+bool VertexAttachment::isWeighted() {
+	return _bones.size() > 0 || _compactVertices;
+}
+
+void VertexAttachment::compact() {
+	if (_compactVertices || _bones.size() == 0) return;
+	_compactVertices = new (__FILE__, __LINE__) CompactVertices(_bones, _vertices);
+	_bones.clear();
+	_bones.shrinkToFit();
+	_vertices.clear();
+	_vertices.shrinkToFit();
+}
+
+CompactVertices *VertexAttachment::getCompactVertices() {
+	return _compactVertices;
+}
+
 void VertexAttachment::copyTo(VertexAttachment *other) {
 	other->_bones.clearAndAddAll(this->_bones);
 	other->_vertices.clearAndAddAll(this->_vertices);
+	if (other->_compactVertices) delete other->_compactVertices;
+	other->_compactVertices = _compactVertices ? new (__FILE__, __LINE__) CompactVertices(*_compactVertices) : NULL;
 	other->_worldVerticesLength = this->_worldVerticesLength;
 	other->_timelineAttachment = this->_timelineAttachment;
 }
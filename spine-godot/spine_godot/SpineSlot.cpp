@@ -139,7 +139,7 @@ Array SpineSlot::get_deform() {
 
 void SpineSlot::set_deform(Array v) {
 	SPINE_CHECK(get_spine_object(), )
-	auto &deform = get_spine_object()->getDeform();
+	auto &deform = get_spine_object()->getDeformForWrite();
 	deform.setSize(v.size(), 0);
 	for (int i = 0; i < v.size(); ++i) {
 		deform[i] = v[i];
@@ -34,6 +34,33 @@
 #include <SDL.h>
 
 namespace spine {
+	/// Writes SDL_Vertex directly from the world vertices and clipper output, see VertexWriter.
+	struct SDLVertexLayout {
+		typedef SDL_Vertex Vertex;
+		typedef SDL_Color PackedColor;
+		static const size_t PositionOffset = 0;
+		static const bool DarkColor = false;
+
+		static PackedColor packColor(const Color &color) {
+			SDL_Color packed;
+			packed.r = static_cast<Uint8>(color.r * 255);
+			packed.g = static_cast<Uint8>(color.g * 255);
+			packed.b = static_cast<Uint8>(color.b * 255);
+			packed.a = static_cast<Uint8>(color.a * 255);
+			return packed;
+		}
+
+		static void setColor(Vertex &vertex, const PackedColor &light, const PackedColor &dark) {
+			SP_UNUSED(dark);
+			vertex.color = light;
+		}
+
+		static void setUV(Vertex &vertex, float u, float v) {
+			vertex.tex_coord.x = u;
+			vertex.tex_coord.y = v;
+		}
+	};
+
 	class SkeletonDrawable {
 	public:
 		SkeletonDrawable(SkeletonData *skeletonData, AnimationStateData *animationStateData = nullptr);
@@ -50,8 +77,7 @@ namespace spine {
 	private:
 		bool ownsAnimationStateData;
 		SkeletonClipping clipper;
-		Vector<float> worldVertices;
-		Vector<SDL_Vertex> sdlVertices;
+		VertexWriter<SDLVertexLayout> vertexWriter;
 		Vector<int> sdlIndices;
 	};
 